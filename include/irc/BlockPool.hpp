@@ -0,0 +1,57 @@
+#ifndef BLOCKPOOL_HPP
+#define BLOCKPOOL_HPP
+
+#include <vector>
+#include <cstddef>
+
+// BlockPool - fixed-size raw memory blocks carved out of mmap()ed slabs
+// The storage counterpart of SlabPool: SlabPool holds the objects,
+// BlockPool the large buffers they point to (MessageBuffer storage), so
+// an object created and dropped over and over never reaches malloc for
+// its data either.
+//
+//   BlockPool blocks(8192);
+//   char* block = blocks.acquire();    // blockSize() bytes
+//   blocks.release(block);             // next acquire() hands it out again
+//
+// Slabs are kept until the pool goes away, their memory is not: up to
+// warmBlocks released blocks stay resident and are reused most recent
+// first (still in cache); a block released beyond that has its pages
+// handed back to the kernel (madvise), so a burst of buffers does not
+// stay in RSS once they are idle. Reusing such a block costs page faults.
+// Not thread-safe (the owner uses it under its own lock).
+class BlockPool {
+public:
+    BlockPool(size_t blockSize, size_t blocksPerSlab = 64, size_t warmBlocks = 64);
+    ~BlockPool();
+
+    // Throws std::bad_alloc when no slab can be mapped
+    char* acquire();
+    void release(char* block);
+
+    size_t blockSize() const;
+    size_t live() const;        // blocks handed out
+    size_t peak() const;        // high-water mark of live()
+    size_t capacity() const;    // blocks in all slabs
+    size_t warm() const;        // free blocks still resident
+
+private:
+    size_t blockSize_;
+    size_t blocksPerSlab_;
+    size_t warmBlocks_;
+    size_t pageSize_;
+    std::vector<char*> slabs_;
+    std::vector<char*> warm_;   // free, resident, LIFO
+    std::vector<char*> cold_;   // free, pages given back (or never touched)
+    size_t live_;
+    size_t peak_;
+
+    void grow();
+    void discard(char* block);
+
+    // Not copyable
+    BlockPool(const BlockPool&);
+    BlockPool& operator=(const BlockPool&);
+};
+
+#endif // BLOCKPOOL_HPP
@@ -15,9 +15,10 @@
 
 #include <string>
 #include <vector>
-#include <map>
-#include <set>
 #include <ctime>
+#include "irc/SendQueue.hpp"
+#include "irc/Identifier.hpp"
+#include "irc/Membership.hpp"
 
 // Forward declarations
 class Client;
@@ -35,24 +36,35 @@ public:
     ~Channel();
     
     // Identity getters (case handling for Halloy)
-    const std::string& getName() const;         // lowercase for comparison
+    const std::string& getName() const;         // casefolded for comparison
     const std::string& getNameDisplay() const;  // original case for display
+    const Identifier& getId() const;            // interned casefolded name
     
-    // Membership management
+    // Membership management (one Membership node per member, see
+    // Membership.hpp): lookups O(1) through the index, add/remove O(1)
+    // addClient/removeClient update the client's channel list too
     bool hasClient(Client* client) const;
-    void addClient(Client* client);
+    Membership* addClient(Client* client);
     void removeClient(Client* client);
+    void removeMembership(Membership* membership);
+    Membership* getMembership(const Client* client) const;
+    Membership* getMembers() const;             // first in join order, then nextInChannel
+    const std::vector<int>& getFanout() const;  // member fds, packed, any order
     std::vector<Client*> getClients() const;
     size_t getClientCount() const;
     bool isEmpty() const;
     
-    // Operator management
+    // Operator management (FLAG_OPERATOR of the client's Membership)
     bool isOperator(Client* client) const;
     void addOperator(Client* client);
     void removeOperator(Client* client);
     std::vector<Client*> getOperators() const;
     
     // Invite list management (case-insensitive)
+    // Stored as interned nicks: checks compare handles, never allocate
+    bool isInvited(const Identifier& nickname) const;
+    void addToInviteList(const Identifier& nickname);
+    void removeFromInviteList(const Identifier& nickname);
     bool isInvited(const std::string& nickname) const;
     void addToInviteList(const std::string& nickname);
     void removeFromInviteList(const std::string& nickname);
@@ -75,11 +87,16 @@ public:
     
     // Broadcasting: send message to all members except exclude
     // Signature from TEAM_CONVENTIONS.md section 12
-    void broadcast(Server* server, const std::string& message, Client* exclude);
+    // PRIORITY_LOW (chat fan-out) may be dropped for slow members, see SendQueue
+    // The message is encoded once and shared by every member's SendQueue
+    void broadcast(Server* server, const std::string& message, Client* exclude,
+                   SendQueue::Priority priority = SendQueue::PRIORITY_NORMAL);
+    void broadcast(Server* server, const SharedMessage& message, Client* exclude,
+                   SendQueue::Priority priority = SendQueue::PRIORITY_NORMAL);
     
 private:
     // Identity (case handling for Halloy)
-    std::string name_;         // "#test" - lowercase for comparison
+    Identifier name_;          // "#test" - casefolded, interned
     std::string nameDisplay_;  // "#Test" - original case for display
     
     // Topic
@@ -88,15 +105,26 @@ private:
     time_t topicTime_;         // when it was set
     
     // Member storage
-    std::map<int, Client*> clients_;    // fd -> Client* for quick lookup
-    std::vector<Client*> operators_;    // List of operators
-    std::set<std::string> inviteList_;  // lowercase nicknames
+    Membership* membersHead_;           // intrusive list, join order
+    Membership* membersTail_;
+    MembershipIndex memberIndex_;       // Client* -> Membership*
+    
+    // Fan-out: member fds packed for broadcast() to read straight through.
+    // Kept in step on join/part: removal moves the last entry into the hole
+    // (fanoutOwners_ says whose fanoutSlot to fix), so order is not join order
+    std::vector<int> fanout_;
+    std::vector<Membership*> fanoutOwners_;
+    std::vector<Identifier> inviteList_;  // interned nicknames (few: linear scan)
     
     // Channel modes
     bool inviteOnly_;      // mode 'i'
     bool topicProtected_;  // mode 't'
     std::string channelKey_;  // mode 'k' (password)
     int userLimit_;        // mode 'l' (0 = no limit)
+    
+    // Not copyable (members point back at this channel)
+    Channel(const Channel&);
+    Channel& operator=(const Channel&);
 };
 
 #endif // CHANNEL_HPP
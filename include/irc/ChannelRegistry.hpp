@@ -0,0 +1,49 @@
+#ifndef CHANNELREGISTRY_HPP
+#define CHANNELREGISTRY_HPP
+
+#include <string>
+#include <cstddef>
+#include "irc/Identifier.hpp"
+#include "irc/IdentifierMap.hpp"
+#include "irc/SlabPool.hpp"
+
+class Channel;
+
+// ChannelRegistry - casefolded channel name -> Channel*, owns the channels
+// - Lookup: IdentifierMap keyed by the interned name (O(1), probes compare
+//   handles, like NickDirectory)
+// - Storage: Channel objects come from a SlabPool, remove() puts the slot
+//   back, so join/part churn reuses the same memory instead of new/delete
+// Owned by Server, used under its state lock.
+class ChannelRegistry {
+public:
+    ChannelRegistry();
+    ~ChannelRegistry();     // destroys the channels still registered
+
+    // Channel with this name, NULL if none
+    Channel* find(const Identifier& name) const;
+    Channel* find(const std::string& name) const;
+
+    // Channel with this name, created (display case as given) if missing
+    Channel* create(const std::string& name);
+
+    // Unregister and destroy (the pointer is dead afterwards)
+    void remove(Channel* channel);
+
+    // remove() every channel: members are unlinked, so call it while the
+    // clients are still alive (Server shutdown)
+    void clear();
+
+    size_t size() const;
+    const SlabPool<Channel, 32>& getPool() const;
+
+private:
+    IdentifierMap<Channel> channels_;
+    SlabPool<Channel, 32> pool_;
+
+    // Not copyable
+    ChannelRegistry(const ChannelRegistry&);
+    ChannelRegistry& operator=(const ChannelRegistry&);
+};
+
+#endif // CHANNELREGISTRY_HPP
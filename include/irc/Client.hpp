@@ -15,6 +15,10 @@
 
 #include <string>
 #include <vector>
+#include "irc/Identifier.hpp"
+#include "irc/TimerWheel.hpp"
+
+struct Membership;
 
 // Client class - represents a connected IRC client
 // Manages client state, registration, and message buffer
@@ -31,16 +35,18 @@ public:
     int getFd() const;
     
     // Identity getters
-    // getNickname() returns LOWERCASE for comparison
+    // getNickname() returns CASEFOLDED (RFC 1459) for comparison
     // getNicknameDisplay() returns ORIGINAL case for display
+    // getNickId() is the interned casefolded nick (compare handles, not strings)
     const std::string& getNickname() const;
+    const Identifier& getNickId() const;
     const std::string& getNicknameDisplay() const;
     const std::string& getUsername() const;
     const std::string& getHostname() const;
     const std::string& getRealname() const;
     
     // Identity setters
-    // setNickname stores both lowercase (comparison) and original (display)
+    // setNickname stores both casefolded (comparison) and original (display)
     void setNickname(const std::string& nickname);
     void setUsername(const std::string& username, const std::string& realname);
     void setHostname(const std::string& hostname);
@@ -65,39 +71,58 @@ public:
     void incrementPasswordAttempts();
     bool hasExceededPasswordAttempts() const;
     
-    // Channel membership
-    void addChannel(const std::string& channelName);
-    void removeChannel(const std::string& channelName);
-    const std::vector<std::string>& getChannels() const;
-    bool isInChannel(const std::string& channelName) const;
+    // Channel membership: the Membership nodes of this client, in join
+    // order (follow nextInClient). Joining and leaving go through
+    // Channel::addClient()/removeClient(), which keep this list in step.
+    Membership* getMemberships() const;
+    size_t getChannelCount() const;
+    
+    // Called by Channel only: O(1) link/unlink on the client's side
+    void linkMembership(Membership* membership);
+    void unlinkMembership(Membership* membership);
     
     // Message buffer management (for receiving data)
     void appendToBuffer(const std::string& data);
     std::string& getBuffer();
     void clearBuffer();
     
+    // Liveness (owner reactor's thread): registration deadline / PING /
+    // PONG wait, see Server::handleTimer(). Input only records the time
+    // (ConnectionTable::Slot::lastActivity).
+    TimerWheel::Timer& getTimer();
+    
     // Client prefix format: "nick!user@host" (uses display nickname)
-    std::string getPrefix() const;
+    // Cached: rebuilt only by setNickname/setUsername/setHostname
+    const std::string& getPrefix() const;
     
 private:
     int fd_;
     
     // Identity (case handling for Halloy)
-    std::string nickname_;         // lowercase for comparison
+    Identifier nickname_;          // casefolded, interned, for comparison
     std::string nicknameDisplay_;  // original case for display
     std::string username_;
     std::string hostname_;
     std::string realname_;
+    std::string prefix_;           // "nick!user@host", see rebuildPrefix()
     
     // Registration state machine (STRICT ORDER)
     int registrationStep_;         // 0=PASS, 1=NICK, 2=USER, 3=done
     int passwordAttempts_;         // Max 3 attempts
     static const int MAX_PASSWORD_ATTEMPTS = 3;
     
-    // Channel membership (stores lowercase channel names)
-    std::vector<std::string> channels_;
+    // Channel membership (intrusive list, see Membership.hpp)
+    Membership* membershipsHead_;
+    Membership* membershipsTail_;
+    size_t channelCount_;
+    
+    // Liveness timer (linked into the owner reactor's TimerWheel)
+    TimerWheel::Timer timer_;
     
     // NOTE: NO MessageBuffer here (Variant 3)
+    
+    // Recompute prefix_ after an identity change
+    void rebuildPrefix();
 };
 
 #endif // CLIENT_HPP
@@ -16,10 +16,42 @@
 
 # include <string>
 # include <vector>
+# include <cstring>
+
+// CommandId - the verbs the server handles, resolved once by the Parser
+// Handlers and CommandRegistry switch on the id, never on the name
+enum CommandId {
+    CMD_UNKNOWN = 0,
+    CMD_PASS,
+    CMD_NICK,
+    CMD_USER,
+    CMD_JOIN,
+    CMD_PART,
+    CMD_PRIVMSG,
+    CMD_INVITE,
+    CMD_KICK,
+    CMD_TOPIC,
+    CMD_MODE,
+    CMD_QUIT,
+    CMD_PING,
+    CMD_PONG,
+    CMD_COUNT
+};
+
+// Uppercase verb -> id (CMD_UNKNOWN if not one of the above)
+// Switch on length + first byte, then one memcmp: no hashing of the
+// whole name, no map, no allocation
+CommandId commandIdFromName(const char* name, size_t length);
+
+// Id -> uppercase verb ("" for CMD_UNKNOWN)
+const char* commandName(CommandId id);
 
 // Command structure - parsed IRC message
 // This is the format used to pass parsed messages between modules
 struct Command {
+    // Verb as an id (set by Parser, CMD_UNKNOWN for anything else)
+    CommandId id;
+
     // Optional origin prefix (e.g., "nick!user@host")
     std::string prefix;
     
@@ -34,6 +66,10 @@ struct Command {
     
     // Original unparsed message (for debugging/logging)
     std::string raw;
+
+    // Parser::toCommand(): params strings parked while a line has fewer
+    // params, with their capacity, for the next line that has more
+    std::vector<std::string> spareParams;
     
     // Helper methods (can be implemented as free functions or in Utils)
     // Can be removed if they won't get to be used
@@ -41,6 +77,43 @@ struct Command {
     // std::string getParam(size_t index) const;
     // size_t paramCount() const { return params.size(); }
     // std::string getFullCommand() const;  // Reconstruct command string
+
+    Command() : id(CMD_UNKNOWN) {}
+};
+
+// StringRef - non-owning piece of a line (pointer + length)
+struct StringRef {
+    const char* data;
+    size_t length;
+
+    StringRef() : data(""), length(0) {}
+    StringRef(const char* d, size_t l) : data(d), length(l) {}
+
+    bool empty() const { return length == 0; }
+    std::string str() const { return std::string(data, length); }
+    bool operator==(const char* s) const {
+        return std::strlen(s) == length && std::memcmp(data, s, length) == 0;
+    }
+};
+
+// CommandView - same fields as Command, as views into the line it was parsed from
+// Filled by Parser::parse(char*, size_t, CommandView&) without any allocation.
+// Only valid while that line is: for Server, until the handler returns
+// (the line lives in the connection's MessageBuffer). Use Parser::toCommand()
+// to get an owning Command that can be kept.
+struct CommandView {
+    // RFC 2812 allows 15, extra params are ignored
+    enum { MAX_PARAMS = 32 };
+
+    StringRef prefix;
+    StringRef command;      // uppercased in place by the parser
+    CommandId id;
+    StringRef params[MAX_PARAMS];
+    size_t paramCount;
+    StringRef trailing;
+    StringRef raw;          // whole line without CRLF
+
+    CommandView() : id(CMD_UNKNOWN), paramCount(0) {}
 };
 
 #endif
@@ -15,7 +15,6 @@
 # define COMMANDREGISTRY_HPP
 
 # include <string>
-# include <map>
 # include "irc/Command.hpp"
 
 // Forward declarations
@@ -26,7 +25,8 @@ class Client;
 typedef void (*CommandHandler)(Server& server, Client& client, const Command& cmd);
 
 // CommandRegistry class - manages command handlers and routes commands
-// Maps command names to their handler functions
+// Handlers are indexed by CommandId (set by the Parser): dispatch is one
+// array load, no string compare. Also counts executed commands per id.
 class CommandRegistry {
 public:
     // Constructor: register all command handlers
@@ -39,14 +39,23 @@ public:
     // Returns true if command was found and executed, false otherwise
     bool execute(Server& server, Client& client, const Command& cmd);
     
-    // Register a command handler
+    // Register a command handler (names outside CommandId are rejected)
+    void registerCommand(CommandId id, CommandHandler handler);
     void registerCommand(const std::string& command, CommandHandler handler);
     
     // Check if a command is registered
+    bool hasCommand(CommandId id) const;
     bool hasCommand(const std::string& command) const;
+
+    // execute() calls per id (CMD_UNKNOWN: verbs without a handler)
+    unsigned long getCount(CommandId id) const;
     
 private:
-    std::map<std::string, CommandHandler> handlers_;
+    CommandHandler handlers_[CMD_COUNT];    // NULL = not registered
+    unsigned long counts_[CMD_COUNT];
+
+    // Name in any case -> id
+    static CommandId lookup(const std::string& command);
     
     // Initialize all command handlers
     void initializeHandlers();
@@ -2,6 +2,8 @@
 #define CONFIG_HPP
 
 #include <string>
+#include <vector>
+#include "irc/SendQueue.hpp"
 
 // Configuration class for IRC server settings
 // Manages port, password, and other server configuration
@@ -13,17 +15,68 @@ public:
     // Getters
     int getPort() const;
     const std::string& getPassword() const;
+    const std::string& getServerName() const;     // prefix of server replies, default "ft_irc"
+    const std::string& getPollerBackend() const;  // "poll", "epoll", "uring" or "auto"
+    bool getEdgeTriggered() const;                // epoll with EPOLLET
+    int getThreads() const;                       // number of reactors (event loop threads)
+    int getCpuForReactor(int reactor) const;      // CPU to pin reactor to, -1 = no pinning
+    const SendQueue::Limits& getSendQLimits() const;  // per-client outbound limits
+    bool getTcpCork() const;                      // TCP_CORK around multi-message flushes
+    int getPingInterval() const;                  // s of silence before a PING, 0 = never
+    int getPingTimeout() const;                   // s to answer it before "Ping timeout"
+    int getRegistrationTimeout() const;           // s to finish PASS/NICK/USER, 0 = no limit
+    const std::string& getLogLevel() const;       // "debug", "info", "warn", "error" or "off"
+    const std::string& getLogFile() const;        // appended to, empty = stderr
+    int getLogRate() const;                       // lines/s per log statement, 0 = no limit
     
     // Setters (if needed)
     void setPort(int port);
     void setPassword(const std::string& password);
+    void setServerName(const std::string& serverName);
+    void setPollerBackend(const std::string& backend);
+    void setEdgeTriggered(bool edgeTriggered);
+    void setThreads(int threads);
+    void setCpus(const std::vector<int>& cpus);
+    void setSendQLimits(const SendQueue::Limits& limits);
+    void setTcpCork(bool tcpCork);
+    void setPingInterval(int seconds);
+    void setPingTimeout(int seconds);
+    void setRegistrationTimeout(int seconds);
+    void setLogLevel(const std::string& level);
+    void setLogFile(const std::string& path);
+    void setLogRate(int perSecond);
     
     // Parse configuration from command line arguments
+    // Usage: ./ircserv <port> <password> [--poller poll|epoll|uring|auto]
+    //                  [--server-name NAME]
+    //                  [--edge-triggered]
+    //                  [--threads N] [--cpus 0,1,2,...]
+    //                  [--sendq-soft BYTES] [--sendq-hard BYTES]
+    //                  [--sendq-soft-msgs N] [--sendq-hard-msgs N]
+    //                  [--sendq-policy drop|pause|both|none]
+    //                  [--tcp-cork]
+    //                  [--ping-interval S] [--ping-timeout S]
+    //                  [--registration-timeout S]
+    //                  [--log-level debug|info|warn|error|off] [--log-file PATH]
+    //                  [--log-rate N]
     static Config parseArgs(int argc, char** argv);
     
 private:
     int port_;
     std::string password_;
+    std::string serverName_;
+    std::string pollerBackend_;
+    bool edgeTriggered_;
+    int threads_;
+    std::vector<int> cpus_;     // reactor i runs on cpus_[i % size], empty = not pinned
+    SendQueue::Limits sendqLimits_;
+    bool tcpCork_;
+    int pingInterval_;
+    int pingTimeout_;
+    int registrationTimeout_;
+    std::string logLevel_;
+    std::string logFile_;
+    int logRate_;
     // Add other configuration options as needed
 };
 
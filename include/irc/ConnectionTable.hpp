@@ -0,0 +1,79 @@
+#ifndef CONNECTIONTABLE_HPP
+#define CONNECTIONTABLE_HPP
+
+#include <vector>
+#include <cstddef>
+
+class Client;
+class MessageBuffer;
+class SendQueue;
+class Reactor;
+
+// ConnectionTable - per-connection state indexed directly by fd
+// The kernel hands out the lowest free fd, so the table stays dense: one
+// array access instead of a tree lookup per map on every packet.
+//
+// - Slot: the hot part of a connection, what the I/O path touches
+//   (buffers, queue, owner, fan-out mark, last input time), 48 bytes,
+//   contiguous
+// - Client: the cold part (nick/user/host/realname strings, memberships,
+//   registration state), reached through the slot. Also the liveness
+//   timer: a TimerWheel node needs a stable address, slots move when the
+//   table grows
+// - Handle: fd + generation. The generation changes every time the fd is
+//   opened again, so a handle kept across a disconnect (Reactor mailbox,
+//   flush list) finds nothing instead of the next connection on that fd
+//
+// The table does not own the objects it points to (Server does).
+// Owned by Server, used under its state lock. Slot pointers are valid
+// until the next open().
+class ConnectionTable {
+public:
+    struct Handle {
+        int fd;
+        unsigned int generation;
+
+        Handle() : fd(-1), generation(0) {}
+        Handle(int f, unsigned int g) : fd(f), generation(g) {}
+    };
+
+    struct Slot {
+        Client* client;             // NULL: fd not connected
+        MessageBuffer* buffer;      // NULL unless a partial line is pending
+        SendQueue* sendQueue;
+        Reactor* owner;             // reactor that accepted it
+        unsigned int generation;
+        unsigned int fanoutMark;    // see Server::broadcastToPeers()
+        unsigned long long lastActivity;    // monotonic ms of the last input
+    };
+
+    ConnectionTable();
+
+    // Take the slot of fd for a new connection (table grows as needed)
+    // Returns it cleared, with a new generation; fd must not be open
+    Slot* open(int fd);
+
+    // Release the slot (the objects it pointed to are the caller's)
+    void close(int fd);
+
+    // Open connection on fd, NULL if none
+    Slot* find(int fd);
+    // Same, NULL also if the connection the handle was taken from is gone
+    Slot* find(const Handle& handle);
+
+    // Handle of the connection open on fd (generation 0 if none)
+    Handle handle(int fd) const;
+
+    // Open connections / iteration bound (fds below it may be open)
+    size_t size() const;
+    int end() const;
+
+    // Zero every fanoutMark (fan-out epoch wrapped)
+    void clearMarks();
+
+private:
+    std::vector<Slot> slots_;
+    size_t count_;
+};
+
+#endif // CONNECTIONTABLE_HPP
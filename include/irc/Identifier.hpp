@@ -0,0 +1,67 @@
+#ifndef IDENTIFIER_HPP
+#define IDENTIFIER_HPP
+
+#include <string>
+#include <cstddef>
+
+// Identifier - handle to an interned, casefolded nickname or channel name
+// Every distinct name is stored once in a server-wide table, in RFC 1459
+// casefolded form (A-Z [ \ ] ^ -> a-z { | } ~) with its hash computed once.
+// Client and Channel keep handles instead of lowercase copies:
+// - equality is a pointer compare (same folded name = same entry)
+// - find() looks a raw name up without folding into a new string, so
+//   membership / invite checks never allocate
+// - entries are reference counted, the last handle removes the name
+//
+//   Identifier id("#Test");             // interns "#test"
+//   id == Identifier::find("#TEST")     // true, no allocation
+//
+// Not thread-safe: handles are created, copied and dropped under the
+// Server state lock, like the Client and Channel objects holding them.
+class Identifier {
+public:
+    // Empty handle (no name, equal only to other empty handles)
+    Identifier();
+
+    // Intern name (folded), adding it to the table if new
+    explicit Identifier(const std::string& name);
+    Identifier(const char* name, size_t length);
+
+    Identifier(const Identifier& other);
+    Identifier& operator=(const Identifier& other);
+    ~Identifier();
+
+    // Existing handle for name, empty if nothing holds it (no insert)
+    static Identifier find(const std::string& name);
+    static Identifier find(const char* name, size_t length);
+
+    bool empty() const;
+    const std::string& str() const;     // folded form, "" when empty
+    size_t hash() const;                // hash of the folded form
+
+    bool operator==(const Identifier& other) const { return entry_ == other.entry_; }
+    bool operator!=(const Identifier& other) const { return entry_ != other.entry_; }
+    bool operator<(const Identifier& other) const { return entry_ < other.entry_; }
+
+    // RFC 1459 casefolding (16 bytes per step with SSE2, 8 otherwise)
+    static void fold(const char* in, size_t length, char* out);
+    static std::string fold(const std::string& name);
+    static char foldChar(char c);
+
+    // Hash of the folded form of name (same value as hash() after interning)
+    // Folds and mixes 8 bytes per step, like the lookups' compare
+    static size_t hashFolded(const char* name, size_t length);
+
+    // Distinct names currently interned (tests / stats)
+    static size_t internedCount();
+
+    // Table entry (defined in Identifier.cpp)
+    struct Entry;
+
+private:
+    explicit Identifier(Entry* entry);
+
+    Entry* entry_;
+};
+
+#endif // IDENTIFIER_HPP
@@ -0,0 +1,127 @@
+#ifndef IDENTIFIERMAP_HPP
+#define IDENTIFIERMAP_HPP
+
+#include <vector>
+#include <cstddef>
+#include "irc/Identifier.hpp"
+
+// IdentifierMap - interned name -> T*, open addressing
+// Linear probing over a power of two slot array (load <= 1/2), backward
+// shift deletion (no tombstones). The hash is the one stored at interning
+// and a probe compares handles, so no string is read or hashed here.
+// Used by NickDirectory and ChannelRegistry (under the Server state lock).
+template <typename T>
+class IdentifierMap {
+public:
+    IdentifierMap() : slots_(INITIAL_SLOTS), count_(0) {}
+
+    // Value for key, NULL if none
+    T* find(const Identifier& key) const {
+        size_t slot = findSlot(key);
+        return (slot < slots_.size()) ? slots_[slot].value : NULL;
+    }
+
+    // Add key -> value; the value already there (not replaced) if the key
+    // is taken, NULL after inserting
+    T* insert(const Identifier& key, T* value) {
+        if (key.empty()) return NULL;
+
+        size_t slot = findSlot(key);
+        if (slot < slots_.size()) {
+            return slots_[slot].value;
+        }
+        if ((count_ + 1) * 2 > slots_.size()) {
+            grow();
+        }
+        place(key, value);
+        ++count_;
+        return NULL;
+    }
+
+    // Drop key, return its value (NULL if it was not there)
+    T* remove(const Identifier& key) {
+        size_t slot = findSlot(key);
+        if (slot == slots_.size()) return NULL;
+
+        T* value = slots_[slot].value;
+        erase(slot);
+        --count_;
+        return value;
+    }
+
+    size_t size() const { return count_; }
+    size_t capacity() const { return slots_.size(); }
+
+    // Every value, in slot order (for teardown / stats)
+    void values(std::vector<T*>& out) const {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (!slots_[i].key.empty()) out.push_back(slots_[i].value);
+        }
+    }
+
+private:
+    enum { INITIAL_SLOTS = 64 };
+
+    struct Slot {
+        Identifier key;     // empty = free slot
+        T* value;
+
+        Slot() : value(NULL) {}
+    };
+
+    size_t findSlot(const Identifier& key) const {
+        if (key.empty()) return slots_.size();
+
+        size_t mask = slots_.size() - 1;
+        for (size_t i = key.hash() & mask; !slots_[i].key.empty(); i = (i + 1) & mask) {
+            if (slots_[i].key == key) {
+                return i;
+            }
+        }
+        return slots_.size();
+    }
+
+    void place(const Identifier& key, T* value) {
+        size_t mask = slots_.size() - 1;
+        size_t i = key.hash() & mask;
+        while (!slots_[i].key.empty()) i = (i + 1) & mask;
+        slots_[i].key = key;
+        slots_[i].value = value;
+    }
+
+    // Move later entries of the probe chain into the hole unless their
+    // home slot lies in (hole, next]
+    void erase(size_t hole) {
+        size_t mask = slots_.size() - 1;
+        size_t next = (hole + 1) & mask;
+        while (!slots_[next].key.empty()) {
+            size_t home = slots_[next].key.hash() & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                slots_[hole] = slots_[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        slots_[hole].key = Identifier();
+        slots_[hole].value = NULL;
+    }
+
+    void grow() {
+        std::vector<Slot> old(slots_.size() * 2);
+        old.swap(slots_);
+        for (size_t i = 0; i < old.size(); ++i) {
+            if (!old[i].key.empty()) {
+                place(old[i].key, old[i].value);
+            }
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t count_;
+
+    // Not copyable
+    IdentifierMap(const IdentifierMap&);
+    IdentifierMap& operator=(const IdentifierMap&);
+};
+
+#endif // IDENTIFIERMAP_HPP
@@ -0,0 +1,123 @@
+#ifndef IOURING_HPP
+#define IOURING_HPP
+
+#include <cstddef>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+// IoUring class - minimal io_uring ring used by Poller's BACKEND_URING
+// Talks to the kernel with raw syscalls (no liburing dependency)
+// Only Poller uses this class - see TEAM_CONVENTIONS.md section 1
+//
+// Supports what the IRC server needs:
+// - multishot accept on the listening socket
+// - multishot recv on client sockets, data lands in a provided buffer ring
+// - one-shot poll (POLLOUT) while a client has queued output
+// - sendmsg of a client's queued output (the flush phase queues one per
+//   connection, all of them go to the kernel with the next poll())
+// - cancel of in-flight requests when a fd leaves the Poller
+// SQEs are only queued by the prep*() calls and go to the kernel in one
+// io_uring_enter() from submitAndWait(), so a whole event loop pass is
+// submitted as a single batch.
+class IoUring {
+public:
+    // One completion copied out of the CQ ring
+    struct Completion {
+        unsigned long long userData;
+        int result;
+        unsigned int flags;
+    };
+
+    IoUring();
+    ~IoUring();
+
+    // Create the ring and register the provided buffer ring
+    // Returns false if io_uring (or a needed feature) is unavailable
+    bool init(unsigned int entries, unsigned int bufferCount, unsigned int bufferSize);
+    bool isReady() const;
+
+    // Queue requests (submitted on the next submit()/submitAndWait())
+    bool prepMultishotAccept(int fd, unsigned long long userData);
+    bool prepMultishotRecv(int fd, unsigned long long userData);
+    bool prepPollAdd(int fd, short events, unsigned long long userData);
+    bool prepCancel(unsigned long long targetUserData, unsigned long long userData);
+    // sendmsg(MSG_DONTWAIT) of iov: the iovec array is copied, the bytes it
+    // points to must stay put until the completion. Never blocks in the
+    // kernel: a full socket completes with -EAGAIN, not later.
+    // False if sends are unsupported (kernel without SUBMIT_STABLE) or full
+    bool prepSend(int fd, const struct iovec* iov, int count, unsigned long long userData);
+    bool canSend() const;
+
+    // Submit queued SQEs without waiting
+    int submit();
+
+    // Submit queued SQEs and wait up to timeoutMs (-1 = forever) for a completion
+    // Completions are appended to out, returns their number
+    int submitAndWait(int timeoutMs, std::vector<Completion>& out);
+
+    // Provided buffer access for recv completions (IORING_CQE_F_BUFFER)
+    static bool hasBuffer(const Completion& completion);
+    static unsigned short bufferId(const Completion& completion);
+    static bool hasMore(const Completion& completion);
+    const char* bufferData(unsigned short bufferId) const;
+    void recycleBuffer(unsigned short bufferId);
+
+    // Submission statistics (for benchmarks)
+    unsigned long getEnterCalls() const;
+
+private:
+    int ringFd_;
+
+    // Submission queue ring (mmap'ed)
+    void* sqRing_;
+    size_t sqRingSize_;
+    unsigned int* sqHead_;
+    unsigned int* sqTail_;
+    unsigned int* sqMask_;
+    unsigned int* sqArray_;
+    void* sqes_;
+    size_t sqesSize_;
+    unsigned int sqEntries_;
+    unsigned int sqLocalTail_;  // SQEs prepared but not yet published to the kernel
+
+    // Completion queue ring (mmap'ed, may share sqRing_)
+    void* cqRing_;
+    size_t cqRingSize_;
+    unsigned int* cqHead_;
+    unsigned int* cqTail_;
+    unsigned int* cqMask_;
+    void* cqes_;
+
+    // Provided buffer ring (group 0)
+    void* bufRing_;
+    size_t bufRingSize_;
+    unsigned int bufEntries_;
+    unsigned int bufSize_;
+    unsigned short bufTail_;
+    std::vector<char> bufStorage_;
+
+    // prepSend() arguments, read by the kernel when the SQE is submitted
+    // (IORING_FEAT_SUBMIT_STABLE): reused once everything queued is submitted
+    bool sendStable_;
+    std::vector<struct msghdr> sendMsgs_;
+    std::vector<struct iovec> sendIovs_;
+    size_t sendMsgsUsed_;
+    size_t sendIovsUsed_;
+
+    unsigned long enterCalls_;
+
+    // Not copyable (owns mappings and the ring fd)
+    IoUring(const IoUring&);
+    IoUring& operator=(const IoUring&);
+
+    void* getSqe();
+    void publishSqes();
+    void releaseSendArgs();
+    int enter(unsigned int toSubmit, unsigned int minComplete, unsigned int flags,
+              void* arg, size_t argSize);
+    void addBuffer(unsigned short bufferId);
+    void destroy();
+};
+
+#endif // IOURING_HPP
@@ -0,0 +1,221 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <streambuf>
+#include <cstddef>
+#include <pthread.h>
+
+// Logger - leveled logging off the event loop
+// A log statement formats its line into a fixed buffer on the calling
+// thread and pushes it into a lock-free ring (bounded MPSC queue, one
+// sequence number per cell). A writer thread drains the ring and writes
+// whole batches with one write(2), so reactors never block on the
+// terminal or the disk. Ring full: the line is dropped and counted.
+//
+//   IRC_LOG_DEBUG("Server", LogFields(fd), "Received " << n << " bytes");
+//   IRC_LOG_WARN("Server", LogFields(fd).withNick(nick), "SendQ exceeded");
+//
+// - Compile time: statements below IRC_LOG_LEVEL are dead code (default
+//   LEVEL_INFO; make LOG_LEVEL=0 keeps debug logging in the binary)
+// - Run time: setLevel() (--log-level), checked before any formatting
+// - Rate: every log statement has its own token bucket (setRateLimit(),
+//   --log-rate lines per second, a second's worth of burst). Lines over it
+//   are not formatted; the next one let through says how many were
+//   suppressed, and the writer reports the total every second
+// - Repeats: the same line again (level, component, fields, text) is
+//   counted, not written, and summarised once it stops or after a second
+// - The writer sleeps on a condition variable while the ring is empty;
+//   a producer signals it only when it is actually asleep
+// - Before start() and after stop() lines are written synchronously
+//   (tests, startup errors)
+// LogRate - token bucket of one log statement (GCRA: the time its next
+// line is due); a zero-initialised static in every IRC_LOG expansion
+struct LogRate {
+    unsigned long long dueUs;       // monotonic clock, atomic
+    unsigned long suppressed;       // atomic
+};
+
+class Logger {
+public:
+    enum Level {
+        LEVEL_DEBUG = 0,
+        LEVEL_INFO,
+        LEVEL_WARN,
+        LEVEL_ERROR,
+        LEVEL_OFF
+    };
+
+    enum {
+        RING_SIZE = 4096,           // cells, power of two
+        COMPONENT_SIZE = 16,
+        NICK_SIZE = 32,
+        COMMAND_SIZE = 16,
+        TEXT_SIZE = 400             // longer lines are truncated
+    };
+
+    static Logger& instance();
+
+    // Runtime threshold; levels below it cost one compare
+    static bool isEnabled(Level level) {
+        return level >= __atomic_load_n(&level_, __ATOMIC_RELAXED);
+    }
+    static void setLevel(Level level);
+    // Lines per second of each log statement, 0 = unlimited (default)
+    static void setRateLimit(unsigned long perSecond);
+    // Takes a token from rate: false if the statement is over its limit. When true,
+    // suppressed is how many lines it lost since the last one let through
+    static bool allow(LogRate& rate, unsigned long& suppressed);
+    static Level levelFromName(const std::string& name);   // "debug", ... (default info)
+    static const char* levelName(Level level);
+
+    // Start the writer thread, output to fd (not closed by the logger)
+    void start(int fd);
+    // Drain what is queued, stop the writer thread
+    void stop();
+
+    // Any thread: queue one line (see LogLine)
+    void submit(Level level, const char* component, int fd, const char* nick,
+                const char* command, const char* text, size_t length);
+
+    // Lines lost to a full ring so far
+    unsigned long dropped() const;
+    // Lines held back by the rate limit so far
+    static unsigned long rateLimited();
+
+private:
+    struct Record {
+        unsigned long sequence;     // ring protocol, see submit()
+        unsigned long long timeMs;  // wall clock
+        int level;
+        int fd;
+        unsigned short length;
+        char component[COMPONENT_SIZE];
+        char nick[NICK_SIZE];
+        char command[COMMAND_SIZE];
+        char text[TEXT_SIZE];
+    };
+
+    static int level_;                          // a Level, atomic
+    static unsigned long long rateIntervalUs_;  // 0 = no limit, atomic
+    static unsigned long rateLimited_;
+
+    std::vector<Record> ring_;
+    unsigned long enqueuePos_;      // producers (CAS)
+    unsigned long dequeuePos_;      // writer thread only
+    unsigned long dropped_;
+    unsigned long droppedReported_;
+
+    int fd_;
+    pthread_t thread_;
+    bool running_;                  // writer thread started (atomic: producers read it)
+    bool stopping_;
+
+    // Writer wakeup: the writer sets sleeping_ and re-checks the ring
+    // under wakeLock_ before it waits, producers signal only when set
+    pthread_mutex_t wakeLock_;
+    pthread_cond_t wake_;
+    bool sleeping_;
+
+    // Writer thread only
+    std::string out_;               // batch for one write(2)
+    Record last_;                   // last line written, for repeats
+    unsigned long repeats_;
+    unsigned long long repeatSince_;
+    unsigned long rateReported_;
+
+    Logger();
+    ~Logger();
+
+    bool drain();
+    bool pending() const;
+    void wakeWriter();
+    void sleep();
+    void report(const char* what, unsigned long count, unsigned long& reported);
+    void emit(const Record& record);
+    void flushRepeats(unsigned long long now);
+    static void format(const Record& record, std::string& out);
+    void writeOut();
+    static void fill(Record& record, Level level, const char* component, int fd,
+                     const char* nick, const char* command, const char* text, size_t length);
+    static bool sameLine(const Record& a, const Record& b);
+    static void* threadMain(void* arg);
+
+    // Not copyable
+    Logger(const Logger&);
+    Logger& operator=(const Logger&);
+};
+
+// LogFields - structured fields of a line, printed as fd= nick= cmd=
+// Strings are copied when the line is queued, pointers only need to live
+// for the statement
+struct LogFields {
+    int fd;                 // -1 = none
+    const char* nick;       // NULL = none
+    const char* command;
+
+    LogFields() : fd(-1), nick(NULL), command(NULL) {}
+    explicit LogFields(int f) : fd(f), nick(NULL), command(NULL) {}
+
+    LogFields& withNick(const std::string& n) { nick = n.c_str(); return *this; }
+    LogFields& withCommand(const std::string& c) { command = c.c_str(); return *this; }
+};
+
+// LogLine - one statement of the IRC_LOG macros
+// operator<< formats into a stack buffer (no allocation), submit() hands
+// it to the Logger, with " (N suppressed)" if the rate limit held lines back
+class LogLine {
+public:
+    LogLine(Logger::Level level, const char* component, const LogFields& fields,
+            unsigned long suppressed = 0);
+
+    std::ostream& stream() { return stream_; }
+    void submit();
+
+private:
+    // streambuf over text_: what does not fit is cut off
+    class FixedBuf : public std::streambuf {
+    public:
+        FixedBuf(char* begin, size_t size) { setp(begin, begin + size); }
+        size_t length() const { return static_cast<size_t>(pptr() - pbase()); }
+    };
+
+    Logger::Level level_;
+    const char* component_;
+    LogFields fields_;
+    unsigned long suppressed_;
+    char text_[Logger::TEXT_SIZE];
+    FixedBuf buf_;
+    std::ostream stream_;
+
+    // Not copyable
+    LogLine(const LogLine&);
+    LogLine& operator=(const LogLine&);
+};
+
+#ifndef IRC_LOG_LEVEL
+# define IRC_LOG_LEVEL 1    // Logger::LEVEL_INFO
+#endif
+
+// level is a constant: below IRC_LOG_LEVEL the whole statement folds away
+// (the message still has to compile). Each expansion has its own LogRate.
+#define IRC_LOG(level, component, fields, message) \
+    do { \
+        static LogRate logRate_ = { 0, 0 }; \
+        unsigned long logSuppressed_; \
+        if ((level) >= IRC_LOG_LEVEL && Logger::isEnabled(level) \
+            && Logger::allow(logRate_, logSuppressed_)) { \
+            LogLine logLine_((level), (component), (fields), logSuppressed_); \
+            logLine_.stream() << message; \
+            logLine_.submit(); \
+        } \
+    } while (0)
+
+#define IRC_LOG_DEBUG(component, fields, message) IRC_LOG(Logger::LEVEL_DEBUG, component, fields, message)
+#define IRC_LOG_INFO(component, fields, message)  IRC_LOG(Logger::LEVEL_INFO, component, fields, message)
+#define IRC_LOG_WARN(component, fields, message)  IRC_LOG(Logger::LEVEL_WARN, component, fields, message)
+#define IRC_LOG_ERROR(component, fields, message) IRC_LOG(Logger::LEVEL_ERROR, component, fields, message)
+
+#endif // LOGGER_HPP
@@ -0,0 +1,75 @@
+#ifndef MEMBERSHIP_HPP
+#define MEMBERSHIP_HPP
+
+#include <vector>
+#include <cstddef>
+
+class Client;
+class Channel;
+
+// Membership - one node per (client, channel) pair
+// The only record that a client is in a channel: linked into the
+// channel's member list and the client's channel list at the same time,
+// so leaving unlinks both sides in O(1) without searching either. The
+// per-member channel status (operator, voice) lives in its flags.
+//
+//   Channel::addClient(client)    creates the node, links both sides
+//   Channel::removeClient(client) unlinks both sides, frees the node
+//   Channel::getMembership(client) O(1) through the channel's index
+//
+// Nodes come from a pool (create()/destroy()), used under the Server state
+// lock like the Client and Channel objects they connect.
+struct Membership {
+    enum Flag {
+        FLAG_OPERATOR = 1 << 0,     // '@'
+        FLAG_VOICE    = 1 << 1      // '+'
+    };
+
+    Client* client;
+    Channel* channel;
+    unsigned int flags;
+
+    // Channel's member list (join order)
+    Membership* prevInChannel;
+    Membership* nextInChannel;
+
+    // Client's channel list (join order)
+    Membership* prevInClient;
+    Membership* nextInClient;
+
+    // Position of the client's fd in the channel's fan-out array
+    size_t fanoutSlot;
+
+    bool hasFlag(Flag flag) const { return (flags & flag) != 0; }
+    void setFlag(Flag flag, bool value) {
+        if (value) flags |= flag;
+        else flags &= ~static_cast<unsigned int>(flag);
+    }
+
+    // Pooled allocation (no links set up, see Channel::addClient)
+    static Membership* create(Client* client, Channel* channel);
+    static void destroy(Membership* membership);
+};
+
+// MembershipIndex - Client* -> Membership* for one channel
+// Open addressing on the client pointer (linear probing, load <= 1/2,
+// backward-shift deletion): hasClient()/isOperator() are O(1) however
+// many members the channel has.
+class MembershipIndex {
+public:
+    MembershipIndex();
+
+    Membership* find(const Client* client) const;
+    void insert(Membership* membership);    // client must not be there yet
+    void remove(const Client* client);
+    size_t size() const;
+
+private:
+    size_t home(const Client* client) const;
+    void grow();
+
+    std::vector<Membership*> slots_;
+    size_t count_;
+};
+
+#endif // MEMBERSHIP_HPP
@@ -16,33 +16,85 @@
 
 #include <string>
 #include <vector>
+#include <cstddef>
+
+struct LineIndex;
+
+// Default capacity: room for many pipelined 512-byte IRC lines
+# define MESSAGEBUFFER_CAPACITY 8192
 
 // MessageBuffer class - manages incomplete messages
 // Accumulates data until complete messages (ending with CRLF) are found
+//
+// Compacting linear buffer: [readPos_, writePos_) holds unread bytes.
+// - recv() writes straight into the free tail (writableData/commitWrite),
+//   no stack array and no temporary std::string
+// - complete lines are consumed by advancing readPos_, never by erasing
+//   from the front, so N pipelined lines cost O(bytes) not O(N * bytes)
+// - unread bytes move back to the front only when the tail runs out
+// - storage is its own vector, or a block handed in by the owner
+//   (Server: BlockPool), so pooled buffers do not allocate at all
 class MessageBuffer {
     private:
-        // Accumulated data
-        std::string buffer_;
+        char* storage_;         // owned_, or the block handed in
+        size_t storageSize_;
+        char* block_;           // block handed in (caller's), NULL if none
+        std::vector<char> owned_;
+        size_t capacity_;   // configured size (append() may grow storage_ past it)
+        size_t readPos_;    // first unread byte
+        size_t writePos_;   // end of received data
         
         // Helper: find next complete message in buffer
+        // Returns offset of '\r' relative to readPos_, npos if none
         size_t findMessageEnd(size_t startPos = 0) const;
 
+        // Move unread bytes to the front of storage_
+        void compact();
+
+        // Not copyable (storage_ may point into owned_)
+        MessageBuffer(const MessageBuffer&);
+        MessageBuffer& operator=(const MessageBuffer&);
+
         public:
         // Constructor
-        MessageBuffer();
+        MessageBuffer(size_t capacity = MESSAGEBUFFER_CAPACITY);
+
+        // On capacity bytes at block, which stays the caller's and must
+        // outlive the buffer (append() past it continues on the heap)
+        MessageBuffer(char* block, size_t capacity);
         
         // Destructor
         ~MessageBuffer();
         
-        // Append raw data to buffer
+        // Append raw data to buffer (grows past capacity if needed)
         void append(const std::string& data);
+        void append(const char* data, size_t length);
+
+        // Direct receive: recv(fd, writableData(), writableSize(), 0)
+        // then commitWrite(bytes). writableData() compacts first, so
+        // writableSize() is 0 only when the buffer is full of one
+        // unterminated line (caller decides: drop it or disconnect)
+        char* writableData();
+        size_t writableSize() const;
+        void commitWrite(size_t length);
+
+        // Zero-copy access to the next complete line (without CRLF)
+        // line stays valid until the next write into the buffer and may
+        // be modified in place (Parser uppercases the command there)
+        // Returns false if no complete line is buffered
+        bool nextLine(char*& line, size_t& length);
+        bool nextLine(const char*& line, size_t& length);
+
+        // Same, and index filled by the same pass that found the line
+        // end (hand it to Parser::parse() so the line is not rescanned)
+        bool nextLine(char*& line, size_t& length, LineIndex& index);
         
         // Extract complete messages (ending with \r\n)
         // Returns vector of complete messages, leaves incomplete data in buffer
         std::vector<std::string> extractMessages();
         
         // Get current buffer contents (for debugging)
-        const std::string& getBuffer() const;
+        std::string getBuffer() const;
         
         // Clear buffer
         void clear();
@@ -52,6 +104,16 @@ class MessageBuffer {
         
         // Get buffer size
         size_t size() const;
+
+        // Unread bytes (size() of them), valid until the next write
+        const char* data() const;
+
+        // Configured capacity: more unread bytes than this means a line
+        // too long for IRC (Server drops them)
+        size_t capacity() const;
+
+        // Block given to the constructor (NULL if none), to hand it back
+        char* block() const;
 };
 
 #endif
@@ -0,0 +1,39 @@
+#ifndef MUTEX_HPP
+#define MUTEX_HPP
+
+#include <pthread.h>
+
+// Mutex class - thin wrapper over pthread_mutex_t (C++98 has no std::mutex)
+// recursive = true lets the owning thread lock again (e.g. a handler that
+// already holds the server state lock calling disconnectClient())
+class Mutex {
+public:
+    explicit Mutex(bool recursive = false);
+    ~Mutex();
+
+    void lock();
+    void unlock();
+
+private:
+    pthread_mutex_t mutex_;
+
+    // Not copyable
+    Mutex(const Mutex&);
+    Mutex& operator=(const Mutex&);
+};
+
+// ScopedLock - locks in constructor, unlocks in destructor
+class ScopedLock {
+public:
+    explicit ScopedLock(Mutex& mutex);
+    ~ScopedLock();
+
+private:
+    Mutex& mutex_;
+
+    // Not copyable
+    ScopedLock(const ScopedLock&);
+    ScopedLock& operator=(const ScopedLock&);
+};
+
+#endif // MUTEX_HPP
@@ -0,0 +1,50 @@
+#ifndef NICKDIRECTORY_HPP
+#define NICKDIRECTORY_HPP
+
+#include <string>
+#include <cstddef>
+#include "irc/Identifier.hpp"
+#include "irc/IdentifierMap.hpp"
+
+class Client;
+
+// NickDirectory - casefolded nickname -> Client*, for nick lookups
+// An IdentifierMap keyed by the interned nick: O(1) lookups that compare
+// handles and touch no strings. Lookup by raw name goes through
+// Identifier::find() first (a nick nobody holds is not interned, so it
+// cannot be in the directory).
+//
+// Nicks are unique: insert()/rename() refuse a nick held by another client.
+// rename() swaps a client's entry in one step (NICK), remove() on disconnect.
+// Owned by Server, used under its state lock.
+class NickDirectory {
+public:
+    NickDirectory();
+    ~NickDirectory();
+
+    // Client holding nick, NULL if none
+    Client* find(const Identifier& nick) const;
+    Client* find(const std::string& nickname) const;
+
+    // Map nick to client; false if another client holds it
+    bool insert(const Identifier& nick, Client* client);
+
+    // Move client from oldNick (empty: first nick) to newNick
+    // false (nothing changed) if another client holds newNick
+    bool rename(Client* client, const Identifier& oldNick, const Identifier& newNick);
+
+    // Drop nick if it belongs to client
+    void remove(const Identifier& nick, Client* client);
+
+    size_t size() const;
+    size_t capacity() const;    // slots
+
+private:
+    IdentifierMap<Client> nicks_;
+
+    // Not copyable
+    NickDirectory(const NickDirectory&);
+    NickDirectory& operator=(const NickDirectory&);
+};
+
+#endif // NICKDIRECTORY_HPP
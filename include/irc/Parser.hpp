@@ -19,6 +19,8 @@
 
 // Forward declaration
 struct Command;
+struct CommandView;
+struct LineIndex;
 
 // Parser class - parses IRC message format into Command structure
 // Format: [:<prefix>] <command> [params] [:<trailing>]\r\n
@@ -33,6 +35,23 @@ public:
     // Parse a complete IRC message string into Command structure
     // Returns true if parsing successful, false otherwise
     bool parse(const std::string& message, Command& cmd);
+
+    // Zero-copy variant: fill view with pointers into line (no allocation)
+    // The command name is uppercased in place, so line must be writable
+    // Same rules as parse() above, CRLF at the end is optional
+    bool parse(char* line, size_t length, CommandView& view);
+
+    // Same, with the LineIndex from MessageBuffer::nextLine() (line
+    // without CRLF, the index describes exactly these length bytes)
+    bool parse(char* line, size_t length, const LineIndex& index, CommandView& view);
+
+    // Copy a view into an owning Command (reuses cmd's string capacity)
+    static void toCommand(const CommandView& view, Command& cmd);
+
+private:
+    // Next ' ' at or after pos, length if none (from the Scanner index)
+    static size_t findSpace(const LineIndex& index, size_t& cursor,
+                            const char* line, size_t pos, size_t length);
 };
 
 #endif
@@ -1,46 +1,127 @@
 #ifndef POLLER_HPP
 #define POLLER_HPP
 
+#include <string>
 #include <vector>
 #include <poll.h>
+#ifdef __LINUX__
+# include <sys/epoll.h>
+#endif
+#include "irc/IoUring.hpp"
 
 class Server;  // Forward declaration
 
 // Poller class - ONLY class that calls poll() system call
 // Manages file descriptor polling and event detection
 // See TEAM_CONVENTIONS.md: Only Poller class calls poll()
+//
+// Interchangeable backends behind the same interface:
+// - BACKEND_POLL:  portable poll(), cost per iteration grows with watched fds
+// - BACKEND_EPOLL: Linux epoll, cost per iteration grows with READY fds only
+// - BACKEND_URING: Linux io_uring, completion based: multishot accept on the
+//                  server socket and multishot recv into a provided buffer
+//                  ring, so processEvents() hands bytes (not readiness) to
+//                  Server::acceptConnection() / Server::handleClientData()
+//                  POLLOUT is a one-shot poll request, re-armed by modifyFd()
+//                  Output can go through the ring too (submitSend()): the
+//                  sends of a flush phase are submitted with the next poll()
+// Event masks in the public interface are always POLLIN/POLLOUT/... values,
+// the epoll backend translates them internally.
+//
+// The epoll backend can run edge-triggered (Config --edge-triggered): Server
+// reads and accepts until EAGAIN within a budget, and hands a fd it stopped
+// early on back through markReadable() so it is not lost without a new edge.
 class Poller {
 public:
-    // Constructor
-    Poller(Server* server);
-    
+    enum Backend {
+        BACKEND_POLL,
+        BACKEND_EPOLL,
+        BACKEND_URING
+    };
+
+    // Constructor (edgeTriggered only applies to BACKEND_EPOLL)
+    Poller(Server* server, Backend backend = defaultBackend(), bool edgeTriggered = false);
+
     // Destructor
     ~Poller();
-    
+
     // Add file descriptor to watch list
     void addFd(int fd, short events);
-    
+
     // Remove file descriptor from watch list
     void removeFd(int fd);
-    
+
+    // Change the watched events of a fd (Server arms POLLOUT only while
+    // the fd's SendQueue holds data). Same mask as before is a no-op.
+    void modifyFd(int fd, short events);
+
     // Main polling loop - ONLY place poll() is called
     // Returns number of ready file descriptors
     int poll(int timeout = -1);
-    
+
     // Process events after poll() returns
     void processEvents();
-    
+
+    // fd may still have input left after a budgeted read/accept loop:
+    // report it as POLLIN again on the next poll() (which then does not
+    // block). Level-triggered backends report it anyway, no-op there.
+    void markReadable(int fd);
+
+    // uring backend: queue a sendmsg of iov (copied; the bytes must stay
+    // put until the completion) for the next poll(). The result comes back
+    // through Server::handleSendComplete() (bytes sent or -errno, -EAGAIN
+    // when the socket is full). False: nothing queued, write it yourself
+    bool submitSend(int fd, const struct iovec* iov, int count);
+    bool canSubmitSends() const;
+    // uring backend: hand queued requests to the kernel now, without
+    // waiting for the next poll() (no-op elsewhere)
+    void submitPending();
+
     // Check if a file descriptor has specific event
     bool hasEvent(int fd, short event) const;
-    
+
+    // Backend selection (chosen once at startup, see Config)
+    Backend getBackend() const;
+    bool isEdgeTriggered() const;
+    static Backend defaultBackend();
+    static Backend backendFromName(const std::string& name);
+    static const char* backendName(Backend backend);
+
 private:
+    // One entry per fd reported ready by the last poll()
+    struct ReadyEvent {
+        int fd;
+        short revents;
+    };
+
     Server* server_;
-    std::vector<struct pollfd> pollfds_;  // List of file descriptors to poll
-    
+    Backend backend_;
+    bool edgeTriggered_;                  // EPOLLET on every fd (epoll backend)
+    std::vector<int> pendingReads_;       // markReadable() fds for the next poll()
+    std::vector<struct pollfd> pollfds_;  // List of file descriptors to poll (poll backend)
+    std::vector<int> fdIndex_;            // fd -> index in pollfds_ (generation for uring), -1 if not watched
+    std::vector<short> fdEvents_;         // fd -> watched events (epoll and uring backends)
+    std::vector<ReadyEvent> ready_;       // Ready list filled by poll(), consumed by processEvents()
+    size_t watched_;                      // Number of watched fds (both backends)
+    int epollFd_;                         // epoll instance (epoll backend), -1 otherwise
+#ifdef __LINUX__
+    std::vector<struct epoll_event> epollEvents_;  // epoll_wait() output (epoll backend)
+#endif
+    IoUring* uring_;                                // io_uring ring (uring backend), NULL otherwise
+    std::vector<IoUring::Completion> completions_;  // CQEs reaped by poll() (uring backend)
+    unsigned int generation_;                       // Tags io_uring requests per addFd() (uring backend)
+
     // Helper methods
     int findFdIndex(int fd) const;
-    void updatePollfds();
+    void setFdIndex(int fd, int index);
+    int pollWithPoll(int timeout);
+    int pollWithEpoll(int timeout);
+    int pollWithUring(int timeout);
+    int addPendingReads();
+    void processCompletions();
+    void armUring(int fd, int generation);
+    short getFdEvents(int fd) const;
+    void setFdEvents(int fd, short events);
 };
 
 #endif // POLLER_HPP
-
@@ -0,0 +1,149 @@
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include "irc/Poller.hpp"
+#include "irc/Mutex.hpp"
+#include "irc/SendQueue.hpp"
+#include "irc/TimerWheel.hpp"
+#include "irc/ConnectionTable.hpp"
+#include "irc/MessageBuffer.hpp"
+#include "irc/Command.hpp"
+
+class Server;  // Forward declaration
+
+// Reactor class - one event loop: listening socket + Poller + thread
+// Server runs Config::getThreads() reactors. Each one has its own
+// SO_REUSEPORT listening socket, so the kernel spreads new connections
+// across them, and owns the clients it accepted (their sockets,
+// MessageBuffers and writes).
+//
+// Threading rules (see Server.hpp):
+// - Socket I/O of a client only happens on its owner reactor thread
+// - Shared state (connections, channels, nick lookups) and command handlers
+//   run under Server::getStateLock()
+// - A handler that sends to a client owned by another reactor goes
+//   through post(): the message is queued in the owner's mailbox and the
+//   owner is woken through its wake socket (once the poster released the
+//   state lock, see wakePeers())
+class Reactor {
+public:
+    // Constructor: takes ownership of listenFd, creates the Poller
+    // cpu >= 0 pins the reactor thread to that CPU
+    Reactor(Server* server, int id, int listenFd, Poller::Backend backend,
+            bool edgeTriggered, int cpu);
+
+    // Destructor: closes listening and wake sockets
+    ~Reactor();
+
+    int getId() const;
+    int getListenFd() const;
+    int getWakeFd() const;
+    Poller* getPoller() const;
+
+    // Run the event loop on a new thread / wait for it to finish
+    void start();
+    void join();
+
+    // Event loop body (thread entry, or called directly for reactor 0)
+    void run();
+
+    // Cross-reactor delivery (any thread): queue data / a disconnect
+    // request for a client owned by this reactor. Dropped on delivery if
+    // that connection is gone by then (its fd may be someone else's)
+    void post(const ConnectionTable::Handle& client, const SharedMessage& message,
+                SendQueue::Priority priority = SendQueue::PRIORITY_NORMAL);
+    void postDisconnect(const ConnectionTable::Handle& client);
+
+    // Owner thread: wake socket readable -> deliver the mailbox
+    void handleWakeup();
+
+    // Drop mail for a client that is going away (caller holds state lock)
+    void discardMail(int clientFd);
+
+    // Timers of this reactor's clients (owner thread only)
+    TimerWheel& getTimers();
+    // Monotonic ms, read once per loop iteration
+    unsigned long long now() const;
+
+    // One client in the flush phase: its queue is looked up under the
+    // state lock, written without it, the result handled under it again
+    struct Flush {
+        ConnectionTable::Handle client;
+        SendQueue* queue;
+        ssize_t written;    // SendQueue::flush() result
+        int error;          // its errno
+    };
+
+    // Owner thread, state lock held: client has output queued during this
+    // iteration, written in the flush phase at the end of it
+    // (Server::flushOutput(); the caller keeps it from being listed twice)
+    void scheduleFlush(const ConnectionTable::Handle& client, SendQueue* queue);
+    // Owner thread, state lock held: a queue passed SERVER_FLUSH_THRESHOLD,
+    // run the flush phase as soon as the lock is released (flushIfDue())
+    void requestFlush();
+    // Owner thread, state lock NOT held: flush phase now if requested
+    // (always writev(): handlers run before the next poll())
+    void flushIfDue();
+
+    // Owner thread, state lock NOT held: write the wake sockets of the
+    // reactors this thread post()ed to while it held the lock
+    void wakePeers();
+
+    // Owner thread: recv() target of clients with no partial line pending,
+    // empty between reads (see Server::handleClientInput())
+    MessageBuffer& getScratch();
+
+    // Owner thread: the parsed line handed to a command handler, reused
+    // (keeps string capacity), filled before the state lock is taken
+    Command& getCommand();
+
+    // Reactor running on the calling thread, NULL outside reactor loops
+    static Reactor* current();
+
+private:
+    struct Mail {
+        ConnectionTable::Handle client;
+        bool disconnect;
+        SendQueue::Priority priority;
+        SharedMessage message;      // shared with the other recipients of a broadcast
+    };
+
+    Server* server_;
+    int id_;
+    int listenFd_;
+    int wakeFds_[2];    // socketpair: [0] watched by Poller, [1] written by post()
+    int cpu_;
+    Poller* poller_;
+    pthread_t thread_;
+    bool threadStarted_;
+
+    Mutex mailboxLock_;
+    std::vector<Mail> mailbox_;
+    std::vector<Reactor*> wakeups_;     // owner thread only, see wakePeers()
+
+    std::vector<Flush> pendingFlush_;   // owner thread only, see scheduleFlush()
+    std::vector<Flush> flushing_;       // the batch flushOutput() works on
+    bool flushDue_;                     // see requestFlush()
+
+    TimerWheel timers_;
+    std::vector<TimerWheel::Timer*> firedTimers_;   // reused every iteration
+    unsigned long long now_;
+
+    MessageBuffer scratch_;
+    Command command_;
+
+    // Not copyable
+    Reactor(const Reactor&);
+    Reactor& operator=(const Reactor&);
+
+    void enqueue(const Mail& mail);
+    void wake();
+    void flush(bool viaRing);
+    void pinToCpu();
+    static void* threadMain(void* arg);
+};
+
+#endif // REACTOR_HPP
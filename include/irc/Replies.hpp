@@ -19,7 +19,8 @@
 class Client;
 
 // Replies class - builds IRC numeric replies and formatted messages
-// All messages end with \r\n (CRLF)
+// All messages end with \r\n (CRLF), capped at 512 bytes like ReplyBuilder
+// (which builds them; use it directly to send without any allocation)
 // See TEAM_CONVENTIONS.md
 class Replies {
 public:
@@ -74,11 +75,11 @@ public:
                               const std::string& params = "",
                               const std::string& trailing = "");
     
-    // Format client prefix: "nick!user@host"
-    static std::string formatClientPrefix(const Client& client);
+    // Format client prefix: "nick!user@host" (cached in Client)
+    static const std::string& formatClientPrefix(const Client& client);
     
-    // Format server name (usually from config)
-    static std::string formatServerName();
+    // Server name from Config (set once when the Server starts)
+    static const std::string& formatServerName();
 };
 
 #endif
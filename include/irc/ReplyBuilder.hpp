@@ -0,0 +1,70 @@
+#ifndef REPLYBUILDER_HPP
+#define REPLYBUILDER_HPP
+
+#include <string>
+#include <cstddef>
+
+// ReplyBuilder class - one outgoing IRC line, built in place
+// Append-only writes into an inline buffer (stack object in a handler), so
+// building a reply allocates nothing; Server::sendToClient(fd, builder)
+// send()s straight from it and only copies what the socket did not take.
+//
+//   ReplyBuilder reply;
+//   reply.numeric(Replies::RPL_TOPIC, nick).param(channel).trailing(topic).end();
+//   server.sendToClient(fd, reply);
+//
+// - numeric() starts with the pre-encoded ":<servername> " prefix
+// - Lines are capped at MAX_LINE (RFC 2812: 512 bytes with CRLF); longer
+//   content is cut, end() still terminates it and truncated() reports it
+// - clear() to reuse the same builder for the next line
+class ReplyBuilder {
+public:
+    enum { MAX_LINE = 512 };
+
+    ReplyBuilder();
+
+    // ":<servername> <code> <nickname>"
+    ReplyBuilder& numeric(const std::string& code, const std::string& nickname);
+
+    // ":<prefix> <command>" (no prefix: "<command>")
+    ReplyBuilder& command(const std::string& prefix, const char* command);
+
+    // " <param>"
+    ReplyBuilder& param(const std::string& value);
+    ReplyBuilder& param(const char* value);
+
+    // " :<text>" (last parameter, may contain spaces)
+    ReplyBuilder& trailing(const std::string& text);
+    ReplyBuilder& trailing(const char* text);
+
+    // Raw bytes, no separator
+    ReplyBuilder& append(const char* data, size_t length);
+    ReplyBuilder& append(const std::string& data);
+    ReplyBuilder& append(char c);
+
+    // "\r\n" (always fits: appends keep room for it)
+    ReplyBuilder& end();
+
+    const char* data() const;
+    size_t size() const;
+    bool truncated() const;
+    std::string str() const;
+    void clear();
+
+    // Bytes left before the line limit (without the CRLF)
+    size_t remaining() const;
+
+    // Server name used by numeric() (default "ft_irc"), stored encoded as
+    // ":<name> " once instead of being formatted for every reply
+    static void setServerName(const std::string& name);
+    static const std::string& getServerName();
+
+private:
+    ReplyBuilder& appendTruncated(const char* data, size_t length);
+
+    char buffer_[MAX_LINE];
+    size_t size_;
+    bool truncated_;
+};
+
+#endif // REPLYBUILDER_HPP
@@ -0,0 +1,65 @@
+#ifndef SCANNER_HPP
+#define SCANNER_HPP
+
+#include <cstddef>
+
+// LineIndex - token index of one IRC line, filled by Scanner::scanLine()
+// Positions of the separators the Parser needs, found in one pass:
+// - spaces before the trailing parameter
+// - the ':' that starts the trailing parameter
+// Spaces inside the trailing text are not recorded (they never split).
+struct LineIndex {
+    enum { MAX_SPACES = 64 };
+
+    unsigned int spaces[MAX_SPACES];    // ascending
+    size_t spaceCount;
+    size_t trailing;    // offset of the trailing ':' (after a space, past the
+                        // first token), npos if none
+    size_t indexedEnd;  // every space in [0, indexedEnd) is in spaces[]
+                        // (short of the line end only with a trailing ':',
+                        // more than MAX_SPACES spaces, or for indexLine()
+                        // a "\r\n" inside the line)
+
+    LineIndex() : spaceCount(0), trailing(static_cast<size_t>(-1)), indexedEnd(0) {}
+};
+
+// Scanner class - vectorized byte scanning shared by MessageBuffer and Parser
+// - scanLine():    next "\r\n" and the LineIndex of the line before it,
+//                  one pass over the bytes (MessageBuffer -> Parser)
+// - findLineEnd(): next "\r\n" only
+// - indexLine():   LineIndex of a line that is already split
+//
+// Implementations, the best one the CPU supports is picked at first use:
+// - IMPL_AVX2:   32 bytes per step (x86, compiled with a target attribute,
+//                no global -mavx2 needed)
+// - IMPL_SSE2:   16 bytes per step (x86)
+// - IMPL_SCALAR: memchr() loops, any platform (two passes)
+class Scanner {
+public:
+    enum Impl {
+        IMPL_SCALAR,
+        IMPL_SSE2,
+        IMPL_AVX2
+    };
+
+    // Offset of the first "\r\n" in data, npos (size_t(-1)) if none
+    static size_t findLineEnd(const char* data, size_t length);
+
+    // Offset of the first "\r\n" like findLineEnd(), and index filled for
+    // the bytes before it (only meaningful when a line end was found)
+    static size_t scanLine(const char* data, size_t length, LineIndex& index);
+
+    // Fill index for line (without CRLF)
+    static void indexLine(const char* line, size_t length, LineIndex& index);
+
+    // Implementation selection (benchmarks / tests force one)
+    static Impl getImpl();
+    static bool setImpl(Impl impl);     // false if the CPU lacks it
+    static bool isSupported(Impl impl);
+    static const char* implName(Impl impl);
+
+private:
+    Scanner();
+};
+
+#endif // SCANNER_HPP
@@ -0,0 +1,154 @@
+#ifndef SENDQUEUE_HPP
+#define SENDQUEUE_HPP
+
+#include <string>
+#include <deque>
+#include <cstddef>
+#include <sys/types.h>
+#include "irc/SharedMessage.hpp"
+
+struct iovec;
+
+// SendQueue class - outbound data of one connection not yet accepted by the kernel
+// Owned by Server (ConnectionTable slot of the fd, from a SlabPool) - see TEAM_CONVENTIONS.md
+//
+// Everything Server::writeToClient() sends during one event loop iteration
+// is queued here first and written by the reactor's flush phase
+// (Server::flushOutput()) with one writev() per connection. Whatever the
+// socket did not take stays queued ("blocked"): POLLOUT is armed for the
+// fd and Server::handleClientOutput() drains it the same way.
+// With io_uring the flush phase hands the chunks to the ring instead
+// (beginSend()), the result comes back later (completeSend()).
+// Chunks are SharedMessage references: a channel broadcast queued for many
+// slow members holds one copy of the bytes, not one per member. Replies
+// built by the caller are append()ed: copied into one staging buffer that
+// keeps its capacity, consecutive ones coalesce into a single chunk.
+//
+// Slow consumers are bounded by Limits (see Server::writeToClient()):
+// - soft limit: low priority traffic (channel PRIVMSG fan-out) is
+//   dropped and/or reading from the client is paused until it catches up
+// - hard limit: the client is disconnected with "SendQ exceeded"
+class SendQueue {
+public:
+    // Traffic class of a message, only PRIORITY_LOW may be dropped
+    enum Priority {
+        PRIORITY_NORMAL,
+        PRIORITY_LOW
+    };
+
+    // Per-connection limits, 0 = no limit
+    struct Limits {
+        size_t softBytes;
+        size_t hardBytes;
+        size_t softMessages;
+        size_t hardMessages;
+        bool dropLowPriority;   // soft limit policy: drop PRIORITY_LOW messages
+        bool pauseReading;      // soft limit policy: stop reading from the client
+
+        Limits();
+    };
+
+    // How often each policy fired (Server keeps one for all connections)
+    struct Stats {
+        unsigned long droppedMessages;
+        unsigned long droppedBytes;
+        unsigned long readPauses;
+        unsigned long readResumes;
+        unsigned long hardDisconnects;
+
+        Stats();
+    };
+
+    SendQueue();
+    ~SendQueue();
+
+    // Queue a message by reference
+    void push(const SharedMessage& message);
+
+    // Queue a copy of data in the staging buffer (no allocation once it has
+    // grown); joins the previous chunk if that one was appended too
+    void append(const char* data, size_t size);
+
+    // writev() queued chunks until the queue is empty or the socket is full
+    // Returns bytes written (0 if the socket was already full),
+    // -1 on a socket error (errno set, EAGAIN is not an error)
+    // Staged bytes left over are moved to their own blocks, so the staging
+    // buffer is empty again afterwards
+    // Nothing while a send is in flight (returns 0, ordering)
+    ssize_t flush(int fd);
+
+    // Asynchronous flush: iovecs of up to max queued chunks for one send,
+    // nothing is consumed until completeSend() gets its result. Returns
+    // the count (0: queue empty). At most one send in flight per queue;
+    // the bytes must not move until then, append() does not move them
+    // (the staging buffer may grow, the kernel reads it at submit time)
+    int beginSend(struct iovec* iov, int max);
+
+    // Result of that send: bytes sent or -errno (-EAGAIN: socket full).
+    // Blocked afterwards unless it took everything; staged leftovers are
+    // moved to their own blocks like after flush()
+    // False if the queue was clear()ed meanwhile (result ignored)
+    bool completeSend(ssize_t result);
+
+    // beginSend() was not submitted after all
+    void cancelSend();
+
+    bool isSending() const;
+
+    // Drop everything (connection going away)
+    void clear();
+
+    bool isEmpty() const;
+    size_t bytes() const;       // queued bytes not yet written
+    size_t messages() const;    // queued chunks (partially written head counts)
+
+    // Limit checks
+    bool overSoftLimit(const Limits& limits) const;
+    bool wouldExceedHardLimit(size_t extraBytes, const Limits& limits) const;
+
+    // Socket did not take everything at the last flush (waiting for POLLOUT)
+    bool isBlocked() const;
+
+    // In the reactor's flush list for this iteration
+    bool isFlushScheduled() const;
+    void setFlushScheduled(bool scheduled);
+
+    // Backpressure state of the connection
+    bool isReadingPaused() const;
+    void setReadingPaused(bool paused);
+    bool isClosing() const;             // hard limit hit, disconnect pending
+    void setClosing(bool closing);
+
+private:
+    // Bytes [offset, offset + length) of a block, or of staged_ if the
+    // block is empty
+    struct Chunk {
+        SharedMessage message;
+        size_t offset;
+        size_t length;
+
+        const char* data(const std::string& staged) const;
+    };
+
+    std::deque<Chunk> chunks_;
+    std::string staged_;        // append()ed bytes not flushed yet
+    size_t bytes_;
+    size_t sending_;            // bytes of the send in flight, 0 if none
+    bool blocked_;
+    bool flushScheduled_;
+    bool readingPaused_;
+    bool closing_;
+
+    void pushChunk(const SharedMessage& message, size_t offset, size_t length);
+
+    // iovecs of up to max chunks from the front, their total in bytes
+    int gather(struct iovec* iov, int max, size_t& bytes) const;
+
+    // Staged bytes still queued get their own block, staged_ starts over
+    void settleStaged();
+
+    // Remove n written bytes from the front
+    void consume(size_t n);
+};
+
+#endif // SENDQUEUE_HPP
@@ -3,32 +3,102 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <csignal>	
 #include "Client.hpp"
 #include "Poller.hpp"
 #include "Config.hpp"
 #include "irc/MessageBuffer.hpp"
+#include "irc/SendQueue.hpp"
+#include "irc/Mutex.hpp"
+#include "irc/Parser.hpp"
+#include "irc/Command.hpp"
+#include "irc/CommandRegistry.hpp"
+#include "irc/ReplyBuilder.hpp"
+#include "irc/NickDirectory.hpp"
+#include "irc/ChannelRegistry.hpp"
+#include "irc/TimerWheel.hpp"
+#include "irc/ConnectionTable.hpp"
+#include "irc/SlabPool.hpp"
+#include "irc/BlockPool.hpp"
+#include "irc/Reactor.hpp"
+
+// Work per readiness event before the loop moves on to other fds
+// (the rest is picked up on the next iteration)
+# define SERVER_ACCEPT_BATCH 64       // connections accepted per listening socket event
+# define SERVER_READ_BUDGET  65536    // bytes read from one client per event
+# define SERVER_FLUSH_THRESHOLD 65536 // bytes queued for one client before flushing early
+# define SERVER_SEND_IOVS 16          // chunks in one io_uring sendmsg (see IoUring::prepSend)
+
+// Released input buffers whose storage stays resident for the next partial
+// line; the pages of the others go back to the kernel (see BlockPool)
+# define SERVER_WARM_BUFFERS 64
 
 // Main server class - manages socket, connections, and I/O
 // Coordinates between Poller, Parser, and Command handlers
+//
+// Runs Config::getThreads() Reactors (event loop threads). Threading rules:
+// - A client belongs to the reactor that accepted it (Slot::owner); only
+//   that thread reads/writes its socket and touches its MessageBuffer
+// - connections_, channels and all command handlers are guarded by
+//   stateLock_ (recursive); getClient()/nick lookups need it held.
+//   Input is split and parsed without it, it is taken per handler
+// - sendToClient() to a client of another reactor posts to its mailbox
+// - A client's SendQueue is only used by its owner: the flush phase and
+//   POLLOUT look it up under stateLock_ and write it after releasing it,
+//   a slow socket does not hold up the other reactors
+// With one thread (default) everything runs on the main thread.
 class	Server {
 
 private:
-	int serverSocketFd_;
 	Config config_;
-	Poller* poller_;
+	std::vector<Reactor*> reactors_;        // reactors_[0] runs on the main thread
+	Mutex stateLock_;
 
 	// Client and channel storage
-	std::map<int, Client*> clients_;        // fd -> Client*
-	// std::map<std::string, Channel*> channels_; // channel name -> Channel*
+	ConnectionTable connections_;           // fd -> Client*, buffers, owner (dense)
+	SlabPool<Client> clientPool_;           // objects of connections_ (state lock):
+	SlabPool<MessageBuffer> bufferPool_;    // connect/disconnect storms reuse slots
+	BlockPool bufferBlocks_;                // storage of bufferPool_'s buffers
+	SlabPool<SendQueue> sendQueuePool_;     // instead of going to the allocator
+	NickDirectory nicks_;                   // casefolded nick -> Client* (registered or not)
+	ChannelRegistry channels_;              // casefolded name -> Channel* (pooled)
 
-	std::map<int, MessageBuffer*> buffers_; // fd -> MessageBuffer*
+	// broadcastToPeers(): Slot::fanoutMark is the epoch that fd last got a
+	// copy in. A fan-out takes a new epoch, so nothing is cleared between them
+	unsigned int fanoutEpoch_;
+
+	SendQueue::Stats sendqStats_;           // backpressure counters (state lock)
+
+	// Line -> Command (Reactor::getCommand(), no lock) -> handler (state lock)
+	Parser parser_;                         // stateless, shared by the reactors
+	CommandRegistry registry_;
 
 	// Helper methods
-	void createServerSocket();
-	void bindSocket();
-	void listenSocket();
+	int createServerSocket(bool reusePort);
+	void bindSocket(int fd);
+	void listenSocket(int fd);
 	void setNonBlocking(int fd);
+	void processMessages(int fd, MessageBuffer& input);
+	MessageBuffer* createBuffer();
+	void destroyBuffer(MessageBuffer* buffer);
+	void writeToClient(int fd, const char* data, size_t size,
+						const SharedMessage* shared, SendQueue::Priority priority);
+	void sendBytes(int fd, const char* data, size_t size, SendQueue::Priority priority);
+	void sendQueueExceeded(int fd, SendQueue* queue);
+	ssize_t flushClient(int fd, SendQueue* queue);
+	bool submitClient(int fd, SendQueue* queue);
+
+	// Client liveness timer (Client::getTimer().kind)
+	enum TimerKind {
+		TIMER_REGISTRATION,     // PASS/NICK/USER not done by the deadline: drop
+		TIMER_KEEPALIVE,        // silent for the ping interval: PING
+		TIMER_PONG              // nothing since the PING: "Ping timeout"
+	};
+	void startTimer(ConnectionTable::Slot& slot, unsigned long long now);
+	void handleTimer(ConnectionTable::Slot& slot, TimerWheel& timers, unsigned long long now);
+	void closeLink(Client& client, const std::string& reason);
+	void updateClientEvents(int fd, SendQueue* queue);
 
 public:
 	// Constructor: initialize server with configuration
@@ -43,36 +113,117 @@ public:
 	// Main server loop (calls Poller::poll())
 	void run();
 
-	// Handle new client connection (called by Poller)
+	// Handle new client connections (called by Poller)
+	// Accepts until EAGAIN, at most SERVER_ACCEPT_BATCH per call
 	void handleNewConnection();
 
+	// Register an already accepted, non-blocking client socket
+	// (called by handleNewConnection, or by Poller for io_uring multishot accept)
+	void acceptConnection(int clientFd);
+
 	// Handle incoming data from client (called by Poller)
+	// Reads until EAGAIN or a short read, at most SERVER_READ_BUDGET bytes
 	void handleClientInput(int clientFd);
 
+	// Feed received bytes into the client's MessageBuffer and run complete messages
+	// (called by handleClientInput, or by Poller for io_uring recv completions)
+	void handleClientData(int clientFd, const char* data, size_t length);
+
+	// Socket writable again (POLLOUT, called by Poller): drain its SendQueue
+	void handleClientOutput(int clientFd);
+
+	// Flush phase at the end of a reactor loop iteration (called by Reactor):
+	// one writev() per client written to during the iteration, outside the
+	// state lock. clients is reused as scratch (Reactor clears it afterwards)
+	// viaRing: uring backend, queue one sendmsg per client instead, they all
+	// go to the kernel with the next poll() (nothing may run before it)
+	void flushOutput(std::vector<Reactor::Flush>& clients, bool viaRing);
+
+	// Result of a flushOutput() sendmsg (called by Poller, uring only):
+	// bytes sent or -errno
+	void handleSendComplete(int clientFd, int result);
+
+	// Due client timers of the calling reactor (called by Reactor)
+	void handleTimers(const std::vector<TimerWheel::Timer*>& fired);
+
 	// Handle client disconnection
 	void disconnectClient(int clientFd);
 
 	// Send data to a specific client (PRIMARY METHOD - see TEAM_CONVENTIONS.md)
-	void sendToClient(int clientFd, const std::string& message);
-
-	// Convenience method for sending formatted IRC response
-	void sendResponse(int clientFd, const std::string& numeric,
-						const std::string& params, const std::string& trailing);
+	// Caller holds the state lock (true for every command handler)
+	// PRIORITY_LOW messages may be dropped for a client over its sendq soft limit
+	void sendToClient(int clientFd, const std::string& message,
+						SendQueue::Priority priority = SendQueue::PRIORITY_NORMAL);
+
+	// Same for a message formatted once for many recipients (Channel::broadcast):
+	// queued by reference, no per-recipient copy
+	void sendToClient(int clientFd, const SharedMessage& message,
+						SendQueue::Priority priority = SendQueue::PRIORITY_NORMAL);
+
+	// Same for a line built in place: sent straight from the builder, only
+	// what the socket does not take right away is copied
+	void sendToClient(int clientFd, const ReplyBuilder& reply,
+						SendQueue::Priority priority = SendQueue::PRIORITY_NORMAL);
+
+	// Write to a socket owned by the calling reactor (sendToClient / Reactor mailbox)
+	// Queued, written by the flush phase at the end of the loop iteration
+	// Applies the sendq limits from Config (soft: drop / pause reading, hard: disconnect)
+	void writeToClient(int clientFd, const SharedMessage& message,
+						SendQueue::Priority priority = SendQueue::PRIORITY_NORMAL);
 
 	// Broadcast message to all clients in a channel
 	// void broadcastToChannel(const std::string& channelName, const std::string& message, int excludeFd = -1);
 
+	// QUIT / NICK: message once to everyone sharing a channel with client,
+	// however many channels they share (client itself excluded)
+	// Deduplicated by an epoch mark per fd: no allocation, no set
+	void broadcastToPeers(Client& client, const SharedMessage& message,
+						SendQueue::Priority priority = SendQueue::PRIORITY_NORMAL);
+
 	// Client management
 	Client* getClient(int fd);
-	// Client* getClientByNickname(const std::string& nickname);
+	// Case-insensitive (RFC 1459), O(1) through the nick directory
+	Client* getClientByNickname(const std::string& nickname);
+	Client* getClientByNickname(const Identifier& nickname);
+	// Give client this nickname, taken and released in the same step
+	// (directory and Client together); false, nothing changed, if another
+	// client has it
+	bool setClientNickname(Client& client, const std::string& nickname);
+
+	// Channel management (case-insensitive, O(1) through the channel registry)
+	Channel* getChannel(const std::string& name);
+	Channel* getChannel(const Identifier& name);
+	// Existing channel or a new one (from the registry's pool)
+	Channel* createChannel(const std::string& name);
+	// Unregister and destroy the channel (callers check it is empty)
+	void removeChannel(const std::string& name);
+	// Client leaves channel (both sides); the last one out reclaims it
+	void partChannel(Client& client, Channel* channel);
+
+	// Connection password from Config (PASS)
+	const std::string& getPassword() const;
 	// void addClient(int fd);
 	// void removeClient(int fd);
 
-	// SIGINT for Ctrl+C
+	// SIGINT for Ctrl+C (cleared by the handler, polled by every reactor: __atomic_*)
 	static volatile	sig_atomic_t running_;
+	// Listening socket / Poller / wake socket of the calling thread's reactor
 	int getServerFd() const;
-	Poller* getPoller() const { return poller_; }
+	Poller* getPoller() const;
+	int getWakeFd() const;
+	void handleWakeup();
 	MessageBuffer* getBuffer(int fd);
+	SendQueue* getSendQueue(int fd);
+
+	// Backpressure counters (copy taken under the state lock)
+	SendQueue::Stats getSendQStats();
+
+	// Threading (see class comment)
+	Mutex& getStateLock();
+	Reactor* getOwner(int fd);
+	// NULL also if that connection is gone (fd closed or reused since)
+	Reactor* getOwner(const ConnectionTable::Handle& client);
+	ConnectionTable::Handle getHandle(int fd);
 };
 
 #endif
@@ -0,0 +1,48 @@
+#ifndef SHAREDMESSAGE_HPP
+#define SHAREDMESSAGE_HPP
+
+#include <string>
+#include <cstddef>
+
+// SharedMessage class - immutable, reference counted wire message
+// A broadcast is formatted once into one block, every recipient's
+// SendQueue (or Reactor mailbox) keeps a reference to that block instead
+// of a copy. The block is freed when the last queue has flushed it.
+//
+// Copying a SharedMessage only bumps the reference count (atomically:
+// queues of different reactors share blocks). The bytes never change
+// after construction, so they can be read without locking.
+class SharedMessage {
+public:
+    // Empty message (no block)
+    SharedMessage();
+
+    // Copy data into a new block
+    explicit SharedMessage(const std::string& data);
+    SharedMessage(const char* data, size_t size);
+
+    SharedMessage(const SharedMessage& other);
+    SharedMessage& operator=(const SharedMessage& other);
+    ~SharedMessage();
+
+    const char* data() const;
+    size_t size() const;
+    bool empty() const;
+
+    // Number of SharedMessage handles on the block (0 for empty, for tests/stats)
+    int useCount() const;
+
+private:
+    // Header and bytes in one allocation
+    struct Block {
+        int refs;
+        size_t size;
+        char data[1];
+    };
+
+    Block* block_;
+
+    void release();
+};
+
+#endif // SHAREDMESSAGE_HPP
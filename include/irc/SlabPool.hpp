@@ -0,0 +1,123 @@
+#ifndef SLABPOOL_HPP
+#define SLABPOOL_HPP
+
+#include <vector>
+#include <cstddef>
+#include <new>
+
+// SlabPool - fixed-size object pool for objects created and dropped often
+// Objects live in slabs of SlabSize slots, allocated on demand and kept
+// until the pool goes away; a destroyed object's slot goes on a free list
+// and the next create() reuses it. Once the pool has grown to the peak
+// number of live objects, create()/destroy() never touch the heap (the
+// object's own members may still allocate).
+//
+//   SlabPool<Channel> pool;
+//   Channel* channel = pool.create(name);   // placement new in a free slot
+//   pool.destroy(channel);                  // ~Channel(), slot reused
+//
+// Not thread-safe (each owner uses it under its own lock). Objects still
+// alive when the pool is destroyed are not destructed: release them first.
+template <typename T, size_t SlabSize = 64>
+class SlabPool {
+public:
+    SlabPool() : free_(NULL), live_(0), peak_(0) {}
+
+    ~SlabPool() {
+        for (size_t i = 0; i < slabs_.size(); ++i) {
+            ::operator delete(slabs_[i]);
+        }
+    }
+
+    T* create() {
+        Slot* slot = acquire();
+        try {
+            return new (slot->storage) T();
+        } catch (...) {
+            release(slot);
+            throw;
+        }
+    }
+
+    template <typename Arg>
+    T* create(const Arg& arg) {
+        Slot* slot = acquire();
+        try {
+            return new (slot->storage) T(arg);
+        } catch (...) {
+            release(slot);
+            throw;
+        }
+    }
+
+    template <typename Arg1, typename Arg2>
+    T* create(const Arg1& arg1, const Arg2& arg2) {
+        Slot* slot = acquire();
+        try {
+            return new (slot->storage) T(arg1, arg2);
+        } catch (...) {
+            release(slot);
+            throw;
+        }
+    }
+
+    void destroy(T* object) {
+        if (!object) return;
+        object->~T();
+        release(reinterpret_cast<Slot*>(object));
+    }
+
+    size_t live() const { return live_; }                       // objects in use
+    size_t peak() const { return peak_; }                       // high-water mark of live()
+    size_t capacity() const { return slabs_.size() * SlabSize; } // slots allocated
+    size_t slabs() const { return slabs_.size(); }
+
+private:
+    // Storage of one object, or the free list link while unused
+    // (the other members only force an alignment good for any T)
+    union Slot {
+        Slot* next;
+        char storage[sizeof(T)];
+        long double alignDouble;
+        long alignLong;
+        void* alignPointer;
+    };
+
+    Slot* acquire() {
+        if (!free_) {
+            grow();
+        }
+        Slot* slot = free_;
+        free_ = slot->next;
+        if (++live_ > peak_) peak_ = live_;
+        return slot;
+    }
+
+    void release(Slot* slot) {
+        slot->next = free_;
+        free_ = slot;
+        --live_;
+    }
+
+    void grow() {
+        slabs_.push_back(NULL);     // first: a failed push_back leaks nothing
+        Slot* slab = static_cast<Slot*>(::operator new(sizeof(Slot) * SlabSize));
+        slabs_.back() = slab;
+        // Lowest address first out
+        for (size_t i = SlabSize; i > 0; --i) {
+            slab[i - 1].next = free_;
+            free_ = &slab[i - 1];
+        }
+    }
+
+    std::vector<Slot*> slabs_;
+    Slot* free_;
+    size_t live_;
+    size_t peak_;
+
+    // Not copyable
+    SlabPool(const SlabPool&);
+    SlabPool& operator=(const SlabPool&);
+};
+
+#endif // SLABPOOL_HPP
@@ -0,0 +1,74 @@
+#ifndef TIMERWHEEL_HPP
+#define TIMERWHEEL_HPP
+
+#include <vector>
+#include <cstddef>
+
+// TimerWheel - hashed timer wheel, one per Reactor (owner thread only)
+// Deadlines are monotonic milliseconds. A timer lives in the slot of its
+// tick (deadline rounded up to TICK_MS); timers more than one revolution
+// away share the slot and are skipped until their round comes.
+//
+//   schedule()  O(1): (re)link into the slot of the new deadline
+//   cancel()    O(1): unlink
+//   expire()    visits only the slots whose ticks have passed
+//
+// Timer nodes are embedded in their owner (Client), nothing is allocated.
+// Rearming on every message would still be a relink: callers that see a
+// lot of traffic only record the time and move the deadline when the
+// timer fires (see Server::handleTimer()).
+class TimerWheel {
+public:
+    enum {
+        TICK_MS = 250,
+        SLOTS = 1024        // power of two, one revolution = 256 s
+    };
+
+    struct Timer {
+        Timer* prev;
+        Timer* next;
+        unsigned long long deadline;    // ms, valid while scheduled
+        unsigned long long tick;
+        bool scheduled;
+
+        int fd;         // owner's data: whose timer
+        int kind;       // owner's data: what it is waiting for
+
+        Timer() : prev(NULL), next(NULL), deadline(0), tick(0), scheduled(false)
+                , fd(-1), kind(0) {}
+    };
+
+    TimerWheel();
+
+    // Arm for deadline (ms), moving it if it was armed already
+    void schedule(Timer* timer, unsigned long long deadline);
+    void cancel(Timer* timer);
+
+    // Unlink every timer whose deadline is <= now and append it to fired
+    // (the caller keeps the vector, so no allocation once it has grown)
+    void expire(unsigned long long now, std::vector<Timer*>& fired);
+
+    // Poll timeout: ms until the next slot with timers, at most maxMs
+    // (0 if one is due; may be early for a timer of a later round)
+    int timeoutMs(unsigned long long now, int maxMs);
+
+    size_t size() const;
+
+    // Monotonic clock in ms
+    static unsigned long long now();
+
+private:
+    std::vector<Timer*> slots_;
+    unsigned long long current_;    // first tick not expired yet
+    unsigned long long nextTick_;   // no timer before this tick (lower bound)
+    size_t count_;
+
+    void link(Timer* timer);
+    void unlink(Timer* timer);
+
+    // Not copyable (slots point into the owners' timers)
+    TimerWheel(const TimerWheel&);
+    TimerWheel& operator=(const TimerWheel&);
+};
+
+#endif // TIMERWHEEL_HPP
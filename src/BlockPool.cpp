@@ -0,0 +1,99 @@
+// BlockPool implementation
+// Slabs straight from mmap(): page aligned and outside the malloc heap,
+// so the pages of a free block can be given back on their own
+
+#include "irc/BlockPool.hpp"
+#include <new>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// Linux frees at once (RSS drops now); elsewhere MADV_FREE, the kernel
+// takes the pages when it needs them
+#if defined(__LINUX__) || !defined(MADV_FREE)
+# define BLOCKPOOL_DISCARD MADV_DONTNEED
+#else
+# define BLOCKPOOL_DISCARD MADV_FREE
+#endif
+
+BlockPool::BlockPool(size_t blockSize, size_t blocksPerSlab, size_t warmBlocks)
+    : blockSize_(blockSize > 0 ? blockSize : 1)
+    , blocksPerSlab_(blocksPerSlab > 0 ? blocksPerSlab : 1)
+    , warmBlocks_(warmBlocks)
+    , pageSize_(static_cast<size_t>(sysconf(_SC_PAGESIZE)))
+    , live_(0), peak_(0) {}
+
+BlockPool::~BlockPool() {
+    for (size_t i = 0; i < slabs_.size(); ++i) {
+        munmap(slabs_[i], blockSize_ * blocksPerSlab_);
+    }
+}
+
+char* BlockPool::acquire() {
+    std::vector<char*>* list = !warm_.empty() ? &warm_ : &cold_;
+    if (list->empty()) {
+        grow();
+    }
+    char* block = list->back();
+    list->pop_back();
+    if (++live_ > peak_) peak_ = live_;
+    return block;
+}
+
+// Capacity of both lists reserved by grow(): no allocation
+void BlockPool::release(char* block) {
+    if (!block) return;
+    --live_;
+    if (warm_.size() < warmBlocks_) {
+        warm_.push_back(block);
+        return;
+    }
+    discard(block);
+    cold_.push_back(block);
+}
+
+// Whole pages inside the block only (blocks need not be page multiples)
+void BlockPool::discard(char* block) {
+    size_t begin = reinterpret_cast<size_t>(block);
+    size_t end = begin + blockSize_;
+    begin = (begin + pageSize_ - 1) & ~(pageSize_ - 1);
+    end &= ~(pageSize_ - 1);
+    if (begin < end) {
+        madvise(reinterpret_cast<void*>(begin), end - begin, BLOCKPOOL_DISCARD);
+    }
+}
+
+// One more slab; its blocks are cold until used (lowest address out first)
+void BlockPool::grow() {
+    slabs_.reserve(slabs_.size() + 1);
+    warm_.reserve(capacity() + blocksPerSlab_);
+    cold_.reserve(capacity() + blocksPerSlab_);
+    void* slab = mmap(NULL, blockSize_ * blocksPerSlab_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (slab == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    slabs_.push_back(static_cast<char*>(slab));
+    for (size_t i = blocksPerSlab_; i > 0; --i) {
+        cold_.push_back(static_cast<char*>(slab) + (i - 1) * blockSize_);
+    }
+}
+
+size_t BlockPool::blockSize() const {
+    return blockSize_;
+}
+
+size_t BlockPool::live() const {
+    return live_;
+}
+
+size_t BlockPool::peak() const {
+    return peak_;
+}
+
+size_t BlockPool::capacity() const {
+    return slabs_.size() * blocksPerSlab_;
+}
+
+size_t BlockPool::warm() const {
+    return warm_.size();
+}
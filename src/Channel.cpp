@@ -23,9 +23,11 @@
 
 // Constructor: initialize with channel name
 Channel::Channel(const std::string& name)
-    : name_(Utils::toLower(name))
+    : name_(name)
     , nameDisplay_(name)
     , topicTime_(0)
+    , membersHead_(NULL)
+    , membersTail_(NULL)
     , inviteOnly_(false)
     , topicProtected_(false)
     , userLimit_(0)
@@ -34,8 +36,11 @@ Channel::Channel(const std::string& name)
 
 // Destructor
 Channel::~Channel() {
-    // Cleanup - clients are not owned by Channel, just references
-    // No need to delete Client pointers
+    // Clients are not owned by Channel, just references
+    // Drop the memberships still left so no client points back here
+    while (membersHead_) {
+        removeMembership(membersHead_);
+    }
 }
 
 // ============================================================================
@@ -43,52 +48,111 @@ Channel::~Channel() {
 // ============================================================================
 
 const std::string& Channel::getName() const {
-    return name_;  // lowercase for comparison
+    return name_.str();  // casefolded for comparison
 }
 
 const std::string& Channel::getNameDisplay() const {
     return nameDisplay_;  // original case for display
 }
 
+const Identifier& Channel::getId() const {
+    return name_;
+}
+
 // ============================================================================
 // Membership management
 // ============================================================================
 
 bool Channel::hasClient(Client* client) const {
-    return clients_.find(client->getFd()) != clients_.end();
+    return memberIndex_.find(client) != NULL;
 }
 
-void Channel::addClient(Client* client) {
-    clients_[client->getFd()] = client;
+// New member: one node, appended to this channel's list and the client's
+Membership* Channel::addClient(Client* client) {
+    Membership* membership = memberIndex_.find(client);
+    if (membership) {
+        return membership;
+    }
+    membership = Membership::create(client, this);
+    
+    membership->prevInChannel = membersTail_;
+    if (membersTail_) {
+        membersTail_->nextInChannel = membership;
+    } else {
+        membersHead_ = membership;
+    }
+    membersTail_ = membership;
+    
+    memberIndex_.insert(membership);
+    client->linkMembership(membership);
+    
+    membership->fanoutSlot = fanout_.size();
+    fanout_.push_back(client->getFd());
+    fanoutOwners_.push_back(membership);
+    return membership;
 }
 
 void Channel::removeClient(Client* client) {
-    int fd = client->getFd();
-    clients_.erase(fd);
-    
-    // Also remove from operators if present
-    std::vector<Client*>::iterator it = 
-        std::find(operators_.begin(), operators_.end(), client);
-    if (it != operators_.end()) {
-        operators_.erase(it);
+    Membership* membership = memberIndex_.find(client);
+    if (membership) {
+        removeMembership(membership);
     }
 }
 
+// Unlink from both sides (operator status goes with the node)
+void Channel::removeMembership(Membership* membership) {
+    if (membership->prevInChannel) {
+        membership->prevInChannel->nextInChannel = membership->nextInChannel;
+    } else {
+        membersHead_ = membership->nextInChannel;
+    }
+    if (membership->nextInChannel) {
+        membership->nextInChannel->prevInChannel = membership->prevInChannel;
+    } else {
+        membersTail_ = membership->prevInChannel;
+    }
+    
+    // Fan-out: last entry fills the hole
+    size_t slot = membership->fanoutSlot;
+    Membership* last = fanoutOwners_.back();
+    fanout_[slot] = fanout_.back();
+    fanoutOwners_[slot] = last;
+    last->fanoutSlot = slot;
+    fanout_.pop_back();
+    fanoutOwners_.pop_back();
+    
+    memberIndex_.remove(membership->client);
+    membership->client->unlinkMembership(membership);
+    Membership::destroy(membership);
+}
+
+Membership* Channel::getMembership(const Client* client) const {
+    return memberIndex_.find(client);
+}
+
+Membership* Channel::getMembers() const {
+    return membersHead_;
+}
+
+const std::vector<int>& Channel::getFanout() const {
+    return fanout_;
+}
+
 std::vector<Client*> Channel::getClients() const {
     std::vector<Client*> result;
-    for (std::map<int, Client*>::const_iterator it = clients_.begin();
-         it != clients_.end(); ++it) {
-        result.push_back(it->second);
+    result.reserve(memberIndex_.size());
+    for (Membership* m = membersHead_; m; m = m->nextInChannel) {
+        result.push_back(m->client);
     }
     return result;
 }
 
 size_t Channel::getClientCount() const {
-    return clients_.size();
+    return memberIndex_.size();
 }
 
 bool Channel::isEmpty() const {
-    return clients_.empty();
+    return membersHead_ == NULL;
 }
 
 // ============================================================================
@@ -96,45 +160,70 @@ bool Channel::isEmpty() const {
 // ============================================================================
 
 bool Channel::isOperator(Client* client) const {
-    return std::find(operators_.begin(), operators_.end(), client) 
-           != operators_.end();
+    Membership* membership = memberIndex_.find(client);
+    return membership && membership->hasFlag(Membership::FLAG_OPERATOR);
 }
 
+// Members only: operator status is a flag on the membership
 void Channel::addOperator(Client* client) {
-    if (!isOperator(client)) {
-        operators_.push_back(client);
+    Membership* membership = memberIndex_.find(client);
+    if (membership) {
+        membership->setFlag(Membership::FLAG_OPERATOR, true);
     }
 }
 
 void Channel::removeOperator(Client* client) {
-    std::vector<Client*>::iterator it = 
-        std::find(operators_.begin(), operators_.end(), client);
-    if (it != operators_.end()) {
-        operators_.erase(it);
+    Membership* membership = memberIndex_.find(client);
+    if (membership) {
+        membership->setFlag(Membership::FLAG_OPERATOR, false);
     }
 }
 
 std::vector<Client*> Channel::getOperators() const {
-    return operators_;
+    std::vector<Client*> result;
+    for (Membership* m = membersHead_; m; m = m->nextInChannel) {
+        if (m->hasFlag(Membership::FLAG_OPERATOR)) {
+            result.push_back(m->client);
+        }
+    }
+    return result;
 }
 
 // ============================================================================
 // Invite list management (case-insensitive)
 // ============================================================================
 
+bool Channel::isInvited(const Identifier& nickname) const {
+    return !nickname.empty() &&
+           std::find(inviteList_.begin(), inviteList_.end(), nickname) != inviteList_.end();
+}
+
+void Channel::addToInviteList(const Identifier& nickname) {
+    if (!nickname.empty() && !isInvited(nickname)) {
+        inviteList_.push_back(nickname);
+    }
+}
+
+void Channel::removeFromInviteList(const Identifier& nickname) {
+    std::vector<Identifier>::iterator it =
+        std::find(inviteList_.begin(), inviteList_.end(), nickname);
+    if (it != inviteList_.end()) {
+        inviteList_.erase(it);
+    }
+}
+
+// By name: an invited nick is interned (the list holds it), so a name
+// that is not in the table cannot be on the list
 bool Channel::isInvited(const std::string& nickname) const {
-    std::string lower = Utils::toLower(nickname);
-    return inviteList_.find(lower) != inviteList_.end();
+    return isInvited(Identifier::find(nickname));
 }
 
 void Channel::addToInviteList(const std::string& nickname) {
-    std::string lower = Utils::toLower(nickname);
-    inviteList_.insert(lower);
+    addToInviteList(Identifier(nickname));
 }
 
 void Channel::removeFromInviteList(const std::string& nickname) {
-    std::string lower = Utils::toLower(nickname);
-    inviteList_.erase(lower);
+    removeFromInviteList(Identifier::find(nickname));
 }
 
 // ============================================================================
@@ -224,11 +313,29 @@ void Channel::setUserLimit(int limit) {
 // Broadcast message to all members except exclude
 // Signature from TEAM_CONVENTIONS.md section 12
 void Channel::broadcast(Server* server, const std::string& message, 
-                        Client* exclude) {
-    for (std::map<int, Client*>::iterator it = clients_.begin();
-         it != clients_.end(); ++it) {
-        if (it->second != exclude) {
-            server->sendToClient(it->first, message);
+                        Client* exclude, SendQueue::Priority priority) {
+    broadcast(server, SharedMessage(message), exclude, priority);
+}
+
+// One block for all members: each recipient costs a reference, not a copy
+// Reads the packed fan-out array; the excluded member is found once through
+// the index and its slot skipped, no per-member compare
+void Channel::broadcast(Server* server, const SharedMessage& message,
+                        Client* exclude, SendQueue::Priority priority) {
+    const size_t count = fanout_.size();
+    size_t skip = count;
+    if (exclude) {
+        Membership* excluded = memberIndex_.find(exclude);
+        if (excluded) {
+            skip = excluded->fanoutSlot;
         }
     }
+    
+    const int* fds = count ? &fanout_[0] : NULL;
+    for (size_t i = 0; i < skip; ++i) {
+        server->sendToClient(fds[i], message, priority);
+    }
+    for (size_t i = skip + 1; i < count; ++i) {
+        server->sendToClient(fds[i], message, priority);
+    }
 }
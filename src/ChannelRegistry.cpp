@@ -0,0 +1,52 @@
+// ChannelRegistry implementation
+// IdentifierMap for lookups, SlabPool for the Channel objects
+
+#include "irc/ChannelRegistry.hpp"
+#include "irc/Channel.hpp"
+#include <vector>
+
+ChannelRegistry::ChannelRegistry() {}
+
+ChannelRegistry::~ChannelRegistry() {
+    clear();
+}
+
+void ChannelRegistry::clear() {
+    std::vector<Channel*> channels;
+    channels_.values(channels);
+    for (size_t i = 0; i < channels.size(); ++i) {
+        remove(channels[i]);
+    }
+}
+
+Channel* ChannelRegistry::find(const Identifier& name) const {
+    return channels_.find(name);
+}
+
+Channel* ChannelRegistry::find(const std::string& name) const {
+    return channels_.find(Identifier::find(name));
+}
+
+Channel* ChannelRegistry::create(const std::string& name) {
+    Channel* channel = find(name);
+    if (channel) return channel;
+
+    channel = pool_.create(name);
+    channels_.insert(channel->getId(), channel);
+    return channel;
+}
+
+void ChannelRegistry::remove(Channel* channel) {
+    if (!channel || channels_.find(channel->getId()) != channel) return;
+
+    channels_.remove(channel->getId());
+    pool_.destroy(channel);
+}
+
+size_t ChannelRegistry::size() const {
+    return channels_.size();
+}
+
+const SlabPool<Channel, 32>& ChannelRegistry::getPool() const {
+    return pool_;
+}
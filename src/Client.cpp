@@ -15,8 +15,7 @@
 // Follows TEAM_CONVENTIONS.md for Halloy compatibility
 
 #include "irc/Client.hpp"
-#include "irc/Utils.hpp"
-//#include <algorithm>
+#include "irc/Membership.hpp"
 //#include <sys/socket.h>
 //#include <netinet/in.h>
 //#include <arpa/inet.h>
@@ -27,13 +26,20 @@ Client::Client(int fd)
     , hostname_("unknown")
     , registrationStep_(0)
     , passwordAttempts_(0)
+    , membershipsHead_(NULL)
+    , membershipsTail_(NULL)
+    , channelCount_(0)
 {
+    timer_.fd = fd;
+    rebuildPrefix();
 }
 
 // Destructor
 Client::~Client() {
     // Cleanup if needed
     // Buffer cleanup handled automatically by std::string destructor
+    // Memberships must be gone already: Server::disconnectClient() parts
+    // every channel before deleting the client
 }
 
 // ============================================================================
@@ -48,8 +54,12 @@ int Client::getFd() const {
 // Identity getters
 // ============================================================================
 
-// Returns LOWERCASE nickname for comparison
+// Returns CASEFOLDED nickname for comparison
 const std::string& Client::getNickname() const {
+    return nickname_.str();
+}
+
+const Identifier& Client::getNickId() const {
     return nickname_;
 }
 
@@ -75,19 +85,22 @@ const std::string& Client::getRealname() const {
 // ============================================================================
 
 // Set nickname with case handling (Halloy requirement)
-// Stores both lowercase (for comparison) and original (for display)
+// Stores both casefolded (for comparison) and original (for display)
 void Client::setNickname(const std::string& nickname) {
     nicknameDisplay_ = nickname;              // "BOB" - original for display
-    nickname_ = Utils::toLower(nickname);     // "bob" - lowercase for comparison
+    nickname_ = Identifier(nickname);         // "bob" - interned, for comparison
+    rebuildPrefix();
 }
 
 void Client::setUsername(const std::string& username, const std::string& realname) {
     username_ = username;
     realname_ = realname;
+    rebuildPrefix();
 }
 
 void Client::setHostname(const std::string& hostname) {
     hostname_ = hostname;
+    rebuildPrefix();
 }
 
 // ============================================================================
@@ -154,30 +167,49 @@ bool Client::hasExceededPasswordAttempts() const {
 // Channel membership
 // ============================================================================
 
-void Client::addChannel(const std::string& channelName) {
-    // Store lowercase for case-insensitive comparison
-    std::string lower = Utils::toLower(channelName);
-    if (!isInChannel(lower)) {
-        channels_.push_back(lower);
-    }
+Membership* Client::getMemberships() const {
+    return membershipsHead_;
+}
+
+size_t Client::getChannelCount() const {
+    return channelCount_;
 }
 
-void Client::removeChannel(const std::string& channelName) {
-    std::string lower = Utils::toLower(channelName);
-    std::vector<std::string>::iterator it = 
-        std::find(channels_.begin(), channels_.end(), lower);
-    if (it != channels_.end()) {
-        channels_.erase(it);
+// Appended: the client's channels stay in join order
+void Client::linkMembership(Membership* membership) {
+    membership->prevInClient = membershipsTail_;
+    membership->nextInClient = NULL;
+    if (membershipsTail_) {
+        membershipsTail_->nextInClient = membership;
+    } else {
+        membershipsHead_ = membership;
     }
+    membershipsTail_ = membership;
+    ++channelCount_;
 }
 
-const std::vector<std::string>& Client::getChannels() const {
-    return channels_;
+void Client::unlinkMembership(Membership* membership) {
+    if (membership->prevInClient) {
+        membership->prevInClient->nextInClient = membership->nextInClient;
+    } else {
+        membershipsHead_ = membership->nextInClient;
+    }
+    if (membership->nextInClient) {
+        membership->nextInClient->prevInClient = membership->prevInClient;
+    } else {
+        membershipsTail_ = membership->prevInClient;
+    }
+    membership->prevInClient = NULL;
+    membership->nextInClient = NULL;
+    --channelCount_;
 }
 
-bool Client::isInChannel(const std::string& channelName) const {
-    std::string lower = Utils::toLower(channelName);
-    return std::find(channels_.begin(), channels_.end(), lower) != channels_.end();
+// ============================================================================
+// Liveness
+// ============================================================================
+
+TimerWheel::Timer& Client::getTimer() {
+    return timer_;
 }
 
 // ============================================================================
@@ -185,6 +217,19 @@ bool Client::isInChannel(const std::string& channelName) const {
 // ============================================================================
 
 // Format: "nick!user@host" (uses display nickname for Halloy compatibility)
-std::string Client::getPrefix() const {
-    return nicknameDisplay_ + "!" + username_ + "@" + hostname_;
+// Returned by reference: handlers read it for every PRIVMSG/JOIN/MODE/...
+const std::string& Client::getPrefix() const {
+    return prefix_;
+}
+
+// Identity changes are rare (NICK, USER, connect), so the prefix is built
+// here once and reused (prefix_ keeps its capacity across rebuilds)
+void Client::rebuildPrefix() {
+    prefix_.clear();
+    prefix_.reserve(nicknameDisplay_.size() + username_.size() + hostname_.size() + 2);
+    prefix_ += nicknameDisplay_;
+    prefix_ += '!';
+    prefix_ += username_;
+    prefix_ += '@';
+    prefix_ += hostname_;
 }
@@ -0,0 +1,68 @@
+// Command ids
+// Verb <-> CommandId for the 13 commands CommandRegistry dispatches
+
+#include "irc/Command.hpp"
+#include <cstring>
+
+// Indexed by CommandId
+static const char* const commandNames[CMD_COUNT] = {
+    "",
+    "PASS",
+    "NICK",
+    "USER",
+    "JOIN",
+    "PART",
+    "PRIVMSG",
+    "INVITE",
+    "KICK",
+    "TOPIC",
+    "MODE",
+    "QUIT",
+    "PING",
+    "PONG"
+};
+
+// Length and first byte leave at most three candidates; the memcmp
+// confirms the one picked (an unknown verb costs the same as a known one)
+CommandId commandIdFromName(const char* name, size_t length) {
+    CommandId id = CMD_UNKNOWN;
+    switch (length) {
+        case 4:
+            switch (name[0]) {
+                case 'J': id = CMD_JOIN; break;
+                case 'K': id = CMD_KICK; break;
+                case 'M': id = CMD_MODE; break;
+                case 'N': id = CMD_NICK; break;
+                case 'Q': id = CMD_QUIT; break;
+                case 'U': id = CMD_USER; break;
+                case 'P':
+                    switch (name[1]) {
+                        case 'A': id = (name[2] == 'S') ? CMD_PASS : CMD_PART; break;
+                        case 'I': id = CMD_PING; break;
+                        case 'O': id = CMD_PONG; break;
+                    }
+                    break;
+            }
+            break;
+        case 5:
+            if (name[0] == 'T') id = CMD_TOPIC;
+            break;
+        case 6:
+            if (name[0] == 'I') id = CMD_INVITE;
+            break;
+        case 7:
+            if (name[0] == 'P') id = CMD_PRIVMSG;
+            break;
+    }
+    if (id != CMD_UNKNOWN && std::memcmp(name, commandNames[id], length) != 0) {
+        return CMD_UNKNOWN;
+    }
+    return id;
+}
+
+const char* commandName(CommandId id) {
+    if (id < CMD_UNKNOWN || id >= CMD_COUNT) {
+        return "";
+    }
+    return commandNames[id];
+}
@@ -15,6 +15,7 @@
 #include "irc/Client.hpp"
 #include "irc/Command.hpp"
 #include "irc/Replies.hpp"
+#include "irc/Logger.hpp"
 #include "irc/commands/Pass.hpp"
 #include "irc/commands/Nick.hpp"
 #include "irc/commands/User.hpp"
@@ -32,6 +33,11 @@
 
 // Constructor
 CommandRegistry::CommandRegistry() {
+    for (int i = 0; i < CMD_COUNT; ++i)
+    {
+        handlers_[i] = NULL;
+        counts_[i] = 0;
+    }
     initializeHandlers();
 }
 
@@ -39,9 +45,9 @@ CommandRegistry::CommandRegistry() {
 CommandRegistry::~CommandRegistry() {}
 
 // Method - execute()
-// - Convert command.command to uppercase
-// - Look up handler in handlers_ map
-// - If found, call handler(server, client, cmd)
+// - cmd.id comes from the Parser; a Command built by hand (id not set)
+//   is looked up by name once here
+// - If a handler is registered for the id, call handler(server, client, cmd)
 // - If not found, send ERR_UNKNOWNCOMMAND
 // - Return true if executed, false if not found
 bool CommandRegistry::execute(Server& server, Client& client, const Command& cmd)
@@ -49,14 +55,14 @@ bool CommandRegistry::execute(Server& server, Client& client, const Command& cmd
     if (cmd.command.empty())
         return false;
 
-    std::string upperCmd = cmd.command;
-    for (size_t i = 0; i < upperCmd.length(); ++i)
-        upperCmd[i] = std::toupper(upperCmd[i]);
+    CommandId id = cmd.id;
+    if (id == CMD_UNKNOWN)
+        id = lookup(cmd.command);
 
-    std::map<std::string, CommandHandler>::iterator it = handlers_.find(upperCmd);
-    if (it != handlers_.end())
+    ++counts_[handlers_[id] ? id : CMD_UNKNOWN];
+    if (handlers_[id])
 	{
-        it->second(server, client, cmd);
+        handlers_[id](server, client, cmd);
         return true;
     }
 
@@ -75,44 +81,69 @@ bool CommandRegistry::execute(Server& server, Client& client, const Command& cmd
 }
 
 // Method - registerCommand()
-// - Convert command to uppercase
-// - Store in handlers_ map
+// - Store handler at its id (CMD_UNKNOWN never gets one)
+void CommandRegistry::registerCommand(CommandId id, CommandHandler handler)
+{
+    if (id <= CMD_UNKNOWN || id >= CMD_COUNT)
+        return;
+    handlers_[id] = handler;
+}
+
 void CommandRegistry::registerCommand(const std::string& command, CommandHandler handler)
 {
-    std::string upperCmd = command;
-    for (size_t i = 0; i < upperCmd.length(); ++i)
-        upperCmd[i] = std::toupper(upperCmd[i]);
-    handlers_[upperCmd] = handler;
+    CommandId id = lookup(command);
+    if (id == CMD_UNKNOWN)
+    {
+        IRC_LOG_WARN("CommandRegistry", LogFields(), "No CommandId for \"" << command
+                  << "\", handler not registered");
+        return;
+    }
+    registerCommand(id, handler);
 }
 
 // Method - hasCommand()
-// - Convert to uppercase
-// - Check if exists in handlers_ map
+bool CommandRegistry::hasCommand(CommandId id) const
+{
+    return id > CMD_UNKNOWN && id < CMD_COUNT && handlers_[id] != NULL;
+}
+
 bool CommandRegistry::hasCommand(const std::string& command) const
+{
+    return hasCommand(lookup(command));
+}
+
+// Method - getCount()
+unsigned long CommandRegistry::getCount(CommandId id) const
+{
+    if (id < CMD_UNKNOWN || id >= CMD_COUNT)
+        return 0;
+    return counts_[id];
+}
+
+// Helper - lookup() - convert to uppercase, then the Parser's lookup
+CommandId CommandRegistry::lookup(const std::string& command)
 {
     std::string upperCmd = command;
     for (size_t i = 0; i < upperCmd.length(); ++i)
-        upperCmd[i] = std::toupper(upperCmd[i]);
-    return handlers_.find(upperCmd) != handlers_.end();
+        upperCmd[i] = std::toupper(static_cast<unsigned char>(upperCmd[i]));
+    return commandIdFromName(upperCmd.data(), upperCmd.length());
 }
 
 // Method - initializeHandlers()
 // - Register all command handlers
 void CommandRegistry::initializeHandlers()
 {
-	// TODO (Issue 1.3): Enable when command handlers implemented
-    // Register commands here when implemented
-    // registerCommand("PASS", handlePass);
-    // registerCommand("NICK", handleNick);
-    // registerCommand("USER", handleUser);
-    // registerCommand("JOIN", handleJoin);
-    // registerCommand("PART", handlePart);
-    // registerCommand("PRIVMSG", handlePrivmsg);
-    // registerCommand("INVITE", handleInvite);
-    // registerCommand("KICK", handleKick);
-    // registerCommand("TOPIC", handleTopic);
-    // registerCommand("MODE", handleMode);
-    // registerCommand("QUIT", handleQuit);
-    // registerCommand("PING", handlePing);
-    // registerCommand("PONG", handlePong);
+    registerCommand(CMD_PASS, handlePass);
+    registerCommand(CMD_NICK, handleNick);
+    registerCommand(CMD_USER, handleUser);
+    registerCommand(CMD_JOIN, handleJoin);
+    registerCommand(CMD_PART, handlePart);
+    registerCommand(CMD_PRIVMSG, handlePrivmsg);
+    registerCommand(CMD_INVITE, handleInvite);
+    registerCommand(CMD_KICK, handleKick);
+    registerCommand(CMD_TOPIC, handleTopic);
+    registerCommand(CMD_MODE, handleMode);
+    registerCommand(CMD_QUIT, handleQuit);
+    registerCommand(CMD_PING, handlePing);
+    registerCommand(CMD_PONG, handlePong);
 }
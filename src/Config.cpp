@@ -6,7 +6,8 @@
 #include <cstdlib>
 
 Config::Config(int port, const std::string& password)
-	: port_(port), password_(password) {
+	: port_(port), password_(password), serverName_("ft_irc"), pollerBackend_("auto"), edgeTriggered_(false), threads_(1), tcpCork_(false),
+	  pingInterval_(120), pingTimeout_(60), registrationTimeout_(60), logLevel_("info"), logRate_(100) {
 }
 
 int Config::getPort() const {
@@ -17,6 +18,61 @@ const std::string& Config::getPassword() const {
 	return password_;
 }
 
+const std::string& Config::getServerName() const {
+	return serverName_;
+}
+
+const std::string& Config::getPollerBackend() const {
+	return pollerBackend_;
+}
+
+bool Config::getEdgeTriggered() const {
+	return edgeTriggered_;
+}
+
+int Config::getThreads() const {
+	return threads_;
+}
+
+int Config::getCpuForReactor(int reactor) const {
+	if (cpus_.empty()) {
+		return -1;
+	}
+	return cpus_[reactor % cpus_.size()];
+}
+
+const SendQueue::Limits& Config::getSendQLimits() const {
+	return sendqLimits_;
+}
+
+bool Config::getTcpCork() const {
+	return tcpCork_;
+}
+
+int Config::getPingInterval() const {
+	return pingInterval_;
+}
+
+int Config::getPingTimeout() const {
+	return pingTimeout_;
+}
+
+int Config::getRegistrationTimeout() const {
+	return registrationTimeout_;
+}
+
+const std::string& Config::getLogLevel() const {
+	return logLevel_;
+}
+
+const std::string& Config::getLogFile() const {
+	return logFile_;
+}
+
+int Config::getLogRate() const {
+	return logRate_;
+}
+
 void Config::setPort(int port) {
 	port_ = port;
 }
@@ -25,9 +81,93 @@ void Config::setPassword(const std::string& password) {
 	password_ = password;
 }
 
+void Config::setServerName(const std::string& serverName) {
+	serverName_ = serverName;
+}
+
+void Config::setPollerBackend(const std::string& backend) {
+	pollerBackend_ = backend;
+}
+
+void Config::setEdgeTriggered(bool edgeTriggered) {
+	edgeTriggered_ = edgeTriggered;
+}
+
+void Config::setThreads(int threads) {
+	threads_ = (threads < 1) ? 1 : threads;
+}
+
+void Config::setCpus(const std::vector<int>& cpus) {
+	cpus_ = cpus;
+}
+
+void Config::setSendQLimits(const SendQueue::Limits& limits) {
+	sendqLimits_ = limits;
+}
+
+void Config::setTcpCork(bool tcpCork) {
+	tcpCork_ = tcpCork;
+}
+
+void Config::setPingInterval(int seconds) {
+	pingInterval_ = (seconds < 0) ? 0 : seconds;
+}
+
+void Config::setPingTimeout(int seconds) {
+	pingTimeout_ = (seconds < 1) ? 1 : seconds;
+}
+
+void Config::setRegistrationTimeout(int seconds) {
+	registrationTimeout_ = (seconds < 0) ? 0 : seconds;
+}
+
+void Config::setLogLevel(const std::string& level) {
+	logLevel_ = level;
+}
+
+void Config::setLogFile(const std::string& path) {
+	logFile_ = path;
+}
+
+void Config::setLogRate(int perSecond) {
+	logRate_ = (perSecond < 0) ? 0 : perSecond;
+}
+
+// "0,2,4" -> [0, 2, 4] (invalid entries are skipped)
+static std::vector<int> parseCpuList(const std::string& list) {
+	std::vector<int> cpus;
+	size_t start = 0;
+	while (start <= list.size()) {
+		size_t comma = list.find(',', start);
+		if (comma == std::string::npos) {
+			comma = list.size();
+		}
+		std::string item = list.substr(start, comma - start);
+		if (!item.empty() && item.find_first_not_of("0123456789") == std::string::npos) {
+			cpus.push_back(atoi(item.c_str()));
+		}
+		start = comma + 1;
+	}
+	return cpus;
+}
+
 Config Config::parseArgs(int argc, char** argv) {
 	int port = 6667;  // Default IRC port
 	std::string password = "";
+	std::string serverName = "ft_irc";
+	std::string pollerBackend = "auto";
+	bool edgeTriggered = false;
+	bool tcpCork = false;
+	int pingInterval = 120;
+	int pingTimeout = 60;
+	int registrationTimeout = 60;
+	std::string logLevel = "info";
+	std::string logFile = "";
+	int logRate = 100;
+	int threads = 1;
+	std::vector<int> cpus;
+	SendQueue::Limits sendq;
+	int positional = 0;  // <port> <password>
 
 	for (int i = 1; i < argc; ++i) {
 		std::string arg = argv[i];
@@ -42,7 +182,112 @@ Config Config::parseArgs(int argc, char** argv) {
 				password = argv[++i];
 			}
 		}
+		else if (arg == "--server-name") {
+			if (i + 1 < argc) {
+				serverName = argv[++i];
+			}
+		}
+		else if (arg == "--poller") {
+			if (i + 1 < argc) {
+				pollerBackend = argv[++i];
+			}
+		}
+		else if (arg == "--edge-triggered") {
+			edgeTriggered = true;
+		}
+		else if (arg == "--threads") {
+			if (i + 1 < argc) {
+				threads = atoi(argv[++i]);
+			}
+		}
+		else if (arg == "--cpus") {
+			if (i + 1 < argc) {
+				cpus = parseCpuList(argv[++i]);
+			}
+		}
+		else if (arg == "--sendq-soft") {
+			if (i + 1 < argc) {
+				sendq.softBytes = strtoul(argv[++i], NULL, 10);
+			}
+		}
+		else if (arg == "--sendq-hard") {
+			if (i + 1 < argc) {
+				sendq.hardBytes = strtoul(argv[++i], NULL, 10);
+			}
+		}
+		else if (arg == "--sendq-soft-msgs") {
+			if (i + 1 < argc) {
+				sendq.softMessages = strtoul(argv[++i], NULL, 10);
+			}
+		}
+		else if (arg == "--sendq-hard-msgs") {
+			if (i + 1 < argc) {
+				sendq.hardMessages = strtoul(argv[++i], NULL, 10);
+			}
+		}
+		else if (arg == "--sendq-policy") {
+			if (i + 1 < argc) {
+				std::string policy = argv[++i];
+				sendq.dropLowPriority = (policy == "drop" || policy == "both");
+				sendq.pauseReading = (policy == "pause" || policy == "both");
+			}
+		}
+		else if (arg == "--tcp-cork") {
+			tcpCork = true;
+		}
+		else if (arg == "--ping-interval") {
+			if (i + 1 < argc) {
+				pingInterval = atoi(argv[++i]);
+			}
+		}
+		else if (arg == "--ping-timeout") {
+			if (i + 1 < argc) {
+				pingTimeout = atoi(argv[++i]);
+			}
+		}
+		else if (arg == "--registration-timeout") {
+			if (i + 1 < argc) {
+				registrationTimeout = atoi(argv[++i]);
+			}
+		}
+		else if (arg == "--log-level") {
+			if (i + 1 < argc) {
+				logLevel = argv[++i];
+			}
+		}
+		else if (arg == "--log-file") {
+			if (i + 1 < argc) {
+				logFile = argv[++i];
+			}
+		}
+		else if (arg == "--log-rate") {
+			if (i + 1 < argc) {
+				logRate = atoi(argv[++i]);
+			}
+		}
+		else if (positional == 0) {
+			port = atoi(arg.c_str());
+			++positional;
+		}
+		else if (positional == 1) {
+			password = arg;
+			++positional;
+		}
 	}
 
-	return Config(port, password);
+	Config config(port, password);
+	config.setServerName(serverName);
+	config.setPollerBackend(pollerBackend);
+	config.setEdgeTriggered(edgeTriggered);
+	config.setThreads(threads);
+	config.setCpus(cpus);
+	config.setSendQLimits(sendq);
+	config.setTcpCork(tcpCork);
+	config.setPingInterval(pingInterval);
+	config.setPingTimeout(pingTimeout);
+	config.setRegistrationTimeout(registrationTimeout);
+	config.setLogLevel(logLevel);
+	config.setLogFile(logFile);
+	config.setLogRate(logRate);
+	return config;
 }
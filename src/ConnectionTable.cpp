@@ -0,0 +1,69 @@
+// ConnectionTable implementation
+// fd -> Slot in a vector, generations to detect reused fds
+
+#include "irc/ConnectionTable.hpp"
+
+static const ConnectionTable::Slot emptySlot = { NULL, NULL, NULL, NULL, 0, 0, 0 };
+
+ConnectionTable::ConnectionTable() : count_(0) {}
+
+ConnectionTable::Slot* ConnectionTable::open(int fd) {
+    if (fd < 0) return NULL;
+    size_t index = static_cast<size_t>(fd);
+    if (index >= slots_.size()) {
+        // Doubling: accepts with rising fds do not reallocate every time
+        size_t size = slots_.empty() ? 64 : slots_.size();
+        while (size <= index) size *= 2;
+        slots_.resize(size, emptySlot);
+    }
+
+    Slot& slot = slots_[index];
+    unsigned int generation = slot.generation + 1;
+    if (generation == 0) generation = 1;    // 0 never names a connection
+    slot = emptySlot;
+    slot.generation = generation;
+    ++count_;
+    return &slot;
+}
+
+void ConnectionTable::close(int fd) {
+    Slot* slot = find(fd);
+    if (!slot) return;
+    // Keep the generation: the next open() moves past it
+    unsigned int generation = slot->generation;
+    *slot = emptySlot;
+    slot->generation = generation;
+    --count_;
+}
+
+ConnectionTable::Slot* ConnectionTable::find(int fd) {
+    if (fd < 0 || static_cast<size_t>(fd) >= slots_.size()) return NULL;
+    Slot& slot = slots_[fd];
+    return slot.client ? &slot : NULL;
+}
+
+ConnectionTable::Slot* ConnectionTable::find(const Handle& handle) {
+    Slot* slot = find(handle.fd);
+    return (slot && slot->generation == handle.generation) ? slot : NULL;
+}
+
+ConnectionTable::Handle ConnectionTable::handle(int fd) const {
+    if (fd < 0 || static_cast<size_t>(fd) >= slots_.size() || !slots_[fd].client) {
+        return Handle(fd, 0);
+    }
+    return Handle(fd, slots_[fd].generation);
+}
+
+size_t ConnectionTable::size() const {
+    return count_;
+}
+
+int ConnectionTable::end() const {
+    return static_cast<int>(slots_.size());
+}
+
+void ConnectionTable::clearMarks() {
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        slots_[i].fanoutMark = 0;
+    }
+}
@@ -0,0 +1,313 @@
+// Identifier implementation
+// Open-addressing table of interned names (linear probing, power of two
+// slots, backward-shift deletion) and the RFC 1459 casefold.
+
+#include "irc/Identifier.hpp"
+#include "irc/SlabPool.hpp"
+#include <vector>
+#include <cstring>
+
+#if defined(__SSE2__)
+# define IDENTIFIER_SSE2 1
+# include <emmintrin.h>
+#endif
+
+// ============================================================================
+// Casefolding
+// ============================================================================
+
+// RFC 1459 casemapping: 'A'..'^' (0x41..0x5E) fold to 'a'..'~' (0x61..0x7E),
+// so '[' '\' ']' '^' are the uppercase forms of '{' '|' '}' '~'
+// Computed, not looked up: no table to initialise, usable from any static
+// initializer (like table() below)
+static inline unsigned char foldByte(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return static_cast<unsigned char>(static_cast<unsigned char>(u - 0x41) <= 0x5E - 0x41 ? u + 0x20 : u);
+}
+
+// Same on the 8 bytes of a word at once (SWAR): per byte, bit 7 of
+// low7 + 0x3F says > 0x40, of low7 + 0x21 says > 0x5E (low 7 bits only,
+// no carry into the next byte); bytes >= 0x80 never fold
+typedef unsigned long long Word;
+
+static const Word ONES = 0x0101010101010101ULL;
+
+static inline Word foldWord(Word w) {
+    Word low7 = w & (0x7F * ONES);
+    Word above40 = low7 + 0x3F * ONES;
+    Word above5E = low7 + 0x21 * ONES;
+    Word upper = above40 & ~above5E & ~w & (0x80 * ONES);
+    return w + (upper >> 2);        // 0x80 >> 2 = 0x20
+}
+
+static inline Word loadWord(const char* p) {
+    Word w;
+    std::memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+// The last n < 8 bytes, zero-padded (same layout for both sides of a compare)
+static inline Word loadTail(const char* p, size_t n) {
+    Word w = 0;
+    for (size_t i = 0; i < n; ++i) {
+        w |= static_cast<Word>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return w;
+}
+
+#ifdef IDENTIFIER_SSE2
+// Signed compares: bytes >= 0x80 are negative, never in 0x41..0x5E
+static inline __m128i foldVector(__m128i v) {
+    const __m128i low = _mm_set1_epi8(0x40);
+    const __m128i high = _mm_set1_epi8(0x5F);
+    const __m128i delta = _mm_set1_epi8(0x20);
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmplt_epi8(v, high));
+    return _mm_add_epi8(v, _mm_and_si128(upper, delta));
+}
+#endif
+
+char Identifier::foldChar(char c) {
+    return static_cast<char>(foldByte(c));
+}
+
+// 16 bytes per step with SSE2, then 8 per step, then the last few
+void Identifier::fold(const char* in, size_t length, char* out) {
+    size_t i = 0;
+#ifdef IDENTIFIER_SSE2
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), foldVector(v));
+    }
+#endif
+    for (; i + sizeof(Word) <= length; i += sizeof(Word)) {
+        Word w = foldWord(loadWord(in + i));
+        std::memcpy(out + i, &w, sizeof(w));
+    }
+    for (; i < length; ++i) {
+        out[i] = static_cast<char>(foldByte(in[i]));
+    }
+}
+
+std::string Identifier::fold(const std::string& name) {
+    std::string folded(name.size(), '\0');
+    if (!name.empty()) {
+        fold(name.data(), name.size(), &folded[0]);
+    }
+    return folded;
+}
+
+// A folded word per step (folded on the fly, nothing is copied), one
+// multiply each, avalanched at the end: linear probing uses the low bits.
+// Seeded with the length, so the zero padding of the tail cannot collide.
+static inline Word mixWord(Word hash, Word word) {
+    hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    return hash ^ (hash >> 32);
+}
+
+size_t Identifier::hashFolded(const char* name, size_t length) {
+    Word hash = static_cast<Word>(length) * 0xC2B2AE3D27D4EB4FULL;
+    size_t i = 0;
+    for (; i + sizeof(Word) <= length; i += sizeof(Word)) {
+        hash = mixWord(hash, foldWord(loadWord(name + i)));
+    }
+    if (i < length) {
+        hash = mixWord(hash, foldWord(loadTail(name + i, length - i)));
+    }
+    hash *= 0xFF51AFD7ED558CCDULL;
+    return static_cast<size_t>(hash ^ (hash >> 29));
+}
+
+// Folded name (stored) against a raw name (folded while comparing,
+// 16 bytes per step with SSE2, a word otherwise)
+static bool equalsFolded(const std::string& folded, const char* name, size_t length) {
+    if (folded.size() != length) return false;
+    const char* stored = folded.data();
+    size_t i = 0;
+#ifdef IDENTIFIER_SSE2
+    for (; i + 16 <= length; i += 16) {
+        __m128i raw = foldVector(_mm_loadu_si128(reinterpret_cast<const __m128i*>(name + i)));
+        __m128i kept = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stored + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(raw, kept)) != 0xFFFF) return false;
+    }
+#endif
+    for (; i + sizeof(Word) <= length; i += sizeof(Word)) {
+        if (foldWord(loadWord(name + i)) != loadWord(stored + i)) return false;
+    }
+    if (i < length) {
+        return foldWord(loadTail(name + i, length - i)) == loadTail(stored + i, length - i);
+    }
+    return true;
+}
+
+// ============================================================================
+// Table
+// ============================================================================
+
+struct Identifier::Entry {
+    std::string name;       // folded
+    size_t hash;
+    unsigned long refs;
+};
+
+namespace {
+
+class IdentifierTable {
+public:
+    IdentifierTable() : slots_(INITIAL_SLOTS, static_cast<Identifier::Entry*>(NULL)), count_(0) {}
+
+    ~IdentifierTable() {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i]) entries_.destroy(slots_[i]);
+        }
+    }
+
+    Identifier::Entry* find(const char* name, size_t length, size_t hash) const {
+        size_t mask = slots_.size() - 1;
+        for (size_t i = hash & mask; slots_[i]; i = (i + 1) & mask) {
+            Identifier::Entry* entry = slots_[i];
+            if (entry->hash == hash && equalsFolded(entry->name, name, length)) {
+                return entry;
+            }
+        }
+        return NULL;
+    }
+
+    Identifier::Entry* intern(const char* name, size_t length) {
+        size_t hash = Identifier::hashFolded(name, length);
+        Identifier::Entry* entry = find(name, length, hash);
+        if (entry) return entry;
+
+        // Keep the load factor at or below 1/2
+        if ((count_ + 1) * 2 > slots_.size()) {
+            grow();
+        }
+
+        entry = entries_.create();
+        entry->name.resize(length);
+        if (length) Identifier::fold(name, length, &entry->name[0]);
+        entry->hash = hash;
+        entry->refs = 0;
+        place(entry);
+        ++count_;
+        return entry;
+    }
+
+    // Backward-shift deletion: no tombstones, probe chains stay short
+    void remove(Identifier::Entry* entry) {
+        size_t mask = slots_.size() - 1;
+        size_t hole = entry->hash & mask;
+        while (slots_[hole] != entry) hole = (hole + 1) & mask;
+
+        size_t next = (hole + 1) & mask;
+        while (slots_[next]) {
+            size_t home = slots_[next]->hash & mask;
+            // Move next into the hole unless its home lies in (hole, next]
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                slots_[hole] = slots_[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        slots_[hole] = NULL;
+        --count_;
+        entries_.destroy(entry);
+    }
+
+    size_t size() const {
+        return count_;
+    }
+
+private:
+    enum { INITIAL_SLOTS = 64 };
+
+    void place(Identifier::Entry* entry) {
+        size_t mask = slots_.size() - 1;
+        size_t i = entry->hash & mask;
+        while (slots_[i]) i = (i + 1) & mask;
+        slots_[i] = entry;
+    }
+
+    void grow() {
+        std::vector<Identifier::Entry*> old(slots_.size() * 2, static_cast<Identifier::Entry*>(NULL));
+        old.swap(slots_);
+        for (size_t i = 0; i < old.size(); ++i) {
+            if (old[i]) place(old[i]);
+        }
+    }
+
+    std::vector<Identifier::Entry*> slots_;
+    size_t count_;
+    SlabPool<Identifier::Entry> entries_;   // names come and go with channels
+};
+
+// Function-local: usable from any static initializer
+IdentifierTable& table() {
+    static IdentifierTable instance;
+    return instance;
+}
+
+const std::string& emptyName() {
+    static const std::string name;
+    return name;
+}
+
+}
+
+// ============================================================================
+// Handle
+// ============================================================================
+
+Identifier::Identifier() : entry_(NULL) {}
+
+Identifier::Identifier(Entry* entry) : entry_(entry) {
+    if (entry_) ++entry_->refs;
+}
+
+Identifier::Identifier(const std::string& name)
+    : entry_(table().intern(name.data(), name.size())) {
+    ++entry_->refs;
+}
+
+Identifier::Identifier(const char* name, size_t length)
+    : entry_(table().intern(name, length)) {
+    ++entry_->refs;
+}
+
+Identifier::Identifier(const Identifier& other) : entry_(other.entry_) {
+    if (entry_) ++entry_->refs;
+}
+
+Identifier& Identifier::operator=(const Identifier& other) {
+    if (other.entry_) ++other.entry_->refs;     // first: self-assignment safe
+    if (entry_ && --entry_->refs == 0) table().remove(entry_);
+    entry_ = other.entry_;
+    return *this;
+}
+
+Identifier::~Identifier() {
+    if (entry_ && --entry_->refs == 0) table().remove(entry_);
+}
+
+Identifier Identifier::find(const std::string& name) {
+    return find(name.data(), name.size());
+}
+
+Identifier Identifier::find(const char* name, size_t length) {
+    return Identifier(table().find(name, length, hashFolded(name, length)));
+}
+
+bool Identifier::empty() const {
+    return entry_ == NULL;
+}
+
+const std::string& Identifier::str() const {
+    return entry_ ? entry_->name : emptyName();
+}
+
+size_t Identifier::hash() const {
+    return entry_ ? entry_->hash : 0;
+}
+
+size_t Identifier::internedCount() {
+    return table().size();
+}
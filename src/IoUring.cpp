@@ -0,0 +1,394 @@
+// IoUring implementation
+// Raw io_uring syscalls for Poller's BACKEND_URING (Linux only)
+// Ring layout and memory ordering follow io_uring(7)
+
+#include "irc/IoUring.hpp"
+#include "irc/Logger.hpp"
+
+#ifdef __LINUX__
+
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#include <cerrno>
+
+// prepSend() argument space: msghdrs (one per SQE) and iovecs
+static const size_t SEND_IOVS_PER_SQE = 16;
+
+// Kernel shares head/tail indexes with us: acquire on load, release on store
+static unsigned int loadAcquire(const unsigned int* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void storeRelease(unsigned int* p, unsigned int v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+IoUring::IoUring()
+    : ringFd_(-1)
+    , sqRing_(MAP_FAILED), sqRingSize_(0)
+    , sqHead_(NULL), sqTail_(NULL), sqMask_(NULL), sqArray_(NULL)
+    , sqes_(MAP_FAILED), sqesSize_(0), sqEntries_(0), sqLocalTail_(0)
+    , cqRing_(MAP_FAILED), cqRingSize_(0)
+    , cqHead_(NULL), cqTail_(NULL), cqMask_(NULL), cqes_(NULL)
+    , bufRing_(MAP_FAILED), bufRingSize_(0), bufEntries_(0), bufSize_(0), bufTail_(0)
+    , sendStable_(false), sendMsgsUsed_(0), sendIovsUsed_(0)
+    , enterCalls_(0)
+{
+}
+
+IoUring::~IoUring() {
+    destroy();
+}
+
+// Method - init()
+// - io_uring_setup() with a CQ 4x the SQ (multishot requests post many CQEs)
+// - mmap SQ ring, CQ ring and SQE array
+// - register a provided buffer ring (group 0) of bufferCount * bufferSize bytes
+bool IoUring::init(unsigned int entries, unsigned int bufferCount, unsigned int bufferSize) {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * 4;
+
+    ringFd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ringFd_ < 0) {
+        IRC_LOG_ERROR("IoUring", LogFields(), "io_uring_setup() failed: " << strerror(errno));
+        return false;
+    }
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG)) {
+        IRC_LOG_WARN("IoUring", LogFields(), "kernel too old (needs SINGLE_MMAP and EXT_ARG)");
+        destroy();
+        return false;
+    }
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (cqRingSize_ > sqRingSize_) sqRingSize_ = cqRingSize_;
+
+    sqRing_ = mmap(NULL, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   ringFd_, IORING_OFF_SQ_RING);
+    if (sqRing_ == MAP_FAILED) {
+        IRC_LOG_ERROR("IoUring", LogFields(), "mmap(SQ ring) failed: " << strerror(errno));
+        destroy();
+        return false;
+    }
+    cqRing_ = sqRing_;  // IORING_FEAT_SINGLE_MMAP: one mapping for both rings
+    cqRingSize_ = 0;
+
+    sqesSize_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes_ = mmap(NULL, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                 ringFd_, IORING_OFF_SQES);
+    if (sqes_ == MAP_FAILED) {
+        IRC_LOG_ERROR("IoUring", LogFields(), "mmap(SQEs) failed: " << strerror(errno));
+        destroy();
+        return false;
+    }
+
+    char* sq = static_cast<char*>(sqRing_);
+    sqHead_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.head);
+    sqTail_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.tail);
+    sqMask_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.ring_mask);
+    sqArray_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.array);
+    sqEntries_ = params.sq_entries;
+    sqLocalTail_ = *sqTail_;
+
+    char* cq = static_cast<char*>(cqRing_);
+    cqHead_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.tail);
+    cqMask_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.ring_mask);
+    cqes_ = cq + params.cq_off.cqes;
+
+    // Provided buffer ring: entry count must be a power of two
+    bufEntries_ = 1;
+    while (bufEntries_ < bufferCount) bufEntries_ <<= 1;
+    bufSize_ = bufferSize;
+    bufRingSize_ = bufEntries_ * sizeof(struct io_uring_buf);
+    bufRing_ = mmap(NULL, bufRingSize_, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (bufRing_ == MAP_FAILED) {
+        IRC_LOG_ERROR("IoUring", LogFields(), "mmap(buffer ring) failed: " << strerror(errno));
+        destroy();
+        return false;
+    }
+    bufStorage_.resize(static_cast<size_t>(bufEntries_) * bufSize_);
+
+    struct io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<unsigned long>(bufRing_);
+    reg.ring_entries = bufEntries_;
+    reg.bgid = 0;
+    if (syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        IRC_LOG_ERROR("IoUring", LogFields(), "IORING_REGISTER_PBUF_RING failed: " << strerror(errno));
+        munmap(bufRing_, bufRingSize_);
+        bufRing_ = MAP_FAILED;
+        destroy();
+        return false;
+    }
+
+    bufTail_ = 0;
+    for (unsigned int i = 0; i < bufEntries_; ++i) {
+        addBuffer(static_cast<unsigned short>(i));
+    }
+
+    // Sends: the msghdr/iovecs are read at submit time, not later
+    sendStable_ = (params.features & IORING_FEAT_SUBMIT_STABLE) != 0;
+    if (sendStable_) {
+        sendMsgs_.resize(sqEntries_);
+        sendIovs_.resize(sqEntries_ * SEND_IOVS_PER_SQE);
+    } else {
+        IRC_LOG_WARN("IoUring", LogFields(), "no SUBMIT_STABLE: output is written with writev()");
+    }
+    IRC_LOG_INFO("IoUring", LogFields(), "Ring ready: " << sqEntries_ << " SQEs, "
+                << bufEntries_ << " x " << bufSize_ << " byte recv buffers");
+    return true;
+}
+
+bool IoUring::isReady() const {
+    return ringFd_ >= 0;
+}
+
+// Method - getSqe() - next free SQE, flushes the queue to the kernel if full
+void* IoUring::getSqe() {
+    unsigned int head = loadAcquire(sqHead_);
+    if (sqLocalTail_ - head >= sqEntries_) {
+        submit();
+        head = loadAcquire(sqHead_);
+        if (sqLocalTail_ - head >= sqEntries_) {
+            return NULL;
+        }
+    }
+    unsigned int index = sqLocalTail_ & *sqMask_;
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(sqes_) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqArray_[index] = index;
+    ++sqLocalTail_;
+    return sqe;
+}
+
+void IoUring::publishSqes() {
+    storeRelease(sqTail_, sqLocalTail_);
+}
+
+bool IoUring::prepMultishotAccept(int fd, unsigned long long userData) {
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(getSqe());
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::prepMultishotRecv(int fd, unsigned long long userData) {
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(getSqe());
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = 1U << IOSQE_BUFFER_SELECT_BIT;
+    sqe->buf_group = 0;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::prepPollAdd(int fd, short events, unsigned long long userData) {
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(getSqe());
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = static_cast<unsigned short>(events);
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::prepCancel(unsigned long long targetUserData, unsigned long long userData) {
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(getSqe());
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = targetUserData;
+    sqe->user_data = userData;
+    return true;
+}
+
+// Method - prepSend()
+// The arguments go to the arena; if it is full, what is queued is submitted
+// first (the kernel has read their arguments then, the arena starts over)
+bool IoUring::prepSend(int fd, const struct iovec* iov, int count, unsigned long long userData) {
+    if (!sendStable_ || count <= 0) return false;
+    size_t n = static_cast<size_t>(count);
+    if (sendMsgsUsed_ == sendMsgs_.size() || sendIovsUsed_ + n > sendIovs_.size()) {
+        submit();
+        if (sendMsgsUsed_ == sendMsgs_.size() || sendIovsUsed_ + n > sendIovs_.size()) {
+            return false;
+        }
+    }
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(getSqe());
+    if (!sqe) return false;
+
+    struct iovec* iovs = &sendIovs_[sendIovsUsed_];
+    std::memcpy(iovs, iov, n * sizeof(*iov));
+    struct msghdr* msg = &sendMsgs_[sendMsgsUsed_];
+    std::memset(msg, 0, sizeof(*msg));
+    msg->msg_iov = iovs;
+    msg->msg_iovlen = n;
+    ++sendMsgsUsed_;
+    sendIovsUsed_ += n;
+
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<unsigned long>(msg);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::canSend() const {
+    return sendStable_;
+}
+
+// Everything queued was consumed by the kernel: prepSend() arguments free
+void IoUring::releaseSendArgs() {
+    if (loadAcquire(sqHead_) == sqLocalTail_) {
+        sendMsgsUsed_ = 0;
+        sendIovsUsed_ = 0;
+    }
+}
+
+int IoUring::enter(unsigned int toSubmit, unsigned int minComplete, unsigned int flags,
+                   void* arg, size_t argSize) {
+    ++enterCalls_;
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFd_, toSubmit, minComplete,
+                                    flags, arg, argSize));
+}
+
+// Method - submit() - hand prepared SQEs to the kernel without waiting
+int IoUring::submit() {
+    unsigned int pending = sqLocalTail_ - *sqTail_;
+    if (pending == 0) return 0;
+    publishSqes();
+    int ret = enter(pending, 0, 0, NULL, 0);
+    if (ret < 0 && errno != EINTR) {
+        IRC_LOG_ERROR("IoUring", LogFields(), "io_uring_enter(submit) failed: " << strerror(errno));
+    }
+    releaseSendArgs();
+    return ret;
+}
+
+// Method - submitAndWait()
+// - One io_uring_enter() submits everything prepared since the last call
+//   and sleeps until a CQE arrives or timeoutMs expires (EXT_ARG timeout)
+// - Copies all available CQEs into out and releases them to the kernel
+int IoUring::submitAndWait(int timeoutMs, std::vector<Completion>& out) {
+    unsigned int pending = sqLocalTail_ - *sqTail_;
+    publishSqes();
+
+    // Skip the wait if completions are already queued
+    bool haveCqes = loadAcquire(cqTail_) != *cqHead_;
+    if (pending > 0 || !haveCqes) {
+        struct __kernel_timespec ts;
+        struct io_uring_getevents_arg arg;
+        std::memset(&arg, 0, sizeof(arg));
+        unsigned int flags = IORING_ENTER_EXT_ARG;
+        unsigned int minComplete = 0;
+        if (!haveCqes && timeoutMs != 0) {
+            flags |= IORING_ENTER_GETEVENTS;
+            minComplete = 1;
+            if (timeoutMs > 0) {
+                ts.tv_sec = timeoutMs / 1000;
+                ts.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000LL;
+                arg.ts = reinterpret_cast<unsigned long>(&ts);
+            }
+        }
+        int ret = enter(pending, minComplete, flags, &arg, sizeof(arg));
+        if (ret < 0 && errno != EINTR && errno != ETIME && errno != EBUSY) {
+            IRC_LOG_ERROR("IoUring", LogFields(), "io_uring_enter() failed: " << strerror(errno));
+        }
+        releaseSendArgs();
+    }
+
+    unsigned int head = *cqHead_;
+    unsigned int tail = loadAcquire(cqTail_);
+    int count = 0;
+    while (head != tail) {
+        const struct io_uring_cqe* cqe =
+            static_cast<const struct io_uring_cqe*>(cqes_) + (head & *cqMask_);
+        Completion c;
+        c.userData = cqe->user_data;
+        c.result = cqe->res;
+        c.flags = cqe->flags;
+        out.push_back(c);
+        ++head;
+        ++count;
+    }
+    storeRelease(cqHead_, head);
+    return count;
+}
+
+bool IoUring::hasBuffer(const Completion& completion) {
+    return (completion.flags & IORING_CQE_F_BUFFER) != 0;
+}
+
+unsigned short IoUring::bufferId(const Completion& completion) {
+    return static_cast<unsigned short>(completion.flags >> IORING_CQE_BUFFER_SHIFT);
+}
+
+// Multishot request still armed (no need to resubmit)
+bool IoUring::hasMore(const Completion& completion) {
+    return (completion.flags & IORING_CQE_F_MORE) != 0;
+}
+
+const char* IoUring::bufferData(unsigned short bufferId) const {
+    return &bufStorage_[static_cast<size_t>(bufferId) * bufSize_];
+}
+
+// Method - recycleBuffer() - give a consumed recv buffer back to the kernel
+void IoUring::recycleBuffer(unsigned short bufferId) {
+    addBuffer(bufferId);
+}
+
+void IoUring::addBuffer(unsigned short bufferId) {
+    // Index the entries by hand: in C++ the header's flexible array member
+    // (io_uring_buf_ring::bufs) gets a non-zero offset. The ring tail
+    // overlays the resv field of entry 0.
+    struct io_uring_buf* bufs = static_cast<struct io_uring_buf*>(bufRing_);
+    struct io_uring_buf* buf = &bufs[bufTail_ & (bufEntries_ - 1)];
+    buf->addr = reinterpret_cast<unsigned long>(&bufStorage_[static_cast<size_t>(bufferId) * bufSize_]);
+    buf->len = bufSize_;
+    buf->bid = bufferId;
+    ++bufTail_;
+    __atomic_store_n(&bufs[0].resv, bufTail_, __ATOMIC_RELEASE);
+}
+
+unsigned long IoUring::getEnterCalls() const {
+    return enterCalls_;
+}
+
+void IoUring::destroy() {
+    if (ringFd_ >= 0) {
+        close(ringFd_);  // also unregisters the buffer ring
+        ringFd_ = -1;
+    }
+    if (bufRing_ != MAP_FAILED) {
+        munmap(bufRing_, bufRingSize_);
+        bufRing_ = MAP_FAILED;
+    }
+    if (sqes_ != MAP_FAILED) {
+        munmap(sqes_, sqesSize_);
+        sqes_ = MAP_FAILED;
+    }
+    if (sqRing_ != MAP_FAILED) {
+        munmap(sqRing_, sqRingSize_);
+        sqRing_ = MAP_FAILED;
+        cqRing_ = MAP_FAILED;
+    }
+}
+
+#endif // __LINUX__
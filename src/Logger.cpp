@@ -0,0 +1,389 @@
+// Logger implementation
+// Bounded MPSC ring (Vyukov): a cell's sequence says whose turn it is,
+// producers claim cells with a CAS on enqueuePos_, the writer thread
+// releases them one revolution ahead
+
+#include "irc/Logger.hpp"
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>
+#include <sys/time.h>
+
+static const unsigned long long REPEAT_REPORT_MS = 1000;   // also the writer's longest sleep
+static const unsigned long long RATE_BURST_US = 1000000;   // a second's worth of lines at once
+static const size_t OUT_FLUSH_BYTES = 64 * 1024;
+
+int Logger::level_ = Logger::LEVEL_INFO;
+unsigned long long Logger::rateIntervalUs_ = 0;
+unsigned long Logger::rateLimited_ = 0;
+
+static unsigned long long wallMs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return static_cast<unsigned long long>(tv.tv_sec) * 1000ULL
+         + static_cast<unsigned long long>(tv.tv_usec) / 1000ULL;
+}
+
+static unsigned long long monotonicUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<unsigned long long>(ts.tv_sec) * 1000000ULL
+         + static_cast<unsigned long long>(ts.tv_nsec) / 1000ULL;
+}
+
+// Copy at most size - 1 bytes and terminate (s may be NULL)
+static void copyField(char* dst, size_t size, const char* s) {
+    size_t n = 0;
+    if (s) {
+        while (n + 1 < size && s[n]) {
+            dst[n] = s[n];
+            ++n;
+        }
+    }
+    dst[n] = '\0';
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger()
+    : ring_(RING_SIZE), enqueuePos_(0), dequeuePos_(0), dropped_(0), droppedReported_(0)
+    , fd_(2), thread_(), running_(false), stopping_(false), sleeping_(false)
+    , repeats_(0), repeatSince_(0), rateReported_(0) {
+    pthread_mutex_init(&wakeLock_, NULL);
+    pthread_cond_init(&wake_, NULL);
+    for (size_t i = 0; i < ring_.size(); ++i) {
+        ring_[i].sequence = i;
+    }
+    std::memset(&last_, 0, sizeof(last_));
+    last_.level = -1;       // matches no line
+}
+
+Logger::~Logger() {
+    stop();
+    pthread_cond_destroy(&wake_);
+    pthread_mutex_destroy(&wakeLock_);
+}
+
+void Logger::setLevel(Level level) {
+    __atomic_store_n(&level_, static_cast<int>(level), __ATOMIC_RELAXED);
+}
+
+void Logger::setRateLimit(unsigned long perSecond) {
+    unsigned long long interval = 0;
+    if (perSecond > 0) {
+        interval = RATE_BURST_US / perSecond;
+        if (interval == 0) interval = 1;
+    }
+    __atomic_store_n(&rateIntervalUs_, interval, __ATOMIC_RELAXED);
+}
+
+// GCRA: a line is let through when its due time is at most a burst ahead
+// of now, and pushes the due time one interval further. One CAS, no lock
+bool Logger::allow(LogRate& rate, unsigned long& suppressed) {
+    suppressed = 0;
+    unsigned long long interval = __atomic_load_n(&rateIntervalUs_, __ATOMIC_RELAXED);
+    if (interval == 0) {
+        return true;
+    }
+    unsigned long long now = monotonicUs();
+    unsigned long long due = __atomic_load_n(&rate.dueUs, __ATOMIC_RELAXED);
+    for (;;) {
+        unsigned long long start = due > now ? due : now;
+        if (start - now + interval > RATE_BURST_US) {
+            __atomic_add_fetch(&rate.suppressed, 1, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&rateLimited_, 1, __ATOMIC_RELAXED);
+            return false;
+        }
+        if (__atomic_compare_exchange_n(&rate.dueUs, &due, start + interval, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    if (__atomic_load_n(&rate.suppressed, __ATOMIC_RELAXED) > 0) {
+        suppressed = __atomic_exchange_n(&rate.suppressed, 0, __ATOMIC_RELAXED);
+    }
+    return true;
+}
+
+unsigned long Logger::rateLimited() {
+    return __atomic_load_n(&rateLimited_, __ATOMIC_RELAXED);
+}
+
+Logger::Level Logger::levelFromName(const std::string& name) {
+    if (name == "debug") return LEVEL_DEBUG;
+    if (name == "warn") return LEVEL_WARN;
+    if (name == "error") return LEVEL_ERROR;
+    if (name == "off") return LEVEL_OFF;
+    return LEVEL_INFO;
+}
+
+const char* Logger::levelName(Level level) {
+    switch (level) {
+        case LEVEL_DEBUG: return "DEBUG";
+        case LEVEL_INFO:  return "INFO";
+        case LEVEL_WARN:  return "WARN";
+        case LEVEL_ERROR: return "ERROR";
+        default:          return "OFF";
+    }
+}
+
+void Logger::start(int fd) {
+    if (__atomic_load_n(&running_, __ATOMIC_ACQUIRE)) return;
+    fd_ = fd;
+    stopping_ = false;
+    if (pthread_create(&thread_, NULL, threadMain, this) == 0) {
+        __atomic_store_n(&running_, true, __ATOMIC_RELEASE);
+    }
+}
+
+// Producers must be gone (reactors joined): lines submitted after the
+// writer saw stopping_ and an empty ring would stay in it
+void Logger::stop() {
+    if (!__atomic_load_n(&running_, __ATOMIC_ACQUIRE)) return;
+    __atomic_store_n(&stopping_, true, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&wakeLock_);
+    pthread_cond_signal(&wake_);
+    pthread_mutex_unlock(&wakeLock_);
+    pthread_join(thread_, NULL);
+    __atomic_store_n(&running_, false, __ATOMIC_RELEASE);
+}
+
+unsigned long Logger::dropped() const {
+    return __atomic_load_n(&dropped_, __ATOMIC_RELAXED);
+}
+
+void Logger::fill(Record& record, Level level, const char* component, int fd,
+                  const char* nick, const char* command, const char* text, size_t length) {
+    record.timeMs = wallMs();
+    record.level = level;
+    record.fd = fd;
+    if (length > TEXT_SIZE) length = TEXT_SIZE;
+    record.length = static_cast<unsigned short>(length);
+    std::memcpy(record.text, text, length);
+    copyField(record.component, COMPONENT_SIZE, component);
+    copyField(record.nick, NICK_SIZE, nick);
+    copyField(record.command, COMMAND_SIZE, command);
+}
+
+// Cell i is free for the producer at pos when its sequence == pos, and
+// holds a line for the writer when it is pos + 1
+void Logger::submit(Level level, const char* component, int fd, const char* nick,
+                    const char* command, const char* text, size_t length) {
+    if (!__atomic_load_n(&running_, __ATOMIC_ACQUIRE)) {
+        Record record;
+        fill(record, level, component, fd, nick, command, text, length);
+        std::string line;
+        format(record, line);
+        ssize_t n = write(fd_, line.data(), line.size());
+        (void)n;
+        return;
+    }
+
+    unsigned long pos = __atomic_load_n(&enqueuePos_, __ATOMIC_RELAXED);
+    Record* cell;
+    for (;;) {
+        cell = &ring_[pos & (RING_SIZE - 1)];
+        unsigned long sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        long diff = static_cast<long>(sequence - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&enqueuePos_, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // A revolution behind: the writer has not freed it, ring full
+            __atomic_add_fetch(&dropped_, 1, __ATOMIC_RELAXED);
+            return;
+        } else {
+            pos = __atomic_load_n(&enqueuePos_, __ATOMIC_RELAXED);
+        }
+    }
+    fill(*cell, level, component, fd, nick, command, text, length);
+    // seq_cst against the writer's sleeping_ store then ring check in sleep():
+    // either it sees this line or this sees it asleep
+    __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&sleeping_, __ATOMIC_SEQ_CST)) {
+        wakeWriter();
+    }
+}
+
+void Logger::wakeWriter() {
+    pthread_mutex_lock(&wakeLock_);
+    pthread_cond_signal(&wake_);
+    pthread_mutex_unlock(&wakeLock_);
+}
+
+// Writer thread: the next cell holds a published line
+bool Logger::pending() const {
+    const Record& cell = ring_[dequeuePos_ & (RING_SIZE - 1)];
+    return __atomic_load_n(&cell.sequence, __ATOMIC_SEQ_CST) == dequeuePos_ + 1;
+}
+
+// Writer thread, ring drained: wait for a producer or stop(), at most
+// REPEAT_REPORT_MS (repeats and counters are reported on time)
+void Logger::sleep() {
+    pthread_mutex_lock(&wakeLock_);
+    __atomic_store_n(&sleeping_, true, __ATOMIC_SEQ_CST);
+    if (!pending() && !__atomic_load_n(&stopping_, __ATOMIC_SEQ_CST)) {
+        unsigned long long until = wallMs() + REPEAT_REPORT_MS;
+        struct timespec deadline;
+        deadline.tv_sec = static_cast<time_t>(until / 1000);
+        deadline.tv_nsec = static_cast<long>(until % 1000) * 1000000L;
+        pthread_cond_timedwait(&wake_, &wakeLock_, &deadline);
+    }
+    __atomic_store_n(&sleeping_, false, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&wakeLock_);
+}
+
+// Writer thread: everything published so far, true if there was any
+bool Logger::drain() {
+    bool any = false;
+    for (;;) {
+        Record& cell = ring_[dequeuePos_ & (RING_SIZE - 1)];
+        if (__atomic_load_n(&cell.sequence, __ATOMIC_ACQUIRE) != dequeuePos_ + 1) {
+            break;
+        }
+        emit(cell);
+        __atomic_store_n(&cell.sequence, dequeuePos_ + RING_SIZE, __ATOMIC_RELEASE);
+        ++dequeuePos_;
+        any = true;
+        if (out_.size() >= OUT_FLUSH_BYTES) {
+            writeOut();
+        }
+    }
+    return any;
+}
+
+void Logger::emit(const Record& record) {
+    if (sameLine(record, last_)) {
+        if (repeats_++ == 0) {
+            repeatSince_ = record.timeMs;
+        }
+        return;
+    }
+    flushRepeats(record.timeMs);
+    format(record, out_);
+    std::memcpy(&last_, &record, sizeof(last_));
+}
+
+// "last message repeated N times" for what emit() swallowed
+void Logger::flushRepeats(unsigned long long now) {
+    if (repeats_ == 0) return;
+    char text[64];
+    int n = std::snprintf(text, sizeof(text), "last message repeated %lu times", repeats_);
+    Record summary;
+    fill(summary, static_cast<Level>(last_.level), last_.component, -1, NULL, NULL,
+         text, static_cast<size_t>(n));
+    summary.timeMs = now;
+    format(summary, out_);
+    repeats_ = 0;
+}
+
+bool Logger::sameLine(const Record& a, const Record& b) {
+    return a.level == b.level && a.fd == b.fd && a.length == b.length
+        && std::memcmp(a.text, b.text, a.length) == 0
+        && std::strcmp(a.component, b.component) == 0
+        && std::strcmp(a.nick, b.nick) == 0
+        && std::strcmp(a.command, b.command) == 0;
+}
+
+// "2026-01-18 21:52:11.042 INFO  [Server] text fd=5 nick=Alice cmd=JOIN"
+void Logger::format(const Record& record, std::string& out) {
+    char stamp[64];
+    time_t seconds = static_cast<time_t>(record.timeMs / 1000);
+    struct tm tm;
+    localtime_r(&seconds, &tm);
+    size_t n = std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &tm);
+    n += std::snprintf(stamp + n, sizeof(stamp) - n, ".%03u %-5s [",
+                       static_cast<unsigned>(record.timeMs % 1000),
+                       levelName(static_cast<Level>(record.level)));
+    out.append(stamp, n);
+    out.append(record.component);
+    out.append("] ", 2);
+    out.append(record.text, record.length);
+    if (record.fd >= 0) {
+        n = std::snprintf(stamp, sizeof(stamp), " fd=%d", record.fd);
+        out.append(stamp, n);
+    }
+    if (record.nick[0]) {
+        out.append(" nick=", 6);
+        out.append(record.nick);
+    }
+    if (record.command[0]) {
+        out.append(" cmd=", 5);
+        out.append(record.command);
+    }
+    out.push_back('\n');
+}
+
+// One write(2) per batch; a slow terminal only stalls this thread
+void Logger::writeOut() {
+    size_t off = 0;
+    while (off < out_.size()) {
+        ssize_t n = write(fd_, out_.data() + off, out_.size() - off);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;      // nowhere to report it: drop the batch
+        }
+        off += static_cast<size_t>(n);
+    }
+    out_.clear();
+}
+
+void* Logger::threadMain(void* arg) {
+    Logger* self = static_cast<Logger*>(arg);
+    self->out_.reserve(OUT_FLUSH_BYTES * 2);
+
+    for (;;) {
+        bool stopping = __atomic_load_n(&self->stopping_, __ATOMIC_ACQUIRE);
+        bool any = self->drain();
+        unsigned long long now = wallMs();
+
+        if (self->repeats_ > 0 && (stopping || now - self->repeatSince_ >= REPEAT_REPORT_MS)) {
+            self->flushRepeats(now);
+            self->last_.level = -1;     // next one starts a new run
+        }
+        self->report("dropped (ring full)", self->dropped(), self->droppedReported_);
+        self->report("suppressed (rate limit)", rateLimited(), self->rateReported_);
+        self->writeOut();
+
+        if (!any) {
+            if (stopping) break;    // checked before the drain: nothing left
+            self->sleep();
+        }
+    }
+    return NULL;
+}
+
+// "N lines <what>" for a counter that moved since it was last reported
+void Logger::report(const char* what, unsigned long count, unsigned long& reported) {
+    if (count == reported) return;
+    char text[64];
+    int n = std::snprintf(text, sizeof(text), "%lu lines %s", count - reported, what);
+    Record record;
+    fill(record, LEVEL_WARN, "Logger", -1, NULL, NULL, text, static_cast<size_t>(n));
+    format(record, out_);
+    reported = count;
+}
+
+// ============================================================================
+// LogLine
+// ============================================================================
+
+LogLine::LogLine(Logger::Level level, const char* component, const LogFields& fields,
+                 unsigned long suppressed)
+    : level_(level), component_(component), fields_(fields), suppressed_(suppressed)
+    , buf_(text_, sizeof(text_)), stream_(&buf_) {}
+
+void LogLine::submit() {
+    if (suppressed_ > 0) {
+        stream_ << " (" << suppressed_ << " suppressed)";
+    }
+    Logger::instance().submit(level_, component_, fields_.fd, fields_.nick, fields_.command,
+                              text_, buf_.length());
+}
@@ -0,0 +1,102 @@
+// Membership implementation
+// Node pool and the per-channel Client* -> Membership* index
+
+#include "irc/Membership.hpp"
+#include "irc/SlabPool.hpp"
+
+// One pool for every channel: a client leaving #a and joining #b reuses
+// the same node
+static SlabPool<Membership, 256>& pool() {
+    static SlabPool<Membership, 256> instance;
+    return instance;
+}
+
+Membership* Membership::create(Client* client, Channel* channel) {
+    Membership* membership = pool().create();
+    membership->client = client;
+    membership->channel = channel;
+    membership->flags = 0;
+    membership->prevInChannel = NULL;
+    membership->nextInChannel = NULL;
+    membership->prevInClient = NULL;
+    membership->nextInClient = NULL;
+    membership->fanoutSlot = 0;
+    return membership;
+}
+
+void Membership::destroy(Membership* membership) {
+    pool().destroy(membership);
+}
+
+// ============================================================================
+// MembershipIndex
+// ============================================================================
+
+static const size_t INITIAL_SLOTS = 8;
+
+MembershipIndex::MembershipIndex() : slots_(INITIAL_SLOTS, static_cast<Membership*>(NULL)), count_(0) {}
+
+// Client objects are at least pointer aligned: drop the always-zero low
+// bits, then mix (Fibonacci hashing) so neighbours spread over the table
+size_t MembershipIndex::home(const Client* client) const {
+    size_t key = reinterpret_cast<size_t>(client) >> 3;
+    key *= static_cast<size_t>(0x9E3779B97F4A7C15ULL);
+    return (key >> 16) & (slots_.size() - 1);
+}
+
+Membership* MembershipIndex::find(const Client* client) const {
+    size_t mask = slots_.size() - 1;
+    for (size_t i = home(client); slots_[i]; i = (i + 1) & mask) {
+        if (slots_[i]->client == client) {
+            return slots_[i];
+        }
+    }
+    return NULL;
+}
+
+void MembershipIndex::insert(Membership* membership) {
+    if ((count_ + 1) * 2 > slots_.size()) {
+        grow();
+    }
+    size_t mask = slots_.size() - 1;
+    size_t i = home(membership->client);
+    while (slots_[i]) i = (i + 1) & mask;
+    slots_[i] = membership;
+    ++count_;
+}
+
+// Backward-shift deletion, as in IdentifierMap
+void MembershipIndex::remove(const Client* client) {
+    size_t mask = slots_.size() - 1;
+    size_t hole = home(client);
+    while (slots_[hole] && slots_[hole]->client != client) hole = (hole + 1) & mask;
+    if (!slots_[hole]) return;
+
+    size_t next = (hole + 1) & mask;
+    while (slots_[next]) {
+        size_t nextHome = home(slots_[next]->client);
+        if (((next - nextHome) & mask) >= ((next - hole) & mask)) {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    slots_[hole] = NULL;
+    --count_;
+}
+
+size_t MembershipIndex::size() const {
+    return count_;
+}
+
+void MembershipIndex::grow() {
+    std::vector<Membership*> old(slots_.size() * 2, static_cast<Membership*>(NULL));
+    old.swap(slots_);
+    size_t mask = slots_.size() - 1;
+    for (size_t i = 0; i < old.size(); ++i) {
+        if (!old[i]) continue;
+        size_t j = home(old[i]->client);
+        while (slots_[j]) j = (j + 1) & mask;
+        slots_[j] = old[i];
+    }
+}
@@ -11,70 +11,206 @@
 /* ************************************************************************** */
 
 #include "irc/MessageBuffer.hpp"
-#include <iostream>
+#include "irc/Scanner.hpp"
+#include "irc/Logger.hpp"
+#include <cstring>
 
-// Constructor - Initialize buffer_ as empty string
-MessageBuffer::MessageBuffer() : buffer_("") {}
+// Constructor - Allocate storage once, buffer starts empty
+MessageBuffer::MessageBuffer(size_t capacity)
+    : storage_(NULL), storageSize_(0), block_(NULL)
+    , owned_(capacity > 0 ? capacity : 1), capacity_(owned_.size())
+    , readPos_(0), writePos_(0)
+{
+    storage_ = &owned_[0];
+    storageSize_ = owned_.size();
+}
+
+// Constructor - Storage handed in, nothing allocated
+MessageBuffer::MessageBuffer(char* block, size_t capacity)
+    : storage_(block), storageSize_(capacity), block_(block)
+    , capacity_(capacity), readPos_(0), writePos_(0) {}
 
-// Destructor - No cleanup needed (string handles it)
+// Destructor - No cleanup needed (vector handles it)
 MessageBuffer::~MessageBuffer() {}
 
-// Method - append() data to buffer_
+// Method - append() data to buffer
+// - Compact, then grow storage_ only if the data still does not fit
 void MessageBuffer::append(const std::string& data)
 {
-    buffer_ += data;
+    append(data.data(), data.size());
+}
+
+void MessageBuffer::append(const char* data, size_t length)
+{
+    if (length == 0)
+        return;
+    if (storageSize_ - writePos_ < length)
+        compact();
+    if (storageSize_ - writePos_ < length)
+    {
+        // Grow on the heap (a block handed in stays where it is)
+        std::vector<char> grown(writePos_ + length);
+        if (writePos_ > 0)
+            std::memcpy(&grown[0], storage_, writePos_);
+        owned_.swap(grown);
+        storage_ = &owned_[0];
+        storageSize_ = owned_.size();
+    }
+    std::memcpy(&storage_[writePos_], data, length);
+    writePos_ += length;
+}
+
+// Method - writableData() - free tail for recv(), compacts when it is short
+char* MessageBuffer::writableData()
+{
+    if (readPos_ > 0 && storageSize_ - writePos_ < storageSize_ / 2)
+        compact();
+    return &storage_[0] + writePos_;
+}
+
+// Method - writableSize() - bytes recv() may write at writableData()
+size_t MessageBuffer::writableSize() const
+{
+    return storageSize_ - writePos_;
+}
+
+// Method - commitWrite() - make bytes written by recv() part of the buffer
+void MessageBuffer::commitWrite(size_t length)
+{
+    if (length > writableSize())
+        length = writableSize();
+    writePos_ += length;
+}
+
+// Method - nextLine()
+// - Find next "\r\n" after readPos_
+// - Point line at the message, without "\r\n"
+// - Advance readPos_ past it (nothing is copied or erased)
+bool MessageBuffer::nextLine(char*& line, size_t& length)
+{
+    size_t pos = findMessageEnd();
+    if (pos == std::string::npos)
+        return false;
+    line = &storage_[readPos_];
+    length = pos;
+    readPos_ += pos + 2;
+    // Everything consumed: rewind for free, no memmove needed
+    if (readPos_ == writePos_)
+        readPos_ = writePos_ = 0;
+    return true;
+}
+
+bool MessageBuffer::nextLine(char*& line, size_t& length, LineIndex& index)
+{
+    if (readPos_ == writePos_)
+        return false;
+    size_t pos = Scanner::scanLine(&storage_[readPos_], writePos_ - readPos_, index);
+    if (pos == static_cast<size_t>(-1))
+        return false;
+    line = &storage_[readPos_];
+    length = pos;
+    readPos_ += pos + 2;
+    if (readPos_ == writePos_)
+        readPos_ = writePos_ = 0;
+    return true;
+}
+
+bool MessageBuffer::nextLine(const char*& line, size_t& length)
+{
+    char* writable;
+    if (!nextLine(writable, length))
+        return false;
+    line = writable;
+    return true;
 }
 
 // Method - extractMessages()
 // - Find all complete messages (ending with \r\n)
 // - Extract each complete message
-// - Remove extracted messages from buffer_
+// - Advance past extracted messages
 // - Return vector of complete message strings
-// - Keep incomplete data in buffer_ for next append
+// - Keep incomplete data in buffer for next append
 std::vector<std::string> MessageBuffer::extractMessages()
 {
     std::vector<std::string> messages;
-    size_t pos;
+    const char* line;
+    size_t length;
 
-    while ((pos = findMessageEnd()) != std::string::npos)
+    while (nextLine(line, length))
     {
         // Extract message without \r\n
-        std::string msg = buffer_.substr(0, pos);
-        messages.push_back(msg);
-        // Remove message with \r\n (pos points to \r, +2 covers \r\n)
-        buffer_.erase(0, pos + 2); 
+        messages.push_back(std::string(line, length));
 
-        std::cout << "[MessageBuffer] Extracted: \"" << msg << "\"" << std::endl;
+        IRC_LOG_DEBUG("MessageBuffer", LogFields(), "Extracted: \"" << messages.back() << "\"");
     }
     return messages;
 }
 
-// Method - getBuffer() - return const reference to buffer_
-const std::string& MessageBuffer::getBuffer() const
+// Method - getBuffer() - copy of the unread bytes
+std::string MessageBuffer::getBuffer() const
 {
-    return buffer_;
+    if (readPos_ == writePos_)
+        return std::string();
+    return std::string(&storage_[readPos_], writePos_ - readPos_);
 }
 
-// Method - clear() - clear buffer_ string
+// Method - clear() - drop unread bytes, keep storage
 void MessageBuffer::clear() 
 {
-    buffer_.clear();
+    readPos_ = 0;
+    writePos_ = 0;
 }
 
-// Method - isEmpty() - return buffer_.empty()
+// Method - isEmpty() - no unread bytes
 bool MessageBuffer::isEmpty() const
 {
-    return buffer_.empty();
+    return readPos_ == writePos_;
 }
 
-// Method - size() - return buffer_.size()
+// Method - size() - number of unread bytes
 size_t MessageBuffer::size() const 
 {
-    return buffer_.size();
+    return writePos_ - readPos_;
+}
+
+// Method - data() - first unread byte
+const char* MessageBuffer::data() const
+{
+    return &storage_[0] + readPos_;
+}
+
+// Method - capacity() - configured size
+size_t MessageBuffer::capacity() const
+{
+    return capacity_;
+}
+
+// Method - block() - storage handed to the constructor
+char* MessageBuffer::block() const
+{
+    return block_;
 }
 
 // Method - findMessageEnd(size_t startPos) - helper method to find next "\r\n" starting from startPos
+// (offsets relative to readPos_, vectorized search in Scanner)
 size_t MessageBuffer::findMessageEnd(size_t startPos) const
 {
-    return buffer_.find("\r\n", startPos);
+    size_t length = writePos_ - readPos_;
+    if (startPos >= length)
+        return std::string::npos;
+
+    size_t pos = Scanner::findLineEnd(&storage_[0] + readPos_ + startPos, length - startPos);
+    return (pos == static_cast<size_t>(-1)) ? std::string::npos : startPos + pos;
+}
+
+// Method - compact() - move unread bytes to the front of storage_
+void MessageBuffer::compact()
+{
+    if (readPos_ == 0)
+        return;
+    size_t unread = writePos_ - readPos_;
+    if (unread > 0)
+        std::memmove(&storage_[0], &storage_[readPos_], unread);
+    readPos_ = 0;
+    writePos_ = unread;
 }
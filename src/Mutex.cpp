@@ -0,0 +1,34 @@
+// Mutex implementation
+// pthread mutex + RAII lock guard
+
+#include "irc/Mutex.hpp"
+
+Mutex::Mutex(bool recursive) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    if (recursive) {
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    }
+    pthread_mutex_init(&mutex_, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+Mutex::~Mutex() {
+    pthread_mutex_destroy(&mutex_);
+}
+
+void Mutex::lock() {
+    pthread_mutex_lock(&mutex_);
+}
+
+void Mutex::unlock() {
+    pthread_mutex_unlock(&mutex_);
+}
+
+ScopedLock::ScopedLock(Mutex& mutex) : mutex_(mutex) {
+    mutex_.lock();
+}
+
+ScopedLock::~ScopedLock() {
+    mutex_.unlock();
+}
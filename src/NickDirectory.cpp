@@ -0,0 +1,52 @@
+// NickDirectory implementation
+// Uniqueness rules on top of IdentifierMap
+
+#include "irc/NickDirectory.hpp"
+
+NickDirectory::NickDirectory() {}
+
+NickDirectory::~NickDirectory() {}
+
+Client* NickDirectory::find(const Identifier& nick) const {
+    return nicks_.find(nick);
+}
+
+Client* NickDirectory::find(const std::string& nickname) const {
+    return nicks_.find(Identifier::find(nickname));
+}
+
+bool NickDirectory::insert(const Identifier& nick, Client* client) {
+    if (nick.empty()) return false;
+
+    Client* holder = nicks_.insert(nick, client);
+    return holder == NULL || holder == client;
+}
+
+bool NickDirectory::rename(Client* client, const Identifier& oldNick, const Identifier& newNick) {
+    if (newNick.empty()) return false;
+
+    Client* holder = nicks_.find(newNick);
+    if (holder && holder != client) {
+        return false;
+    }
+    // Same folded nick (case change only): entry already right
+    if (oldNick == newNick) {
+        return true;
+    }
+    remove(oldNick, client);
+    return insert(newNick, client);
+}
+
+void NickDirectory::remove(const Identifier& nick, Client* client) {
+    if (nicks_.find(nick) == client) {
+        nicks_.remove(nick);
+    }
+}
+
+size_t NickDirectory::size() const {
+    return nicks_.size();
+}
+
+size_t NickDirectory::capacity() const {
+    return nicks_.capacity();
+}
@@ -12,7 +12,10 @@
 
 #include "irc/Parser.hpp"
 #include "irc/Command.hpp"
+#include "irc/Scanner.hpp"
 #include <iostream>
+#include <cstring>
+#include <cctype>
 
 // Constructor
 Parser::Parser() {}
@@ -20,89 +23,159 @@ Parser::Parser() {}
 // Deconstructor
 Parser::~Parser() {}
 
-// Method - parse() - main parsing logic:
+// Method - parse() - owning variant
+// - Parse a copy of the line into a view, copy the view into cmd
+// - raw keeps the message as received
 bool Parser::parse(const std::string& message, Command& cmd)
 {
 	std::string line = message;
-	size_t pos = 0;
+	CommandView view;
 
-    // 1. Reset command structure
-    cmd.raw = message;
-    cmd.prefix = "";
-    cmd.command = "";
-    cmd.params.clear();
-    cmd.trailing = "";
+	// 1. Reset command structure
+	cmd.raw = message;
+	cmd.id = CMD_UNKNOWN;
+	cmd.prefix = "";
+	cmd.command = "";
+	cmd.params.clear();
+	cmd.trailing = "";
 
-    // 2. Remove trailing \r\n
-    if (line.length() > 1 && line[line.length() - 2] == '\r' && line[line.length() - 1] == '\n')
-        line.erase(line.length() - 2);
-    else if (!line.empty() && line[line.length() - 1] == '\n')
-        line.erase(line.length() - 1);
+	if (line.empty())
+		return false;
+	if (!parse(&line[0], line.length(), view))
+		return false;
+	toCommand(view, cmd);
+	cmd.raw = message;
+	return true;
+}
 
-    if (line.empty()) return false;
+// Method - parse() - zero-copy, line not indexed yet
+bool Parser::parse(char* line, size_t length, CommandView& view)
+{
+	LineIndex index;
 
-    // Skip leading spaces
-    while (pos < line.length() && line[pos] == ' ')
-        pos++;
-    if (pos >= line.length()) return false;
+	// Ignore trailing \r\n
+	if (length > 1 && line[length - 2] == '\r' && line[length - 1] == '\n')
+		length -= 2;
+	else if (length > 0 && line[length - 1] == '\n')
+		length -= 1;
+	Scanner::indexLine(line, length, index);
+	return parse(line, length, index, view);
+}
 
-    // 3. Prefix (starts with :)
-    if (line[pos] == ':')
+// Method - parse() - zero-copy parsing logic:
+// - Scanner found the spaces already, findSpace() walks that index
+bool Parser::parse(char* line, size_t length, const LineIndex& index, CommandView& view)
+{
+	size_t pos = 0;
+	size_t cursor = 0;
+
+	// 1. Reset view
+	view = CommandView();
+	view.raw = StringRef(line, length);
+
+	if (length == 0) return false;
+
+	// Skip leading spaces
+	while (pos < length && line[pos] == ' ')
+		pos++;
+	if (pos >= length) return false;
+
+	// 3. Prefix (starts with :)
+	if (line[pos] == ':')
 	{
-        size_t end = line.find(' ', pos);
+		size_t end = findSpace(index, cursor, line, pos, length);
 		// Invalid: Prefix but no command
-        if (end == std::string::npos)
+		if (end == length)
 			return false;
-        cmd.prefix = line.substr(pos + 1, end - pos - 1);
-        pos = end + 1;
-        // Skip spaces
-        while (pos < line.length() && line[pos] == ' ')
+		view.prefix = StringRef(line + pos + 1, end - pos - 1);
+		pos = end + 1;
+		// Skip spaces
+		while (pos < length && line[pos] == ' ')
 			pos++;
-    }
+	}
 
-    // 4. Command
+	// 4. Command
 	// Invalid: No command
-    if (pos >= line.length())
+	if (pos >= length)
 		return false;
-    
-    size_t end = line.find(' ', pos);
-    if (end == std::string::npos) 
-	{
-        cmd.command = line.substr(pos);
-        pos = line.length();
-    }
-	else
-	{
-        cmd.command = line.substr(pos, end - pos);
-        pos = end + 1;
-    }
-    
-    // Normalize command to uppercase
-    for (size_t i = 0; i < cmd.command.length(); ++i)
-	{
-        cmd.command[i] = std::toupper(cmd.command[i]);
-    }
 
-    // 5. Params & Trailing
-    while (pos < line.length())
+	size_t end = findSpace(index, cursor, line, pos, length);
+	view.command = StringRef(line + pos, end - pos);
+	pos = (end == length) ? length : end + 1;
+
+	// Normalize command to uppercase (in place)
+	for (size_t i = 0; i < view.command.length; ++i)
+		line[view.command.data - line + i] = std::toupper(static_cast<unsigned char>(view.command.data[i]));
+	view.id = commandIdFromName(view.command.data, view.command.length);
+
+	// 5. Params & Trailing (empty params between spaces are kept, Halloy)
+	while (pos < length)
 	{
-        // Check for trailing parameter (starts with :)
-        if (line[pos] == ':')
+		// Check for trailing parameter (starts with :)
+		if (line[pos] == ':')
 		{
-            cmd.trailing = line.substr(pos + 1);
-            break; // Trailing consumes the rest of the line
-        }
-        
-        // Regular parameter
-        end = line.find(' ', pos);
-        if (end == std::string::npos)
+			view.trailing = StringRef(line + pos + 1, length - pos - 1);
+			break; // Trailing consumes the rest of the line
+		}
+
+		// Regular parameter
+		end = findSpace(index, cursor, line, pos, length);
+		if (view.paramCount < CommandView::MAX_PARAMS)
+			view.params[view.paramCount++] = StringRef(line + pos, end - pos);
+		if (end == length)
+			break;
+		pos = end + 1;
+	}
+	return true;
+}
+
+// Method - toCommand() - copy views into an owning Command
+// - params grows/shrinks by swapping strings with spareParams, not by
+//   constructing/destroying them: a reused Command stops allocating
+// - spareParams reserved up front: growing it would copy (C++98) the
+//   parked strings into new buffers
+void Parser::toCommand(const CommandView& view, Command& cmd)
+{
+	cmd.id = view.id;
+	cmd.prefix.assign(view.prefix.data, view.prefix.length);
+	cmd.command.assign(view.command.data, view.command.length);
+	if (cmd.spareParams.capacity() < cmd.params.capacity())
+		cmd.spareParams.reserve(cmd.params.capacity());
+	while (cmd.params.size() > view.paramCount)
+	{
+		cmd.spareParams.push_back(std::string());
+		cmd.spareParams.back().swap(cmd.params.back());
+		cmd.params.pop_back();
+	}
+	while (cmd.params.size() < view.paramCount)
+	{
+		cmd.params.push_back(std::string());
+		if (!cmd.spareParams.empty())
 		{
-            cmd.params.push_back(line.substr(pos));
-            break;
-        }
-        cmd.params.push_back(line.substr(pos, end - pos));
-        pos = end + 1;
-    }
-
-    return true;
+			cmd.params.back().swap(cmd.spareParams.back());
+			cmd.spareParams.pop_back();
+		}
+	}
+	for (size_t i = 0; i < view.paramCount; ++i)
+		cmd.params[i].assign(view.params[i].data, view.params[i].length);
+	cmd.trailing.assign(view.trailing.data, view.trailing.length);
+	cmd.raw.assign(view.raw.data, view.raw.length);
+}
+
+// Helper - findSpace() - next ' ' in [pos, length), length if none
+// - cursor only moves forward (pos never decreases within one line)
+// - Past index.indexedEnd (":prefix :cmd ..." lines, more than MAX_SPACES spaces)
+//   fall back to memchr
+size_t Parser::findSpace(const LineIndex& index, size_t& cursor,
+	const char* line, size_t pos, size_t length)
+{
+	while (cursor < index.spaceCount && index.spaces[cursor] < pos)
+		cursor++;
+	if (cursor < index.spaceCount)
+		return index.spaces[cursor];
+	if (index.indexedEnd >= length)
+		return length;
+	size_t from = (pos > index.indexedEnd) ? pos : index.indexedEnd;
+	const void* space = std::memchr(line + from, ' ', length - from);
+	return space ? static_cast<size_t>(static_cast<const char*>(space) - line) : length;
 }
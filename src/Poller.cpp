@@ -4,94 +4,452 @@
 
 #include "irc/Poller.hpp"
 #include "irc/Server.hpp"
+#include "irc/Logger.hpp"
 #include <algorithm>
 #include <poll.h>
-#include <iostream>
 #include <cerrno>
 #include <cstring>
+#include <unistd.h>
+
+// io_uring sizing: SQ entries and provided recv buffers (count x size)
+#define URING_ENTRIES       1024
+#define URING_BUFFER_COUNT  1024
+#define URING_BUFFER_SIZE   4096
+
+// io_uring user_data layout: op (8 bits) | generation (24 bits) | fd (32 bits)
+// The generation catches completions that belong to a previous owner of a fd
+enum UringOp {
+    URING_OP_ACCEPT = 1,
+    URING_OP_RECV = 2,
+    URING_OP_CANCEL = 3,
+    URING_OP_POLLOUT = 4,
+    URING_OP_SEND = 5
+};
+
+// fdEvents_ bit (uring only, never in the public masks): a multishot recv is
+// in flight. Differs from POLLIN while a cancel or rearm is pending
+static const short URING_RECV_ARMED = 0x4000;
+
+static unsigned long long uringData(int op, int generation, int fd) {
+    return (static_cast<unsigned long long>(op) << 56)
+        | (static_cast<unsigned long long>(generation & 0xFFFFFF) << 32)
+        | static_cast<unsigned int>(fd);
+}
+
+#ifdef __LINUX__
+// Translate the POLL* masks of the public interface to EPOLL* masks and back
+static unsigned int toEpollEvents(short events) {
+    unsigned int result = 0;
+    if (events & POLLIN)  result |= EPOLLIN;
+    if (events & POLLPRI) result |= EPOLLPRI;
+    if (events & POLLOUT) result |= EPOLLOUT;
+    return result;
+}
+
+static short fromEpollEvents(unsigned int events) {
+    short result = 0;
+    if (events & EPOLLIN)  result |= POLLIN;
+    if (events & EPOLLPRI) result |= POLLPRI;
+    if (events & EPOLLOUT) result |= POLLOUT;
+    if (events & EPOLLERR) result |= POLLERR;
+    if (events & EPOLLHUP) result |= POLLHUP;
+    return result;
+}
+#endif
 
 // DONE: Implement Poller::Poller(Server* server)
-Poller::Poller(Server* server) : server_(server) {
+Poller::Poller(Server* server, Backend backend, bool edgeTriggered)
+    : server_(server), backend_(backend), edgeTriggered_(edgeTriggered), watched_(0), epollFd_(-1)
+    , uring_(NULL), generation_(0) {
     pollfds_.reserve(64); // Reserve space for 64 file descriptors
-    std::cout << "[Poller] Initialized" << std::endl;
+    ready_.reserve(64);
+
+#ifdef __LINUX__
+    if (backend_ == BACKEND_URING) {
+        uring_ = new IoUring();
+        if (!uring_->init(URING_ENTRIES, URING_BUFFER_COUNT, URING_BUFFER_SIZE)) {
+            IRC_LOG_WARN("Poller", LogFields(), "io_uring unavailable, falling back to epoll");
+            delete uring_;
+            uring_ = NULL;
+            backend_ = BACKEND_EPOLL;
+        } else {
+            completions_.reserve(URING_ENTRIES);
+        }
+    }
+    if (backend_ == BACKEND_EPOLL) {
+        epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd_ < 0) {
+            IRC_LOG_ERROR("Poller", LogFields(), "epoll_create1() failed: " << strerror(errno)
+                        << ", falling back to poll()");
+            backend_ = BACKEND_POLL;
+        } else {
+            epollEvents_.resize(64);
+        }
+    }
+#else
+    backend_ = BACKEND_POLL;
+#endif
+    if (edgeTriggered_ && backend_ != BACKEND_EPOLL) {
+        IRC_LOG_WARN("Poller", LogFields(), "edge-triggered mode needs epoll, using level-triggered "
+                    << backendName(backend_));
+        edgeTriggered_ = false;
+    }
+    IRC_LOG_INFO("Poller", LogFields(), "Initialized (backend=" << backendName(backend_)
+                << (edgeTriggered_ ? ", edge-triggered" : "") << ")");
 }
 
 // DONE: Implement Poller::~Poller()
 Poller::~Poller() {
-    std::cout << "[Poller] Destroyed" << std::endl;
+    delete uring_;
+    if (epollFd_ >= 0) {
+        close(epollFd_);
+    }
+    IRC_LOG_INFO("Poller", LogFields(), "Destroyed");
 }
 
 // DONE: Implement Poller::addFd(int fd, short events)
 void Poller::addFd(int fd, short events) {
     // Check if fd already exists
     if (findFdIndex(fd) != -1) {
-        std::cerr << "[Poller] WARNING: fd=" << fd 
-                    << " already exists!" << std::endl;
+        IRC_LOG_WARN("Poller", LogFields(fd), "already exists!");
         return;
     }
-    
+
+#ifdef __LINUX__
+    if (backend_ == BACKEND_URING) {
+        // Completion backend: readiness mask is implied (accept or recv)
+        generation_ = (generation_ + 1) & 0xFFFFFF;
+        if (generation_ == 0) generation_ = 1;
+        setFdIndex(fd, static_cast<int>(generation_));
+        setFdEvents(fd, POLLIN);
+        armUring(fd, static_cast<int>(generation_));
+        ++watched_;
+        if (events & POLLOUT) {
+            modifyFd(fd, events);
+        }
+        IRC_LOG_DEBUG("Poller", LogFields(fd), "Added");
+        return;
+    }
+    if (backend_ == BACKEND_EPOLL) {
+        struct epoll_event ev;
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = toEpollEvents(events);
+        if (edgeTriggered_) ev.events |= EPOLLET;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            IRC_LOG_ERROR("Poller", LogFields(fd), "epoll_ctl(ADD) failed: " << strerror(errno));
+            return;
+        }
+        setFdIndex(fd, 0);  // epoll keeps the interest list, we only mark fd as watched
+        setFdEvents(fd, events);
+        ++watched_;
+        IRC_LOG_DEBUG("Poller", LogFields(fd), "Added");
+        return;
+    }
+#endif
+
     struct pollfd pfd;
     pfd.fd = fd;
     pfd.events = events;
     pfd.revents = 0;
     pollfds_.push_back(pfd);
+    setFdIndex(fd, static_cast<int>(pollfds_.size() - 1));
+    ++watched_;
 
-    std::cout << "[Poller] Added fd=" << fd << std::endl;
+    IRC_LOG_DEBUG("Poller", LogFields(fd), "Added");
 }
 
 // DONE: Implement Poller::removeFd(int fd)
+// poll backend: swap with last entry and pop, O(1) instead of vector::erase()
 void Poller::removeFd(int fd) {
     int index = findFdIndex(fd);
-    if (index != -1) {
-        pollfds_.erase(pollfds_.begin() + index);
-        std::cout << "[Poller] Removed fd=" << fd << std::endl;
-    } else {
-        std::cerr << "[Poller] WARNING: fd=" << fd << " not found!" << std::endl;
+    if (index == -1) {
+        IRC_LOG_WARN("Poller", LogFields(fd), "not found!");
+        return;
+    }
+
+#ifdef __LINUX__
+    if (backend_ == BACKEND_URING) {
+        // In-flight requests hold a file reference until they are cancelled:
+        // the cancels go out with the next poll() (no syscall per removal),
+        // the socket really closes then. Late completions carry the old
+        // generation and are dropped, even if the fd number is reused
+        int op = (fd == server_->getServerFd()) ? URING_OP_ACCEPT : URING_OP_RECV;
+        uring_->prepCancel(uringData(op, index, fd), uringData(URING_OP_CANCEL, index, fd));
+        if (getFdEvents(fd) & POLLOUT) {
+            uring_->prepCancel(uringData(URING_OP_POLLOUT, index, fd),
+                                uringData(URING_OP_CANCEL, index, fd));
+        }
+        setFdEvents(fd, 0);
+        setFdIndex(fd, -1);
+        --watched_;
+        IRC_LOG_DEBUG("Poller", LogFields(fd), "Removed");
+        return;
+    }
+    if (backend_ == BACKEND_EPOLL) {
+        // fd may already be closed by the caller, kernel dropped it then
+        if (epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, NULL) < 0 && errno != EBADF) {
+            IRC_LOG_ERROR("Poller", LogFields(fd), "epoll_ctl(DEL) failed: " << strerror(errno));
+        }
+        setFdIndex(fd, -1);
+        setFdEvents(fd, 0);
+        --watched_;
+        IRC_LOG_DEBUG("Poller", LogFields(fd), "Removed");
+        return;
+    }
+#endif
+
+    size_t last = pollfds_.size() - 1;
+    if (static_cast<size_t>(index) != last) {
+        pollfds_[index] = pollfds_[last];
+        setFdIndex(pollfds_[index].fd, index);
+    }
+    pollfds_.pop_back();
+    setFdIndex(fd, -1);
+    --watched_;
+    IRC_LOG_DEBUG("Poller", LogFields(fd), "Removed");
+}
+
+// DONE: Poller::modifyFd(int fd, short events)
+// - poll:  rewrite pollfds_[index].events
+// - epoll: EPOLL_CTL_MOD
+// - uring: dropping POLLIN cancels the multishot recv (reading paused by
+//          Server's sendq backpressure), adding it back rearms it once the
+//          old request is gone. POLLOUT queues a one-shot poll request; its
+//          completion clears the bit again, so a Server that still has
+//          data pending calls modifyFd() once more to re-arm it
+void Poller::modifyFd(int fd, short events) {
+    int index = findFdIndex(fd);
+    if (index == -1) {
+        IRC_LOG_WARN("Poller", LogFields(fd), "modify of unknown fd");
+        return;
+    }
+
+#ifdef __LINUX__
+    if (backend_ == BACKEND_URING) {
+        short current = getFdEvents(fd);
+        if ((events & POLLIN) && !(current & POLLIN)) {
+            current |= POLLIN;
+            setFdEvents(fd, current);
+            if (!(current & URING_RECV_ARMED)) {
+                armUring(fd, index);
+            }
+        } else if (!(events & POLLIN) && (current & POLLIN)) {
+            current &= ~POLLIN;
+            setFdEvents(fd, current);
+            uring_->prepCancel(uringData(URING_OP_RECV, index, fd),
+                                uringData(URING_OP_CANCEL, index, fd));
+        }
+        current = getFdEvents(fd);
+        if ((events & POLLOUT) && !(current & POLLOUT)) {
+            uring_->prepPollAdd(fd, POLLOUT, uringData(URING_OP_POLLOUT, index, fd));
+            setFdEvents(fd, current | POLLOUT);
+        }
+        // Clearing POLLOUT: the pending one-shot request just completes later
+        return;
     }
+    if (backend_ == BACKEND_EPOLL) {
+        if (getFdEvents(fd) == events) return;
+        // MOD re-checks readiness, so resuming POLLIN in edge-triggered
+        // mode reports input that arrived while it was paused
+        struct epoll_event ev;
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = toEpollEvents(events);
+        if (edgeTriggered_) ev.events |= EPOLLET;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &ev) < 0) {
+            IRC_LOG_ERROR("Poller", LogFields(fd), "epoll_ctl(MOD) failed: " << strerror(errno));
+            return;
+        }
+        setFdEvents(fd, events);
+        return;
+    }
+#endif
+
+    pollfds_[index].events = events;
 }
 
 // DONE: Implement Poller::poll(int timeout)
 // ONLY PLACE poll() IS CALLED - see TEAM_CONVENTIONS.md
+// Fills ready_ with the fds that have pending events
+// (plus markReadable() fds: those make the call non-blocking)
 int Poller::poll(int timeout) {
-    if (pollfds_.empty()) {
+    ready_.clear();
+    completions_.clear();
+    if (watched_ == 0) {
         return 0;
     }
-    
+
+#ifdef __LINUX__
+    if (backend_ == BACKEND_URING) {
+        return pollWithUring(timeout);
+    }
+    if (backend_ == BACKEND_EPOLL) {
+        int ready = pollWithEpoll(pendingReads_.empty() ? timeout : 0);
+        return ready + addPendingReads();
+    }
+#endif
+    return pollWithPoll(timeout);
+}
+
+// DONE: Poller::markReadable(int fd)
+void Poller::markReadable(int fd) {
+    if (edgeTriggered_) {
+        pendingReads_.push_back(fd);
+    }
+}
+
+// Append markReadable() fds still watched for POLLIN (not removed, reading
+// not paused) to ready_, merged into an existing entry of the same fd
+int Poller::addPendingReads() {
+    int added = 0;
+    for (size_t i = 0; i < pendingReads_.size(); ++i) {
+        int fd = pendingReads_[i];
+        if (findFdIndex(fd) == -1 || !(getFdEvents(fd) & POLLIN)) continue;
+
+        size_t j = 0;
+        while (j < ready_.size() && ready_[j].fd != fd) ++j;
+        if (j < ready_.size()) {
+            ready_[j].revents |= POLLIN;
+            continue;
+        }
+        ReadyEvent ev;
+        ev.fd = fd;
+        ev.revents = POLLIN;
+        ready_.push_back(ev);
+        ++added;
+    }
+    pendingReads_.clear();
+    return added;
+}
+
+int Poller::pollWithPoll(int timeout) {
     int ready = ::poll(&pollfds_[0], pollfds_.size(), timeout);  // Call global poll()
     if (ready < 0) {
         if (errno == EINTR) {
             return 0;  // Signal interrupt - normal
         }
-        std::cerr << "[Poller] poll() error: " << strerror(errno) << std::endl;
+        IRC_LOG_ERROR("Poller", LogFields(), "poll() error: " << strerror(errno));
+        return 0;
+    }
+
+    // poll() only reports a count, the scan is unavoidable with this backend
+    for (size_t i = 0; i < pollfds_.size() && ready_.size() < static_cast<size_t>(ready); ++i) {
+        if (pollfds_[i].revents == 0) continue;
+        ReadyEvent ev;
+        ev.fd = pollfds_[i].fd;
+        ev.revents = pollfds_[i].revents;
+        ready_.push_back(ev);
+    }
+    return ready;
+}
+
+int Poller::pollWithEpoll(int timeout) {
+#ifdef __LINUX__
+    int ready = epoll_wait(epollFd_, &epollEvents_[0],
+                            static_cast<int>(epollEvents_.size()), timeout);
+    if (ready < 0) {
+        if (errno == EINTR) {
+            return 0;  // Signal interrupt - normal
+        }
+        IRC_LOG_ERROR("Poller", LogFields(), "epoll_wait() error: " << strerror(errno));
         return 0;
     }
+
+    for (int i = 0; i < ready; ++i) {
+        ReadyEvent ev;
+        ev.fd = epollEvents_[i].data.fd;
+        ev.revents = fromEpollEvents(epollEvents_[i].events);
+        ready_.push_back(ev);
+    }
+
+    // Output array was full: grow it so the next wakeup can report more fds
+    if (static_cast<size_t>(ready) == epollEvents_.size()) {
+        epollEvents_.resize(epollEvents_.size() * 2);
+    }
     return ready;
+#else
+    (void)timeout;
+    return 0;
+#endif
+}
+
+// io_uring: one io_uring_enter() submits every SQE queued since the last
+// call (rearms, cancels) and reaps completions
+int Poller::pollWithUring(int timeout) {
+#ifdef __LINUX__
+    return uring_->submitAndWait(timeout, completions_);
+#else
+    (void)timeout;
+    return 0;
+#endif
+}
+
+// uring: queue a sendmsg for fd, submitted by the next poll() in the same
+// io_uring_enter() as every other queued SQE (the flush phase of one loop
+// iteration costs one syscall, not one writev() per connection)
+bool Poller::submitSend(int fd, const struct iovec* iov, int count) {
+#ifdef __LINUX__
+    if (backend_ != BACKEND_URING) return false;
+    int index = findFdIndex(fd);
+    if (index == -1) return false;
+    return uring_->prepSend(fd, iov, count, uringData(URING_OP_SEND, index, fd));
+#else
+    (void)fd;
+    (void)iov;
+    (void)count;
+    return false;
+#endif
+}
+
+void Poller::submitPending() {
+#ifdef __LINUX__
+    if (backend_ == BACKEND_URING) {
+        uring_->submit();
+    }
+#endif
+}
+
+bool Poller::canSubmitSends() const {
+#ifdef __LINUX__
+    return backend_ == BACKEND_URING && uring_->canSend();
+#else
+    return false;
+#endif
 }
 
 // DONE: Implement Poller::processEvents()
+// Walks the ready list only (not every watched fd)
 void Poller::processEvents() {
+    if (backend_ == BACKEND_URING) {
+        processCompletions();
+        return;
+    }
+
     int serverFd = server_->getServerFd();
+    int wakeFd = server_->getWakeFd();
+
+    for (size_t i = 0; i < ready_.size(); ++i) {
+        int fd = ready_[i].fd;
+        short revents = ready_[i].revents;
+
+        // fd removed by an earlier handler in this same pass
+        if (findFdIndex(fd) == -1) continue;
+
+        IRC_LOG_DEBUG("Poller", LogFields(fd), "revents=0x" << std::hex << revents << std::dec
+                    << ((revents & POLLIN) ? " POLLIN" : "")
+                    << ((revents & POLLHUP) ? " POLLHUP" : "")
+                    << ((revents & POLLERR) ? " POLLERR" : "")
+                    << ((revents & POLLOUT) ? " POLLOUT" : ""));
 
-    for (size_t i = 0; i < pollfds_.size(); ++i) {
-        int fd = pollfds_[i].fd;
-        short revents = pollfds_[i].revents;
-        
-        if (revents == 0) continue;
-        
-        std::cout << "[Poller] fd=" << fd << " revents=0x" 
-                    << std::hex << revents << std::dec;
-        
-        // Log events
-        if (revents & POLLIN)  std::cout << " POLLIN";
-        if (revents & POLLHUP) std::cout << " POLLHUP";
-        if (revents & POLLERR) std::cout << " POLLERR";
-        std::cout << std::endl;
-        
         if (fd == serverFd) {
             // New connection on server socket
             if (revents & POLLIN) {
                 server_->handleNewConnection();
             }
+        } else if (fd == wakeFd) {
+            // Another reactor posted mail for this one
+            server_->handleWakeup();
         } else {
             // Client socket: process POLLIN or POLLHUP
             if (revents & (POLLIN | POLLHUP)) {
@@ -100,53 +458,205 @@ void Poller::processEvents() {
             }
             // POLLERR: critical socket error
             else if (revents & POLLERR) {
-                std::cerr << "[Poller] POLLERR on fd=" << fd << std::endl;
+                IRC_LOG_WARN("Poller", LogFields(fd), "POLLERR");
+                server_->disconnectClient(fd);
+            }
+            // POLLOUT: socket has room again, drain the SendQueue
+            // (input handling above may have disconnected the client)
+            if ((revents & POLLOUT) && findFdIndex(fd) != -1) {
+                server_->handleClientOutput(fd);
+            }
+        }
+    }
+}
+
+// DONE: Poller::processCompletions() - uring backend
+// - ACCEPT: result is the new client fd -> Server::acceptConnection()
+// - RECV:   result is a byte count in a provided buffer -> Server::handleClientData(),
+//           0 is EOF, negative is an error -> Server::disconnectClient()
+// - POLLOUT: one-shot writability -> Server::handleClientOutput()
+// - SEND:   bytes sent (or -errno) of a submitSend() -> Server::handleSendComplete()
+// - multishot requests without IORING_CQE_F_MORE ended and are rearmed
+void Poller::processCompletions() {
+#ifdef __LINUX__
+    for (size_t i = 0; i < completions_.size(); ++i) {
+        const IoUring::Completion& c = completions_[i];
+        int op = static_cast<int>(c.userData >> 56);
+        int generation = static_cast<int>((c.userData >> 32) & 0xFFFFFF);
+        int fd = static_cast<int>(c.userData & 0xFFFFFFFFULL);
+        bool current = (findFdIndex(fd) == generation);
+
+        if (op == URING_OP_CANCEL) continue;
+
+        if (op == URING_OP_SEND) {
+            if (current) server_->handleSendComplete(fd, c.result);
+            continue;
+        }
+
+        if (op == URING_OP_POLLOUT) {
+            if (!current) continue;
+            setFdEvents(fd, getFdEvents(fd) & ~POLLOUT);
+            if (c.result >= 0) {
+                server_->handleClientOutput(fd);
+            } else if (c.result != -ECANCELED) {
+                IRC_LOG_ERROR("Poller", LogFields(fd), "poll completion error: " << strerror(-c.result));
                 server_->disconnectClient(fd);
             }
+            continue;
+        }
+
+        if (op == URING_OP_ACCEPT) {
+            if (c.result >= 0) {
+                if (current) {
+                    server_->acceptConnection(c.result);
+                } else {
+                    close(c.result);  // listening socket already removed
+                }
+            } else if (c.result != -ECANCELED) {
+                IRC_LOG_ERROR("Poller", LogFields(), "accept completion error: " << strerror(-c.result));
+            }
+            if (current && !IoUring::hasMore(c)) {
+                armUring(fd, generation);
+            }
+            continue;
+        }
+
+        // URING_OP_RECV
+        if (!current) {
+            // fd removed (or reused) since this recv was armed: drop the data
+            if (IoUring::hasBuffer(c)) uring_->recycleBuffer(IoUring::bufferId(c));
+            continue;
+        }
+        if (c.result > 0 && fd == server_->getWakeFd()) {
+            uring_->recycleBuffer(IoUring::bufferId(c));
+            server_->handleWakeup();
+        } else if (c.result > 0) {
+            unsigned short bid = IoUring::bufferId(c);
+            server_->handleClientData(fd, uring_->bufferData(bid), static_cast<size_t>(c.result));
+            uring_->recycleBuffer(bid);
+        } else if (c.result == 0) {
+            IRC_LOG_DEBUG("Poller", LogFields(fd), "EOF");
+            server_->disconnectClient(fd);
+        } else if (c.result != -ENOBUFS && c.result != -ECANCELED) {
+            IRC_LOG_ERROR("Poller", LogFields(fd), "recv completion error: " << strerror(-c.result));
+            server_->disconnectClient(fd);
+        }
+        // Multishot recv ended (error, no buffers, cancel). Handler may have
+        // disconnected the client or paused reading: only rearm if still wanted
+        if (findFdIndex(fd) == generation && !IoUring::hasMore(c)) {
+            setFdEvents(fd, getFdEvents(fd) & ~URING_RECV_ARMED);
+            if (getFdEvents(fd) & POLLIN) {
+                armUring(fd, generation);
+            }
         }
     }
+#endif
+}
+
+// Queue the multishot request that matches the fd role
+void Poller::armUring(int fd, int generation) {
+#ifdef __LINUX__
+    if (fd == server_->getServerFd()) {
+        uring_->prepMultishotAccept(fd, uringData(URING_OP_ACCEPT, generation, fd));
+    } else {
+        uring_->prepMultishotRecv(fd, uringData(URING_OP_RECV, generation, fd));
+        setFdEvents(fd, getFdEvents(fd) | URING_RECV_ARMED);
+    }
+#else
+    (void)fd;
+    (void)generation;
+#endif
 }
 
 // Helper methods
-// - findFdIndex(): internal search (used by addFd, removeFd, hasEvent)
+// - findFdIndex(): O(1) lookup in fdIndex_ (used by addFd, removeFd, hasEvent)
+// - setFdIndex(): keeps fdIndex_ in sync, grows it on demand
 // - hasEvent(): check specific event for fd (useful for Server POLLOUT handling)
-// - updatePollfds(): ensures vector consistency (future: rebuild from map for transcendence)
 
 // DONE: Implement Poller::hasEvent(int fd, short event) const
 bool Poller::hasEvent(int fd, short event) const {
     int index = findFdIndex(fd);
     if (index == -1) return false;
-    return (pollfds_[index].revents & event) != 0;
+    if (backend_ == BACKEND_POLL) {
+        return (pollfds_[index].revents & event) != 0;
+    }
+    // uring: completions carry data, not readiness
+    if (backend_ == BACKEND_URING) {
+        return false;
+    }
+    // epoll: only ready fds carry events, ready_ is bounded by the ready count
+    for (size_t i = 0; i < ready_.size(); ++i) {
+        if (ready_[i].fd == fd) {
+            return (ready_[i].revents & event) != 0;
+        }
+    }
+    return false;
 }
 
 // DONE: Implement Poller::findFdIndex(int fd) const
 int Poller::findFdIndex(int fd) const {
-    for (size_t i = 0; i < pollfds_.size(); ++i) {
-        if (pollfds_[i].fd == fd) {
-            return static_cast<int>(i);
-        }
+    if (fd < 0 || static_cast<size_t>(fd) >= fdIndex_.size()) {
+        return -1;
     }
-    return -1;
+    return fdIndex_[fd];
 }
 
-// DONE: Implement Poller::updatePollfds()
-// Current: ensures vector consistency
-// Future: will rebuild from map<fd, FdInfo> for transcendence (roles, priorities)
-void Poller::updatePollfds() {
-    // Current implementation: clear revents for consistency
-    for (size_t i = 0; i < pollfds_.size(); ++i) {
-        pollfds_[i].revents = 0;
+void Poller::setFdIndex(int fd, int index) {
+    if (fd < 0) return;
+    if (static_cast<size_t>(fd) >= fdIndex_.size()) {
+        fdIndex_.resize(std::max(static_cast<size_t>(fd) + 1, fdIndex_.size() * 2), -1);
     }
-    
-    // Future (transcendence): rebuild from map with priorities
-    // When adding std::map<int, FdInfo> descriptors_:
-    /*
-    pollfds_.clear();
-    for (auto& kv : descriptors_) {
-        if (kv.second.active) {
-            struct pollfd pfd = {kv.first, kv.second.events, 0};
-            pollfds_.push_back(pfd);
-        }
+    fdIndex_[fd] = index;
+}
+
+// Watched events per fd (epoll and uring, poll keeps them in pollfds_)
+short Poller::getFdEvents(int fd) const {
+    if (fd < 0 || static_cast<size_t>(fd) >= fdEvents_.size()) {
+        return 0;
+    }
+    return fdEvents_[fd];
+}
+
+void Poller::setFdEvents(int fd, short events) {
+    if (fd < 0) return;
+    if (static_cast<size_t>(fd) >= fdEvents_.size()) {
+        fdEvents_.resize(std::max(static_cast<size_t>(fd) + 1, fdEvents_.size() * 2), 0);
+    }
+    fdEvents_[fd] = events;
+}
+
+// Backend selection helpers
+Poller::Backend Poller::getBackend() const {
+    return backend_;
+}
+
+bool Poller::isEdgeTriggered() const {
+    return edgeTriggered_;
+}
+
+Poller::Backend Poller::defaultBackend() {
+#ifdef __LINUX__
+    return BACKEND_EPOLL;
+#else
+    return BACKEND_POLL;
+#endif
+}
+
+// "poll" / "epoll" / "uring", anything else (e.g. "auto") picks the platform default
+Poller::Backend Poller::backendFromName(const std::string& name) {
+    if (name == "poll") return BACKEND_POLL;
+    if (name == "epoll") return BACKEND_EPOLL;
+#ifdef __LINUX__
+    if (name == "uring") return BACKEND_URING;
+#endif
+    return defaultBackend();
+}
+
+const char* Poller::backendName(Backend backend) {
+    switch (backend) {
+        case BACKEND_URING: return "uring";
+        case BACKEND_EPOLL: return "epoll";
+        case BACKEND_POLL:  return "poll";
     }
-    */
+    return "unknown";
 }
@@ -0,0 +1,283 @@
+// Reactor implementation
+// One event loop per thread: Poller + listening socket + cross-thread mailbox
+
+#include "irc/Reactor.hpp"
+#include "irc/Server.hpp"
+#include "irc/Logger.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#ifdef __LINUX__
+# include <sched.h>
+#endif
+
+// Which reactor runs on the calling thread
+static pthread_key_t currentReactorKey;
+static pthread_once_t currentReactorOnce = PTHREAD_ONCE_INIT;
+
+static void createCurrentReactorKey() {
+    pthread_key_create(&currentReactorKey, NULL);
+}
+
+Reactor::Reactor(Server* server, int id, int listenFd, Poller::Backend backend,
+                    bool edgeTriggered, int cpu)
+    : server_(server), id_(id), listenFd_(listenFd), cpu_(cpu)
+    , poller_(NULL), thread_(), threadStarted_(false), flushDue_(false)
+    , now_(TimerWheel::now()) {
+    pthread_once(&currentReactorOnce, createCurrentReactorKey);
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, wakeFds_) < 0) {
+        throw std::runtime_error("socketpair failed");
+    }
+    fcntl(wakeFds_[0], F_SETFL, O_NONBLOCK);
+    fcntl(wakeFds_[1], F_SETFL, O_NONBLOCK);
+
+    poller_ = new Poller(server_, backend, edgeTriggered);
+}
+
+Reactor::~Reactor() {
+    delete poller_;
+    close(wakeFds_[0]);
+    close(wakeFds_[1]);
+    if (listenFd_ >= 0) {
+        close(listenFd_);
+    }
+}
+
+int Reactor::getId() const {
+    return id_;
+}
+
+int Reactor::getListenFd() const {
+    return listenFd_;
+}
+
+int Reactor::getWakeFd() const {
+    return wakeFds_[0];
+}
+
+Poller* Reactor::getPoller() const {
+    return poller_;
+}
+
+Reactor* Reactor::current() {
+    pthread_once(&currentReactorOnce, createCurrentReactorKey);
+    return static_cast<Reactor*>(pthread_getspecific(currentReactorKey));
+}
+
+void Reactor::start() {
+    if (pthread_create(&thread_, NULL, &Reactor::threadMain, this) != 0) {
+        throw std::runtime_error("pthread_create failed");
+    }
+    threadStarted_ = true;
+}
+
+void Reactor::join() {
+    if (threadStarted_) {
+        pthread_join(thread_, NULL);
+        threadStarted_ = false;
+    }
+}
+
+void* Reactor::threadMain(void* arg) {
+    static_cast<Reactor*>(arg)->run();
+    return NULL;
+}
+
+// Main loop of one reactor
+// - Bind reactor to this thread (Server::getServerFd()/getPoller() use it)
+// - Register listening and wake sockets from the owner thread
+// - poll()/processEvents() until SIGINT, poll timeout up to the next timer
+// - Then due timers (Server::handleTimers)
+// - Flush phase after each pass: one writev() per client written to, or
+//   with io_uring one sendmsg each, submitted by the next poll()
+// - Reactors posted to during the pass and not woken yet: wakePeers()
+void Reactor::run() {
+    pthread_setspecific(currentReactorKey, this);
+    pinToCpu();
+
+    poller_->addFd(listenFd_, POLLIN);
+    poller_->addFd(wakeFds_[0], POLLIN);
+    IRC_LOG_INFO("Reactor", LogFields(), "Reactor " << id_ << " running event loop");
+
+    while (__atomic_load_n(&Server::running_, __ATOMIC_RELAXED)) {
+        int ready = poller_->poll(timers_.timeoutMs(now_, 1000));  // at most 1 sec
+        now_ = TimerWheel::now();
+        if (ready > 0) {
+            poller_->processEvents();
+        }
+        timers_.expire(now_, firedTimers_);
+        if (!firedTimers_.empty()) {
+            server_->handleTimers(firedTimers_);
+            firedTimers_.clear();
+        }
+        if (!pendingFlush_.empty()) {
+            flush(true);
+        }
+        wakePeers();    // mail posted by handlers that do not wake on their own
+    }
+    poller_->submitPending();   // last flush phase (uring)
+
+    poller_->removeFd(wakeFds_[0]);
+    poller_->removeFd(listenFd_);
+    pthread_setspecific(currentReactorKey, NULL);
+    IRC_LOG_INFO("Reactor", LogFields(), "Reactor " << id_ << " event loop stopped");
+}
+
+void Reactor::pinToCpu() {
+    if (cpu_ < 0) return;
+#ifdef __LINUX__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu_, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) < 0) {
+        IRC_LOG_ERROR("Reactor", LogFields(), "Reactor " << id_ << " sched_setaffinity(cpu=" << cpu_
+                    << ") failed: " << strerror(errno));
+        return;
+    }
+    IRC_LOG_INFO("Reactor", LogFields(), "Reactor " << id_ << " pinned to cpu " << cpu_);
+#else
+    IRC_LOG_WARN("Reactor", LogFields(), "Reactor " << id_ << ": CPU pinning not supported on this platform");
+#endif
+}
+
+void Reactor::post(const ConnectionTable::Handle& client, const SharedMessage& message,
+                    SendQueue::Priority priority) {
+    Mail mail;
+    mail.client = client;
+    mail.disconnect = false;
+    mail.priority = priority;
+    mail.message = message;
+    enqueue(mail);
+}
+
+void Reactor::postDisconnect(const ConnectionTable::Handle& client) {
+    Mail mail;
+    mail.client = client;
+    mail.disconnect = true;
+    mail.priority = SendQueue::PRIORITY_NORMAL;
+    enqueue(mail);
+}
+
+// Only the empty -> non-empty transition wakes the reactor,
+// handleWakeup() swaps the whole mailbox out so no wakeup is lost.
+// From a reactor thread the write waits for wakePeers(): the poster holds
+// the state lock, the woken reactor would only block on it
+void Reactor::enqueue(const Mail& mail) {
+    bool wasEmpty;
+    {
+        ScopedLock lock(mailboxLock_);
+        wasEmpty = mailbox_.empty();
+        mailbox_.push_back(mail);
+    }
+    if (!wasEmpty) return;
+    Reactor* poster = current();
+    if (poster) {
+        poster->wakeups_.push_back(this);
+    } else {
+        wake();
+    }
+}
+
+void Reactor::wake() {
+    char byte = 1;
+    if (write(wakeFds_[1], &byte, 1) < 0 && errno != EAGAIN) {
+        IRC_LOG_ERROR("Reactor", LogFields(), "Reactor " << id_ << " wake write failed: " << strerror(errno));
+    }
+}
+
+void Reactor::wakePeers() {
+    for (size_t i = 0; i < wakeups_.size(); ++i) {
+        wakeups_[i]->wake();
+    }
+    wakeups_.clear();
+}
+
+void Reactor::handleWakeup() {
+    char drain[256];
+    while (recv(wakeFds_[0], drain, sizeof(drain), 0) > 0) {
+    }
+
+    std::vector<Mail> mail;
+    {
+        ScopedLock lock(mailboxLock_);
+        mail.swap(mailbox_);
+    }
+    if (mail.empty()) return;
+
+    // Deliver under the state lock: mail whose connection is gone (a
+    // disconnect earlier in this batch, or the fd reused since) is dropped
+    {
+        ScopedLock lock(server_->getStateLock());
+        for (size_t i = 0; i < mail.size(); ++i) {
+            if (server_->getOwner(mail[i].client) != this) continue;
+            int fd = mail[i].client.fd;
+            if (mail[i].disconnect) {
+                server_->disconnectClient(fd);
+            } else {
+                server_->writeToClient(fd, mail[i].message, mail[i].priority);
+            }
+        }
+    }
+    wakePeers();
+    flushIfDue();
+}
+
+TimerWheel& Reactor::getTimers() {
+    return timers_;
+}
+
+unsigned long long Reactor::now() const {
+    return now_;
+}
+
+MessageBuffer& Reactor::getScratch() {
+    return scratch_;
+}
+
+Command& Reactor::getCommand() {
+    return command_;
+}
+
+void Reactor::scheduleFlush(const ConnectionTable::Handle& client, SendQueue* queue) {
+    Flush entry;
+    entry.client = client;
+    entry.queue = queue;
+    entry.written = 0;
+    entry.error = 0;
+    pendingFlush_.push_back(entry);
+}
+
+void Reactor::requestFlush() {
+    flushDue_ = true;
+}
+
+void Reactor::flushIfDue() {
+    if (flushDue_) {
+        flush(false);
+    }
+}
+
+// Swapped out first: clients scheduled while it runs (a disconnect in its
+// follow-up) are flushed next time, not lost
+void Reactor::flush(bool viaRing) {
+    flushDue_ = false;
+    flushing_.swap(pendingFlush_);
+    server_->flushOutput(flushing_, viaRing);
+    flushing_.clear();
+}
+
+void Reactor::discardMail(int clientFd) {
+    ScopedLock lock(mailboxLock_);
+    size_t kept = 0;
+    for (size_t i = 0; i < mailbox_.size(); ++i) {
+        if (mailbox_[i].client.fd != clientFd) {
+            if (kept != i) mailbox_[kept] = mailbox_[i];
+            ++kept;
+        }
+    }
+    mailbox_.resize(kept);
+}
@@ -11,8 +11,8 @@
 /* ************************************************************************** */
 
 #include "irc/Replies.hpp"
+#include "irc/ReplyBuilder.hpp"
 #include "irc/Client.hpp"
-#include <sstream>
 #include <cstring>
 
 // Numeric reply constants
@@ -52,19 +52,19 @@ const std::string Replies::ERR_CHANOPRIVSNEEDED = "482";
 // Method - numeric()
 // Format: ":servername numeric nickname params :trailing\r\n"
 // Example: ":irc.example.com 001 user :Welcome to the IRC Network\r\n"
-// - Build string with proper formatting
+// - Build string with proper formatting (ReplyBuilder, one allocation:
+//   the returned string; send a ReplyBuilder directly for none)
 // - Always append \r\n
 // - Return formatted string
 std::string Replies::numeric(const std::string& numeric, const std::string& nickname, const std::string& params, const std::string& trailing)
 {
-    std::stringstream ss;
-    ss << ":" << Replies::formatServerName() << " " << numeric << " " << nickname;
+    ReplyBuilder reply;
+    reply.numeric(numeric, nickname);
     if (!params.empty())
-        ss << " " << params;
+        reply.param(params);
     if (!trailing.empty())
-        ss << " :" << trailing;
-    ss << "\r\n";
-    return ss.str();
+        reply.trailing(trailing);
+    return reply.end().str();
 }
 
 // Method - command()
@@ -75,16 +75,13 @@ std::string Replies::numeric(const std::string& numeric, const std::string& nick
 // - Return formatted string
 std::string Replies::command(const std::string& prefix, const std::string& cmd, const std::string& params, const std::string& trailing)
 {
-    std::stringstream ss;
-    if (!prefix.empty())
-        ss << ":" << prefix << " ";
-    ss << cmd;
+    ReplyBuilder reply;
+    reply.command(prefix, cmd.c_str());
     if (!params.empty())
-        ss << " " << params;
+        reply.param(params);
     if (!trailing.empty())
-        ss << " :" << trailing;
-    ss << "\r\n";
-    return ss.str();
+        reply.trailing(trailing);
+    return reply.end().str();
 }
 
 // Method - simple()
@@ -95,36 +92,28 @@ std::string Replies::command(const std::string& prefix, const std::string& cmd,
 // - Return formatted string
 std::string Replies::simple(const std::string& cmd, const std::string& params, const std::string& trailing)
 {
-    std::stringstream ss;
-    ss << cmd;
+    ReplyBuilder reply;
+    reply.append(cmd);
     if (!params.empty())
-        ss << " " << params;
+        reply.param(params);
     if (!trailing.empty())
-        ss << " :" << trailing;
-    ss << "\r\n";
-    return ss.str();
+        reply.trailing(trailing);
+    return reply.end().str();
 }
 
 // Method - formatClientPrefix()
 // Format: "nick!user@host"
-// - Concatenate nickname, '!', username, '@', hostname
-// - Return formatted string
-std::string Replies::formatClientPrefix(const Client& client)
+// - Client keeps it built (rebuilt on NICK/USER/host change)
+// - Return it without copying
+const std::string& Replies::formatClientPrefix(const Client& client)
 {
-    std::stringstream ss;
-	// TODO: Enable when Client methods ready
-    // ss << client.getNickname() << "!" << client.getUsername() << "@" << client.getHostname();
-	(void)client;  // suppress unused warning
-	ss << "*!*@*";  // placeholder prefix 
-	return ss.str();
+    return client.getPrefix();
 }
 
 // Method - formatServerName()
-// - Return server name with leading ':' if needed
-// - Or return as-is (depends on usage context)
-std::string Replies::formatServerName()
+// - Return server name as-is (no leading ':')
+// - Loaded from Config once, in the Server constructor
+const std::string& Replies::formatServerName()
 {
-    // change it to read from config
-    // or to use Server::getServerName() method acc.to conventions
-    return "ft_irc";
+    return ReplyBuilder::getServerName();
 }
@@ -0,0 +1,129 @@
+// ReplyBuilder implementation
+// Appends into buffer_, never past MAX_LINE - 2 so end() always has room
+
+#include "irc/ReplyBuilder.hpp"
+#include <cstring>
+
+// Bytes reserved for the final "\r\n"
+static const size_t CRLF_LENGTH = 2;
+
+// ":<name> " encoded once by setServerName(), copied by numeric()
+static std::string serverName("ft_irc");
+static std::string serverPrefix(":ft_irc ");
+
+ReplyBuilder::ReplyBuilder() : size_(0), truncated_(false) {}
+
+ReplyBuilder& ReplyBuilder::numeric(const std::string& code, const std::string& nickname) {
+    append(serverPrefix);
+    append(code);
+    append(' ');
+    return append(nickname);
+}
+
+ReplyBuilder& ReplyBuilder::command(const std::string& prefix, const char* command) {
+    if (!prefix.empty()) {
+        append(':');
+        append(prefix);
+        append(' ');
+    }
+    return append(command, std::strlen(command));
+}
+
+ReplyBuilder& ReplyBuilder::param(const std::string& value) {
+    append(' ');
+    return append(value);
+}
+
+ReplyBuilder& ReplyBuilder::param(const char* value) {
+    append(' ');
+    return append(value, std::strlen(value));
+}
+
+ReplyBuilder& ReplyBuilder::trailing(const std::string& text) {
+    append(" :", 2);
+    return append(text);
+}
+
+ReplyBuilder& ReplyBuilder::trailing(const char* text) {
+    append(" :", 2);
+    return append(text, std::strlen(text));
+}
+
+ReplyBuilder& ReplyBuilder::append(const char* data, size_t length) {
+    if (length > remaining()) {
+        return appendTruncated(data, length);
+    }
+    std::memcpy(buffer_ + size_, data, length);
+    size_ += length;
+    return *this;
+}
+
+// Slow path of append(): keep what fits, remember the cut
+ReplyBuilder& ReplyBuilder::appendTruncated(const char* data, size_t length) {
+    size_t room = remaining();
+    if (length > room) {
+        length = room;
+        truncated_ = true;
+    }
+    std::memcpy(buffer_ + size_, data, length);
+    size_ += length;
+    return *this;
+}
+
+ReplyBuilder& ReplyBuilder::append(const std::string& data) {
+    return append(data.data(), data.size());
+}
+
+ReplyBuilder& ReplyBuilder::append(char c) {
+    if (remaining() == 0) {
+        truncated_ = true;
+        return *this;
+    }
+    buffer_[size_++] = c;
+    return *this;
+}
+
+ReplyBuilder& ReplyBuilder::end() {
+    if (size_ + CRLF_LENGTH > MAX_LINE) {
+        return *this;  // already ended
+    }
+    buffer_[size_++] = '\r';
+    buffer_[size_++] = '\n';
+    return *this;
+}
+
+const char* ReplyBuilder::data() const {
+    return buffer_;
+}
+
+size_t ReplyBuilder::size() const {
+    return size_;
+}
+
+bool ReplyBuilder::truncated() const {
+    return truncated_;
+}
+
+std::string ReplyBuilder::str() const {
+    return std::string(buffer_, size_);
+}
+
+void ReplyBuilder::clear() {
+    size_ = 0;
+    truncated_ = false;
+}
+
+// After end() nothing more fits (size_ may reach MAX_LINE)
+size_t ReplyBuilder::remaining() const {
+    size_t limit = MAX_LINE - CRLF_LENGTH;
+    return (size_ < limit) ? limit - size_ : 0;
+}
+
+void ReplyBuilder::setServerName(const std::string& name) {
+    serverName = name;
+    serverPrefix = ":" + name + " ";
+}
+
+const std::string& ReplyBuilder::getServerName() {
+    return serverName;
+}
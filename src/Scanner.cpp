@@ -0,0 +1,399 @@
+// Scanner implementation
+// SSE2 / AVX2 / scalar line scanning, chosen at runtime
+//
+// The SIMD implementations turn a block of bytes into bitmasks (bit i set =
+// byte i is '\r' / ' ' / ':') and hand them to the same mask logic, so the
+// SIMD part is only loads, compares and movemask.
+
+#include "irc/Scanner.hpp"
+#include <cstring>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+# define SCANNER_X86 1
+# include <emmintrin.h>
+# include <immintrin.h>
+#endif
+
+static const size_t NPOS = static_cast<size_t>(-1);
+
+// ============================================================================
+// Scalar (memchr: libc has its own vectorized search on most platforms)
+// ============================================================================
+
+static size_t findLineEndScalar(const char* data, size_t length) {
+    size_t start = 0;
+    while (start + 1 < length) {
+        const void* cr = std::memchr(data + start, '\r', length - start - 1);
+        if (!cr) return NPOS;
+        size_t pos = static_cast<const char*>(cr) - data;
+        if (data[pos + 1] == '\n') return pos;
+        start = pos + 1;
+    }
+    return NPOS;
+}
+
+static void indexScalar(const char* line, size_t length, LineIndex& index) {
+    size_t firstToken = 0;
+    while (firstToken < length && line[firstToken] == ' ') ++firstToken;
+
+    size_t pos = 0;
+    while (pos < length) {
+        const void* found = std::memchr(line + pos, ' ', length - pos);
+        if (!found) break;
+        size_t space = static_cast<const char*>(found) - line;
+        if (index.spaceCount == LineIndex::MAX_SPACES) {
+            index.indexedEnd = space;
+            return;
+        }
+        index.spaces[index.spaceCount++] = static_cast<unsigned int>(space);
+        if (space + 1 < length && line[space + 1] == ':' && space + 1 > firstToken) {
+            index.trailing = space + 1;
+            index.indexedEnd = space + 1;
+            return;
+        }
+        pos = space + 1;
+    }
+    index.indexedEnd = length;
+}
+
+// Two passes here (line end, then spaces), the SIMD versions do one
+// Without a line end the whole data is indexed, like the SIMD versions
+static size_t scanLineScalar(const char* data, size_t length, LineIndex& index) {
+    size_t end = findLineEndScalar(data, length);
+    indexScalar(data, (end == NPOS) ? length : end, index);
+    return end;
+}
+
+#ifdef SCANNER_X86
+
+// ============================================================================
+// Shared mask logic
+// ============================================================================
+
+// State of scanLine() carried from one block to the next
+struct IndexState {
+    bool prevSpace;     // last byte of the previous block was ' '
+    bool seenToken;     // a non-space byte was seen (leading spaces are over)
+    size_t firstToken;  // offset of that byte
+    bool done;
+};
+
+// Bit i of mask = byte i of the block at base; valid = bits inside the line
+// Returns true when the index is complete (trailing found or spaces full)
+static inline bool indexMasks(unsigned int spaceMask, unsigned int colonMask,
+                              unsigned int valid, size_t base, size_t blockSize,
+                              IndexState& state, LineIndex& index) {
+    spaceMask &= valid;
+    colonMask &= valid;
+
+    if (!state.seenToken) {
+        unsigned int tokens = ~spaceMask & valid;
+        if (tokens) {
+            state.seenToken = true;
+            state.firstToken = base + __builtin_ctz(tokens);
+        }
+    }
+
+    // ':' right after a space, past the first token: trailing parameter
+    unsigned int afterSpace = (spaceMask << 1) | (state.prevSpace ? 1u : 0u);
+    unsigned int candidates = colonMask & afterSpace;
+    while (candidates) {
+        size_t pos = base + __builtin_ctz(candidates);
+        if (state.seenToken && pos > state.firstToken) {
+            // Record only the spaces before the trailing ':'
+            unsigned int bit = static_cast<unsigned int>(pos - base);
+            spaceMask &= (bit >= 32) ? ~0u : ((1u << bit) - 1);
+            index.trailing = pos;
+            state.done = true;
+            break;
+        }
+        candidates &= candidates - 1;
+    }
+    state.prevSpace = (spaceMask >> (blockSize - 1)) & 1u;
+
+    while (spaceMask) {
+        size_t pos = base + __builtin_ctz(spaceMask);
+        if (index.spaceCount == LineIndex::MAX_SPACES) {
+            index.indexedEnd = pos;
+            return true;
+        }
+        index.spaces[index.spaceCount++] = static_cast<unsigned int>(pos);
+        spaceMask &= spaceMask - 1;
+    }
+    if (state.done) {
+        index.indexedEnd = index.trailing;
+        return true;
+    }
+    return false;
+}
+
+// Bytes [0, n) of a block valid
+static inline unsigned int validBits(size_t n) {
+    return (n >= 32) ? ~0u : ((1u << n) - 1);
+}
+
+// First "\r\n" among the '\r' bits of a block
+static inline size_t lineEndInMask(unsigned int crMask, const char* data,
+                                   size_t base, size_t length) {
+    while (crMask) {
+        size_t pos = base + __builtin_ctz(crMask);
+        if (pos + 1 < length && data[pos + 1] == '\n') {
+            return pos;
+        }
+        crMask &= crMask - 1;
+    }
+    return NPOS;
+}
+
+// ============================================================================
+// SSE2 (16 bytes) / AVX2 (32 bytes)
+// ============================================================================
+
+// The last partial block is loaded so that it ends at the last byte
+// (overlapping the previous block) and the mask is shifted down, no read
+// past the end. Data shorter than one block goes to the smaller implementation.
+
+__attribute__((target("sse2")))
+static inline unsigned int sse2Mask(__m128i bytes, char c) {
+    return static_cast<unsigned int>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(c))));
+}
+
+__attribute__((target("sse2")))
+static inline __m128i sse2Load(const char* data, size_t base, size_t length, unsigned int& shift) {
+    if (length - base >= 16) {
+        shift = 0;
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + base));
+    }
+    shift = static_cast<unsigned int>(16 - (length - base));
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + length - 16));
+}
+
+__attribute__((target("sse2")))
+static size_t findLineEndSse2(const char* data, size_t length) {
+    if (length < 16) return findLineEndScalar(data, length);
+    size_t base = 0;
+
+    // Long lines (PRIVMSG text): test 64 bytes per step for any '\r'
+    const __m128i cr = _mm_set1_epi8('\r');
+    while (base + 64 <= length) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(data + base);
+        __m128i any = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128(p), cr),
+                         _mm_cmpeq_epi8(_mm_loadu_si128(p + 1), cr)),
+            _mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128(p + 2), cr),
+                         _mm_cmpeq_epi8(_mm_loadu_si128(p + 3), cr)));
+        if (_mm_movemask_epi8(any)) break;
+        base += 64;
+    }
+    for (; base < length; base += 16) {
+        unsigned int shift;
+        __m128i bytes = sse2Load(data, base, length, shift);
+        unsigned int cr = sse2Mask(bytes, '\r') >> shift;
+        if (cr) {
+            size_t pos = lineEndInMask(cr, data, base, length);
+            if (pos != NPOS) return pos;
+        }
+    }
+    return NPOS;
+}
+
+__attribute__((target("sse2")))
+static size_t scanLineSse2(const char* data, size_t length, LineIndex& index) {
+    if (length < 16) return scanLineScalar(data, length, index);
+    IndexState state = { false, false, 0, false };
+    for (size_t base = 0; base < length; base += 16) {
+        unsigned int shift;
+        __m128i bytes = sse2Load(data, base, length, shift);
+        unsigned int cr = sse2Mask(bytes, '\r') >> shift;
+        size_t end = cr ? lineEndInMask(cr, data, base, length) : NPOS;
+        unsigned int valid = validBits(end == NPOS ? 16 - shift : end - base);
+        if (indexMasks(sse2Mask(bytes, ' ') >> shift, sse2Mask(bytes, ':') >> shift,
+                       valid, base, 16, state, index)) {
+            if (end != NPOS || base + 16 >= length) return end;
+            size_t rest = findLineEndSse2(data + base + 16, length - base - 16);
+            return (rest == NPOS) ? NPOS : base + 16 + rest;
+        }
+        if (end != NPOS) {
+            index.indexedEnd = end;
+            return end;
+        }
+    }
+    index.indexedEnd = length;
+    return NPOS;
+}
+
+__attribute__((target("avx2")))
+static inline unsigned int avx2Mask(__m256i bytes, char c) {
+    return static_cast<unsigned int>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c))));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2Load(const char* data, size_t base, size_t length, unsigned int& shift) {
+    if (length - base >= 32) {
+        shift = 0;
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + base));
+    }
+    shift = static_cast<unsigned int>(32 - (length - base));
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + length - 32));
+}
+
+__attribute__((target("avx2")))
+static size_t findLineEndAvx2(const char* data, size_t length) {
+    if (length < 32) return findLineEndSse2(data, length);
+    size_t base = 0;
+
+    // Long lines (PRIVMSG text): test 64 bytes per step for any '\r'
+    const __m256i cr = _mm256_set1_epi8('\r');
+    while (base + 64 <= length) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + base));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + base + 32));
+        __m256i any = _mm256_or_si256(_mm256_cmpeq_epi8(a, cr), _mm256_cmpeq_epi8(b, cr));
+        if (_mm256_movemask_epi8(any)) break;
+        base += 64;
+    }
+    for (; base < length; base += 32) {
+        unsigned int shift;
+        __m256i bytes = avx2Load(data, base, length, shift);
+        unsigned int mask = avx2Mask(bytes, '\r') >> shift;
+        if (mask) {
+            size_t pos = lineEndInMask(mask, data, base, length);
+            if (pos != NPOS) return pos;
+        }
+    }
+    return NPOS;
+}
+
+__attribute__((target("avx2")))
+static size_t scanLineAvx2(const char* data, size_t length, LineIndex& index) {
+    if (length < 32) return scanLineSse2(data, length, index);
+    IndexState state = { false, false, 0, false };
+    for (size_t base = 0; base < length; base += 32) {
+        unsigned int shift;
+        __m256i bytes = avx2Load(data, base, length, shift);
+        unsigned int cr = avx2Mask(bytes, '\r') >> shift;
+        size_t end = cr ? lineEndInMask(cr, data, base, length) : NPOS;
+        unsigned int valid = validBits(end == NPOS ? 32 - shift : end - base);
+        if (indexMasks(avx2Mask(bytes, ' ') >> shift, avx2Mask(bytes, ':') >> shift,
+                       valid, base, 32, state, index)) {
+            if (end != NPOS || base + 32 >= length) return end;
+            size_t rest = findLineEndAvx2(data + base + 32, length - base - 32);
+            return (rest == NPOS) ? NPOS : base + 32 + rest;
+        }
+        if (end != NPOS) {
+            index.indexedEnd = end;
+            return end;
+        }
+    }
+    index.indexedEnd = length;
+    return NPOS;
+}
+
+#endif // SCANNER_X86
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+typedef size_t (*FindLineEndFn)(const char*, size_t);
+typedef size_t (*ScanLineFn)(const char*, size_t, LineIndex&);
+
+static Scanner::Impl currentImpl = Scanner::IMPL_SCALAR;
+static FindLineEndFn findLineEndFn = NULL;
+static ScanLineFn scanLineFn = NULL;
+
+static void selectImpl(Scanner::Impl impl) {
+    currentImpl = impl;
+    switch (impl) {
+#ifdef SCANNER_X86
+        case Scanner::IMPL_AVX2:
+            findLineEndFn = findLineEndAvx2;
+            scanLineFn = scanLineAvx2;
+            return;
+        case Scanner::IMPL_SSE2:
+            findLineEndFn = findLineEndSse2;
+            scanLineFn = scanLineSse2;
+            return;
+#endif
+        default:
+            currentImpl = Scanner::IMPL_SCALAR;
+            findLineEndFn = findLineEndScalar;
+            scanLineFn = scanLineScalar;
+            return;
+    }
+}
+
+// Best implementation, chosen once: reactor threads scan lines without
+// any lock, pthread_once() makes both pointers visible to all of them
+static pthread_once_t selectOnce = PTHREAD_ONCE_INIT;
+
+static void selectBest() {
+    if (Scanner::isSupported(Scanner::IMPL_AVX2)) {
+        selectImpl(Scanner::IMPL_AVX2);
+    } else if (Scanner::isSupported(Scanner::IMPL_SSE2)) {
+        selectImpl(Scanner::IMPL_SSE2);
+    } else {
+        selectImpl(Scanner::IMPL_SCALAR);
+    }
+}
+
+static void ensureSelected() {
+    pthread_once(&selectOnce, selectBest);
+}
+
+size_t Scanner::findLineEnd(const char* data, size_t length) {
+    ensureSelected();
+    return findLineEndFn(data, length);
+}
+
+size_t Scanner::scanLine(const char* data, size_t length, LineIndex& index) {
+    ensureSelected();
+    index.spaceCount = 0;
+    index.trailing = NPOS;
+    index.indexedEnd = 0;
+    return scanLineFn(data, length, index);
+}
+
+// A "\r\n" inside line only shortens indexedEnd, Parser searches past it
+void Scanner::indexLine(const char* line, size_t length, LineIndex& index) {
+    scanLine(line, length, index);
+}
+
+Scanner::Impl Scanner::getImpl() {
+    ensureSelected();
+    return currentImpl;
+}
+
+// Not synchronized: benchmarks and tests call it before scanning
+bool Scanner::setImpl(Impl impl) {
+    if (!isSupported(impl)) return false;
+    ensureSelected();
+    selectImpl(impl);
+    return true;
+}
+
+bool Scanner::isSupported(Impl impl) {
+    switch (impl) {
+        case IMPL_SCALAR:
+            return true;
+#ifdef SCANNER_X86
+        case IMPL_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case IMPL_AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* Scanner::implName(Impl impl) {
+    switch (impl) {
+        case IMPL_AVX2:   return "avx2";
+        case IMPL_SSE2:   return "sse2";
+        case IMPL_SCALAR: return "scalar";
+    }
+    return "unknown";
+}
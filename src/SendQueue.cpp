@@ -0,0 +1,204 @@
+// SendQueue implementation
+// Per-connection outbound queue drained with writev() (or io_uring sendmsg)
+
+#include "irc/SendQueue.hpp"
+#include <cerrno>
+#include <sys/uio.h>
+
+// Chunks handed to one writev() call (well below IOV_MAX)
+#define SENDQUEUE_IOV_BATCH 64
+
+// Defaults: a few hundred KB of backlog is normal for a client joining
+// busy channels, a megabyte means it stopped reading
+SendQueue::Limits::Limits()
+    : softBytes(256 * 1024), hardBytes(1024 * 1024)
+    , softMessages(2000), hardMessages(10000)
+    , dropLowPriority(true), pauseReading(true) {}
+
+SendQueue::Stats::Stats()
+    : droppedMessages(0), droppedBytes(0)
+    , readPauses(0), readResumes(0), hardDisconnects(0) {}
+
+SendQueue::SendQueue()
+    : bytes_(0), sending_(0), blocked_(false), flushScheduled_(false)
+    , readingPaused_(false), closing_(false) {}
+
+SendQueue::~SendQueue() {}
+
+const char* SendQueue::Chunk::data(const std::string& staged) const {
+    return (message.empty() ? staged.data() : message.data()) + offset;
+}
+
+void SendQueue::pushChunk(const SharedMessage& message, size_t offset, size_t length) {
+    chunks_.push_back(Chunk());
+    Chunk& chunk = chunks_.back();
+    chunk.message = message;
+    chunk.offset = offset;
+    chunk.length = length;
+    bytes_ += length;
+}
+
+void SendQueue::push(const SharedMessage& message) {
+    if (message.size() == 0) return;
+    pushChunk(message, 0, message.size());
+}
+
+void SendQueue::append(const char* data, size_t size) {
+    if (size == 0) return;
+    if (!chunks_.empty() && chunks_.back().message.empty()) {
+        // Staged chunks always end at the end of staged_
+        chunks_.back().length += size;
+        bytes_ += size;
+    } else {
+        pushChunk(SharedMessage(), staged_.size(), size);
+    }
+    staged_.append(data, size);
+}
+
+int SendQueue::gather(struct iovec* iov, int max, size_t& bytes) const {
+    int count = 0;
+    bytes = 0;
+    for (std::deque<Chunk>::const_iterator it = chunks_.begin();
+            it != chunks_.end() && count < max; ++it, ++count) {
+        iov[count].iov_base = const_cast<char*>(it->data(staged_));
+        iov[count].iov_len = it->length;
+        bytes += it->length;
+    }
+    return count;
+}
+
+ssize_t SendQueue::flush(int fd) {
+    if (sending_) return 0;
+
+    size_t total = 0;
+    struct iovec iov[SENDQUEUE_IOV_BATCH];
+
+    while (!chunks_.empty()) {
+        size_t batchBytes;
+        int count = gather(iov, SENDQUEUE_IOV_BATCH, batchBytes);
+
+        ssize_t n = writev(fd, iov, count);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return -1;
+        }
+        consume(static_cast<size_t>(n));
+        total += static_cast<size_t>(n);
+        if (static_cast<size_t>(n) < batchBytes) break;  // socket buffer full
+    }
+
+    settleStaged();
+    blocked_ = !chunks_.empty();
+    return static_cast<ssize_t>(total);
+}
+
+int SendQueue::beginSend(struct iovec* iov, int max) {
+    if (sending_) return 0;
+    return gather(iov, max, sending_);
+}
+
+bool SendQueue::completeSend(ssize_t result) {
+    if (!sending_) return false;
+    size_t sent = sending_;
+    sending_ = 0;
+    if (result > 0) {
+        consume(static_cast<size_t>(result));
+    }
+    settleStaged();
+    blocked_ = result == -EAGAIN || result == -EWOULDBLOCK
+            || (result >= 0 && static_cast<size_t>(result) < sent);
+    return true;
+}
+
+void SendQueue::cancelSend() {
+    sending_ = 0;
+}
+
+bool SendQueue::isSending() const {
+    return sending_ != 0;
+}
+
+// Leftover staged bytes get their own block: staged_ starts over empty
+void SendQueue::settleStaged() {
+    if (staged_.empty()) return;
+    for (std::deque<Chunk>::iterator it = chunks_.begin(); it != chunks_.end(); ++it) {
+        if (it->message.empty()) {
+            it->message = SharedMessage(it->data(staged_), it->length);
+            it->offset = 0;
+        }
+    }
+    staged_.clear();
+}
+
+void SendQueue::clear() {
+    chunks_.clear();
+    staged_.clear();
+    bytes_ = 0;
+    sending_ = 0;
+    blocked_ = false;
+}
+
+bool SendQueue::isEmpty() const {
+    return chunks_.empty();
+}
+
+size_t SendQueue::bytes() const {
+    return bytes_;
+}
+
+size_t SendQueue::messages() const {
+    return chunks_.size();
+}
+
+bool SendQueue::overSoftLimit(const Limits& limits) const {
+    return (limits.softBytes && bytes_ >= limits.softBytes)
+        || (limits.softMessages && chunks_.size() >= limits.softMessages);
+}
+
+bool SendQueue::wouldExceedHardLimit(size_t extraBytes, const Limits& limits) const {
+    return (limits.hardBytes && bytes_ + extraBytes > limits.hardBytes)
+        || (limits.hardMessages && chunks_.size() + 1 > limits.hardMessages);
+}
+
+bool SendQueue::isBlocked() const {
+    return blocked_;
+}
+
+bool SendQueue::isFlushScheduled() const {
+    return flushScheduled_;
+}
+
+void SendQueue::setFlushScheduled(bool scheduled) {
+    flushScheduled_ = scheduled;
+}
+
+bool SendQueue::isReadingPaused() const {
+    return readingPaused_;
+}
+
+void SendQueue::setReadingPaused(bool paused) {
+    readingPaused_ = paused;
+}
+
+bool SendQueue::isClosing() const {
+    return closing_;
+}
+
+void SendQueue::setClosing(bool closing) {
+    closing_ = closing;
+}
+
+void SendQueue::consume(size_t n) {
+    bytes_ -= n;
+    while (n > 0) {
+        Chunk& head = chunks_.front();
+        if (n < head.length) {
+            head.offset += n;
+            head.length -= n;
+            return;
+        }
+        n -= head.length;
+        chunks_.pop_front();
+    }
+}
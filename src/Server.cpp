@@ -4,8 +4,12 @@
 	#include "irc/Server.hpp"
 	#include "irc/Poller.hpp"
 	#include "irc/Client.hpp"
+	#include "irc/Channel.hpp"
 	#include "irc/MessageBuffer.hpp"
 	#include "irc/Config.hpp"
+	#include "irc/Reactor.hpp"
+	#include "irc/Scanner.hpp"
+	#include "irc/Logger.hpp"
 	#include <iostream>
 	#include <sys/socket.h>
 	#include <netinet/in.h>
@@ -14,164 +18,182 @@
 	#include <cstring>
 	#include <cerrno>	// errno, strerror() — for errors recv/accept
 	#include <csignal> // sig_atomic_t, signal(), SIGINT
+	#include <netinet/tcp.h>	// TCP_CORK
+	#include <sys/uio.h>	// struct iovec (io_uring sends)
+	#include <algorithm>
+	#include <sstream>
 
 	// SIGINT handler
 	volatile	sig_atomic_t Server::running_ = true;
 
 	// DONE: Implement Server::Server(const Config& config)
 	// - Store config
-	// - Initialize clients_ map
+	// - Initialize connection table
+	// - Server name encoded once for every reply (ReplyBuilder)
 	Server::Server(const Config& config)
-		: serverSocketFd_(-1), config_(config), poller_(NULL) {
-		std::cout << "[Server] Created with port=" << config.getPort() << std::endl;
+		: config_(config), stateLock_(true), bufferBlocks_(MESSAGEBUFFER_CAPACITY, 64, SERVER_WARM_BUFFERS)
+		, fanoutEpoch_(0) {
+		ReplyBuilder::setServerName(config.getServerName());
+		IRC_LOG_INFO("Server", LogFields(), "Created with port=" << config.getPort());
 	}
 
 	// DONE: Implement Server::~Server()
+	// - Delete all channels first: ~Channel unlinks its members, which
+	//   touches the clients
 	// - Close server socket
 	// - Delete all clients
 	Server::~Server() {
-		for (std::map<int, Client*>::iterator it = clients_.begin();
-				it != clients_.end(); ++it) {
-			close(it->first);
-			delete it->second;
+		channels_.clear();
+		for (int fd = 0; fd < connections_.end(); ++fd) {
+			ConnectionTable::Slot* slot = connections_.find(fd);
+			if (!slot) continue;
+			close(fd);
+			clientPool_.destroy(slot->client);
+			destroyBuffer(slot->buffer);
+			sendQueuePool_.destroy(slot->sendQueue);
+			connections_.close(fd);
 		}
-		if (serverSocketFd_ >= 0) {
-			close(serverSocketFd_); // Server Socket here:)
+		// Reactors close their listening sockets (Server Socket here:)
+		for (size_t i = 0; i < reactors_.size(); ++i) {
+			delete reactors_[i];
 		}
-		delete poller_;
 	}
 
-	// - Delete all channels (logic Layer)
-
 	// DONE: Implement Server::start()
-	// - Call createServerSocket()
-	// - Call bindSocket()
-	// - Call listenSocket()
-	// - Add server socket to Poller
-	// - Set server socket to non-blocking
+	// - One Reactor per configured thread, each with its own:
+	//   - createServerSocket() (SO_REUSEPORT when more than one)
+	//   - bindSocket()
+	//   - listenSocket()
+	//   - Set server socket to non-blocking
+	// - Server socket is added to the reactor's Poller when its loop starts
 	void	Server::start() {
-		createServerSocket();
-		bindSocket();
-		listenSocket();
-		setNonBlocking(serverSocketFd_);
+		int threads = config_.getThreads();
+		Poller::Backend backend = Poller::backendFromName(config_.getPollerBackend());
 
-		poller_ = new Poller(this);
-		poller_->addFd(serverSocketFd_, POLLIN);
+		for (int i = 0; i < threads; ++i) {
+			int fd = createServerSocket(threads > 1);
+			bindSocket(fd);
+			listenSocket(fd);
+			setNonBlocking(fd);
+			reactors_.push_back(new Reactor(this, i, fd, backend, config_.getEdgeTriggered(),
+											config_.getCpuForReactor(i)));
+		}
 
-		std::cout << "[Server] Listening on port " << config_.getPort() << std::endl;
+		IRC_LOG_INFO("Server", LogFields(), "Listening on port " << config_.getPort()
+					<< " with " << threads << " reactor(s)");
 	}
 
-	//SIGINT handler
+	// Occupancy of one pool (SlabPool / BlockPool), for the shutdown stats
+	template <typename Pool>
+	static void	printPool(std::ostream& out, const char* name, const Pool& pool) {
+		out << name << pool.live() << "/" << pool.peak() << "/" << pool.capacity();
+	}
+
+	//SIGINT handler: async-signal context, only clears the flag the
+	// reactors poll (at most a second); run() logs the shutdown
 	static void	signalHandler(int signal) {
 		if (signal == SIGINT) {
-			std::cout << "\n[Server] Received SIGINT, shutting down..." << std::endl;
-			Server::running_ = false;
+			__atomic_store_n(&Server::running_, 0, __ATOMIC_RELAXED);
 		}
 	}
 
 	// DONE: Implement Server::run()
-	// - Main event loop:
+	// - Main event loop (Reactor::run()):
 	//   while (running) {
 	//       poller.poll();
 	//       poller.processEvents();
 	//   }
+	// - Reactors 1..N-1 get their own thread, reactor 0 runs here
 	void	Server::run() {
 		//SIGINT handler
 		signal(SIGINT, signalHandler);
 		signal(SIGTERM, signalHandler);
+		signal(SIGPIPE, SIG_IGN);  // peer gone: send() returns EPIPE instead
+
+		IRC_LOG_INFO("Server", LogFields(), "Running event loop...");
+
+		for (size_t i = 1; i < reactors_.size(); ++i) {
+			reactors_[i]->start();
+		}
+		reactors_[0]->run();
+		IRC_LOG_INFO("Server", LogFields(), "Received SIGINT, shutting down...");
+		for (size_t i = 1; i < reactors_.size(); ++i) {
+			reactors_[i]->join();
+		}
+		IRC_LOG_INFO("Server", LogFields(), "Event loop stopped");
 
-		std::cout << "[Server] Running event loop..." << std::endl;
+		SendQueue::Stats stats = getSendQStats();
+		IRC_LOG_INFO("Server", LogFields(), "SendQ stats: dropped=" << stats.droppedMessages
+					<< " (" << stats.droppedBytes << " bytes) paused=" << stats.readPauses
+					<< " resumed=" << stats.readResumes
+					<< " exceeded=" << stats.hardDisconnects);
 
-		while (running_) {
-			int ready = poller_->poll(1000);  // 1 sec timeout
-			if (ready > 0) {
-				poller_->processEvents();
+		// Reactors are joined, nothing else touches registry_ now
+		std::ostringstream commands;
+		for (int id = CMD_UNKNOWN + 1; id < CMD_COUNT; ++id) {
+			unsigned long count = registry_.getCount(static_cast<CommandId>(id));
+			if (count > 0) {
+				commands << " " << commandName(static_cast<CommandId>(id)) << "=" << count;
 			}
 		}
-		std::cout << "[Server] Event loop stopped" << std::endl;
-	}
-
-	// TODO: Implement Server::handleNewConnection()
-	// - Accept new connection using accept()
-	// - Set socket to non-blocking
-	// - Create new Client object
-	// - Add client to clients_ map
-	// - Add client fd to Poller
-
-	// TODO: Implement Server::handleClientInput(int clientFd)
-	// - Read data from socket (use recv())
-	// - Append data to client's MessageBuffer
-	// - Extract complete messages from buffer
-	// - For each complete message:
-	//     - Parse message using Parser
-	//     - Execute command using CommandRegistry
-	// - Handle errors (disconnect on error)
-
-	// TODO: Implement Server::disconnectClient(int clientFd)
-	// - Remove client from all channels
-	// - Remove client from clients_ map
-	// - Remove fd from Poller
-	// - Close socket
-	// - Delete Client object
-
-	// TODO: Implement Server::sendToClient(int clientFd, const std::string& message)
-	// PRIMARY METHOD FOR SENDING DATA - see TEAM_CONVENTIONS.md
-	// - Find client by fd
-	// - Use send() to write message to socket
-	// - Handle errors (EPIPE, EAGAIN, etc.)
-	// - Add \r\n if not already present?
-
-	// TODO: Implement Server::sendResponse(int clientFd, ...)
-	// - Format message using Replies class
-	// - Call sendToClient()
-
-	// TODO: Implement Server::broadcastToChannel(...)
-	// - Get channel by name
-	// - Call channel->broadcast()
-
-	// TODO: Implement Client management methods
-	// - getClient(int fd)
-	// - getClientByNickname(const std::string& nickname)
-	// - addClient(int fd)
-	// - removeClient(int fd)
-
-	// TODO: Implement Channel management methods
+		IRC_LOG_INFO("Server", LogFields(), "Commands:" << commands.str()
+					<< " unknown=" << registry_.getCount(CMD_UNKNOWN));
+
+		std::ostringstream pools;
+		printPool(pools, " clients=", clientPool_);
+		printPool(pools, " buffers=", bufferPool_);
+		printPool(pools, " blocks=", bufferBlocks_);
+		printPool(pools, " sendqs=", sendQueuePool_);
+		printPool(pools, " channels=", channels_.getPool());
+		IRC_LOG_INFO("Server", LogFields(), "Pools (live/peak/slots):" << pools.str());
+	}
+
+	// DONE: Channel management methods (see below getClientByNickname)
 	// - getChannel(const std::string& name)
 	// - createChannel(const std::string& name)
 	// - removeChannel(const std::string& name)
 
 	// DONE: createServerSocket(): socket(), set socket options
-	void	Server::createServerSocket() {
-		serverSocketFd_ = socket(AF_INET, SOCK_STREAM, 0);
-		if (serverSocketFd_ < 0) throw std::runtime_error("socket failed");
+	// reusePort: every reactor binds its own socket to the same port,
+	// the kernel load-balances incoming connections between them
+	int	Server::createServerSocket(bool reusePort) {
+		int fd = socket(AF_INET, SOCK_STREAM, 0);
+		if (fd < 0) throw std::runtime_error("socket failed");
 
 		int opt = 1;
-		setsockopt(serverSocketFd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+		if (reusePort && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+			close(fd);
+			throw std::runtime_error("setsockopt(SO_REUSEPORT) failed");
+		}
+		return fd;
 	}
 
 	// DONE: bindSocket(): bind() with config port
-	void Server::bindSocket() {
+	void Server::bindSocket(int fd) {
 		struct sockaddr_in addr = {};
 		addr.sin_family = AF_INET;
 		addr.sin_port = htons(config_.getPort());
 		addr.sin_addr.s_addr = INADDR_ANY;  // 0.0.0.0
 
-		if (bind(serverSocketFd_, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-			close(serverSocketFd_);
+		if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+			close(fd);
 			throw std::runtime_error("bind failed");
 		}
 
-		std::cout << "[Server] Bound to port " << config_.getPort() << std::endl;
+		IRC_LOG_INFO("Server", LogFields(), "Bound to port " << config_.getPort());
 	}
 
 	// DONE: listenSocket(): listen() with backlog
-	void Server::listenSocket() {
-		if (listen(serverSocketFd_, 10) < 0) {
-			close(serverSocketFd_);
+	// SOMAXCONN (kernel caps it at net.core.somaxconn): a reconnect storm
+	// waits in the queue for the accept loop instead of being refused
+	void Server::listenSocket(int fd) {
+		if (listen(fd, SOMAXCONN) < 0) {
+			close(fd);
 			throw std::runtime_error("listen failed");
 		}
 
-		std::cout << "[Server] Listening backlog=10" << std::endl;
+		IRC_LOG_INFO("Server", LogFields(), "Listening backlog=" << SOMAXCONN);
 	}
 
 	// DONE: setNonBlocking(int fd): fcntl() with O_NONBLOCK
@@ -179,168 +201,862 @@
 		int flags = fcntl(fd, F_GETFL, 0);
 		if (flags < 0)
 		{
-			std::cerr << "[Server] fcntl(F_GETFL) failed for fd=" << fd 
-						<< ": " << strerror(errno) << std::endl;
+			IRC_LOG_ERROR("Server", LogFields(fd), "fcntl(F_GETFL) failed: " << strerror(errno));
 			return;
 		}
 		if (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
 		{
-			std::cerr << "[Server] fcntl(F_SETFL) failed for fd=" << fd 
-						<< ": " << strerror(errno) << std::endl;
+			IRC_LOG_ERROR("Server", LogFields(fd), "fcntl(F_SETFL) failed: " << strerror(errno));
 		}
 	}
 
 	// DONE: getServerFd() for Poller::processEvents()
+	// Listening socket of the reactor running on the calling thread
 	int	Server::getServerFd() const {
-		return serverSocketFd_;
+		Reactor* reactor = Reactor::current();
+		return reactor ? reactor->getListenFd() : -1;
+	}
+
+	Poller*	Server::getPoller() const {
+		Reactor* reactor = Reactor::current();
+		return reactor ? reactor->getPoller() : NULL;
+	}
+
+	// Wake socket: readable when another reactor posted mail for us
+	int	Server::getWakeFd() const {
+		Reactor* reactor = Reactor::current();
+		return reactor ? reactor->getWakeFd() : -1;
+	}
+
+	void	Server::handleWakeup() {
+		Reactor* reactor = Reactor::current();
+		if (reactor) {
+			reactor->handleWakeup();
+		}
+	}
+
+	Mutex&	Server::getStateLock() {
+		return stateLock_;
+	}
+
+	// Reactor owning fd, NULL if unknown (caller holds the state lock)
+	Reactor*	Server::getOwner(int fd) {
+		ConnectionTable::Slot* slot = connections_.find(fd);
+		return slot ? slot->owner : NULL;
+	}
+
+	Reactor*	Server::getOwner(const ConnectionTable::Handle& client) {
+		ConnectionTable::Slot* slot = connections_.find(client);
+		return slot ? slot->owner : NULL;
+	}
+
+	ConnectionTable::Handle	Server::getHandle(int fd) {
+		return connections_.handle(fd);
 	}
 
 	// DONE: getClient(int fd)
 	Client*	Server::getClient(int fd) {
-		std::map<int, Client*>::iterator it = clients_.find(fd);
-		return (it != clients_.end()) ? it->second : NULL;
+		ConnectionTable::Slot* slot = connections_.find(fd);
+		return slot ? slot->client : NULL;
+	}
+
+	// DONE: getClientByNickname(const std::string& nickname)
+	// - Nick directory lookup, no scan of connections_
+	Client*	Server::getClientByNickname(const std::string& nickname) {
+		ScopedLock lock(stateLock_);
+		return nicks_.find(nickname);
+	}
+
+	Client*	Server::getClientByNickname(const Identifier& nickname) {
+		ScopedLock lock(stateLock_);
+		return nicks_.find(nickname);
+	}
+
+	// DONE: getChannel(const std::string& name)
+	Channel*	Server::getChannel(const std::string& name) {
+		ScopedLock lock(stateLock_);
+		return channels_.find(name);
+	}
+
+	Channel*	Server::getChannel(const Identifier& name) {
+		ScopedLock lock(stateLock_);
+		return channels_.find(name);
+	}
+
+	// DONE: createChannel(const std::string& name)
+	Channel*	Server::createChannel(const std::string& name) {
+		ScopedLock lock(stateLock_);
+		return channels_.create(name);
+	}
+
+	// DONE: removeChannel(const std::string& name)
+	void	Server::removeChannel(const std::string& name) {
+		ScopedLock lock(stateLock_);
+		channels_.remove(channels_.find(name));
+	}
+
+	// PART / KICK / disconnect: membership dropped on both sides, an empty
+	// channel goes back to the registry's pool right away
+	void	Server::partChannel(Client& client, Channel* channel) {
+		ScopedLock lock(stateLock_);
+		if (!channel) return;
+		channel->removeClient(&client);
+		if (channel->isEmpty()) {
+			channels_.remove(channel);
+		}
+	}
+
+	const std::string&	Server::getPassword() const {
+		return config_.getPassword();
+	}
+
+	// Uniqueness check and rename under one lock: two clients racing for
+	// the same nick on different reactors cannot both get it
+	bool	Server::setClientNickname(Client& client, const std::string& nickname) {
+		ScopedLock lock(stateLock_);
+		Identifier newNick(nickname);
+		if (!nicks_.rename(&client, client.getNickId(), newNick)) {
+			return false;
+		}
+		client.setNickname(nickname);
+		return true;
 	}
 
 	// DONE: getBuffer(int fd)
 	MessageBuffer* Server::getBuffer(int fd) {
-		std::map<int, MessageBuffer*>::iterator it = buffers_.find(fd);
-		return (it != buffers_.end()) ? it->second : NULL;
+		ConnectionTable::Slot* slot = connections_.find(fd);
+		return slot ? slot->buffer : NULL;
+	}
+
+	// DONE: getSendQueue(int fd)
+	SendQueue* Server::getSendQueue(int fd) {
+		ConnectionTable::Slot* slot = connections_.find(fd);
+		return slot ? slot->sendQueue : NULL;
 	}
 
 	// Stub implementations for Network phase
-	// DONE: Accept new connection, create Client, add to Poller
+	// DONE: Accept new connections, create Client, add to Poller
+	// - accept4() returns the socket already non-blocking + close-on-exec
+	// - Loop until EAGAIN so a reconnect storm is absorbed in few
+	//   iterations, capped so connected clients are not starved meanwhile
+	// - Cap reached: markReadable() (edge-triggered epoll sends no new edge
+	//   for connections that were already queued)
 	void	Server::handleNewConnection() {
-		struct sockaddr_in clientAddr;
-		socklen_t clientLen = sizeof(clientAddr);
-
-		// accept new connection
-		int clientFd = accept(serverSocketFd_, 
-								(struct sockaddr*)&clientAddr, 
-								&clientLen);
+		int serverFd = getServerFd();
 
-		if (clientFd < 0) {
-			if (errno == EAGAIN || errno == EWOULDBLOCK) {
-				return; // there are no connections
+		for (int accepted = 0; accepted < SERVER_ACCEPT_BATCH; ) {
+#ifdef __LINUX__
+			int clientFd = accept4(serverFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+			int clientFd = accept(serverFd, NULL, NULL);
+#endif
+			if (clientFd < 0) {
+				if (errno == EINTR || errno == ECONNABORTED) {
+					continue; // retry / client gone before accept, next one
+				}
+				if (errno == EAGAIN || errno == EWOULDBLOCK) {
+					return; // there are no connections
+				}
+				IRC_LOG_ERROR("Server", LogFields(), "accept() failed: " << strerror(errno));
+				return;
 			}
-			std::cerr << "[Server] accept() failed: " 
-						<< strerror(errno) << std::endl;
-			return;
+#ifndef __LINUX__
+			setNonBlocking(clientFd);
+#endif
+			acceptConnection(clientFd);
+			++accepted;
 		}
+		getPoller()->markReadable(serverFd);
+	}
 
-		// set non blocking mode
-		setNonBlocking(clientFd);
-		// create Client object and register in map
-		Client* client = new Client(clientFd);// allocate on heap
-		clients_[clientFd] = client;// register fd->client mapping
-
-		// create MessageBuffer and register in map 
-		MessageBuffer* buffer = new MessageBuffer();
-		buffers_[clientFd] = buffer;
-
+	// DONE: Register accepted socket: Client, MessageBuffer, Poller
+	// (already non-blocking: accept4() / io_uring accept flags)
+	void	Server::acceptConnection(int clientFd) {
+		ScopedLock lock(stateLock_);
+		// create Client, MessageBuffer, SendQueue in the fd's slot
+		// owned by the reactor that accepted it
+		Client* client = clientPool_.create(clientFd);
+		Reactor* reactor = Reactor::current();
+		ConnectionTable::Slot* slot = connections_.open(clientFd);
+		slot->client = client;
+		slot->buffer = NULL;	// until a partial line arrives
+		slot->sendQueue = sendQueuePool_.create();
+		slot->owner = reactor;
+		startTimer(*slot, reactor->now());
 
 		// add to Poller
-		poller_->addFd(clientFd, POLLIN);
+		reactor->getPoller()->addFd(clientFd, POLLIN);
 
-		std::cout << "[Server] New connection fd=" << clientFd << std::endl;
+		IRC_LOG_INFO("Server", LogFields(clientFd), "New connection");
 	}
 
 	// DOING: Read data, parse messages, execute commands
+	// recv() lands in the reactor's scratch buffer, or in the client's own
+	// MessageBuffer while that holds a partial line (the rest must follow
+	// it). Only this reactor touches either: no lock around recv
+	// - Complete lines run from where they landed; an idle client owns no
+	//   buffer at all (see processMessages())
+	// - Drain: recv() again until EAGAIN or a short read (socket emptied),
+	//   running complete messages after each one so the buffer has room
+	// - Fairness: stop after SERVER_READ_BUDGET bytes, markReadable() so
+	//   the rest is read next iteration even without a new edge
+	// - Stop as soon as a handler disconnected the client or its sendq
+	//   paused reading
 	void	Server::handleClientInput(int fd) {
-		char	buffer[4096];
-		ssize_t bytesRead = recv(fd, buffer, sizeof(buffer) - 1, 0);
+		ConnectionTable::Handle conn;
+		{
+			ScopedLock lock(stateLock_);
+			conn = connections_.handle(fd);
+		}
+		if (conn.generation == 0) {
+			IRC_LOG_ERROR("Server", LogFields(fd), "client not found");
+			return;
+		}
+		MessageBuffer& scratch = Reactor::current()->getScratch();
 
-		std::cout << "[Server] recv() returned: " << bytesRead << std::endl;
+		size_t budget = SERVER_READ_BUDGET;
+		while (budget > 0) {
+			MessageBuffer* msgBuffer;
+			{
+				ScopedLock lock(stateLock_);
+				msgBuffer = getBuffer(fd);
+			}
+			if (!msgBuffer) {
+				msgBuffer = &scratch;
+			}
+			char* tail = msgBuffer->writableData();
+			size_t room = msgBuffer->writableSize();
+			if (room > budget) {
+				room = budget;
+			}
+			ssize_t bytesRead = recv(fd, tail, room, 0);
+
+			IRC_LOG_DEBUG("Server", LogFields(fd), "recv() returned: " << bytesRead);
 
-		if (bytesRead < 0) {
-			if (errno == EAGAIN || errno == EWOULDBLOCK) {
-				std::cout << "[Server] EAGAIN/EWOULDBLOCK - no data yet" << std::endl;
-				return; // no data yet
+			if (bytesRead < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				if (errno == EAGAIN || errno == EWOULDBLOCK) {
+					IRC_LOG_DEBUG("Server", LogFields(fd), "EAGAIN/EWOULDBLOCK - no data yet");
+					return; // no data yet
+				}
+				IRC_LOG_ERROR("Server", LogFields(fd), "recv() error: " << strerror(errno));
+				disconnectClient(fd);
+				return;
 			}
-			std::cerr << "[Server] recv() error fd=" << fd << std::endl;
-			disconnectClient(fd);
-			return;
-		}
 
-		if (bytesRead == 0) {
-			// client closed connection
-			std::cout << "[Server] Client disconnected fd=" << fd << std::endl;
-			disconnectClient(fd);
-			return;
+			if (bytesRead == 0) {
+				// client closed connection
+				IRC_LOG_INFO("Server", LogFields(fd), "Client disconnected");
+				disconnectClient(fd);
+				return;
+			}
+			msgBuffer->commitWrite(static_cast<size_t>(bytesRead));
+			IRC_LOG_DEBUG("Server", LogFields(fd), "Received " << bytesRead << " bytes");
+			processMessages(fd, *msgBuffer);
+			Reactor::current()->wakePeers();
+			Reactor::current()->flushIfDue();
+			budget -= static_cast<size_t>(bytesRead);
+
+			{
+				ScopedLock lock(stateLock_);
+				ConnectionTable::Slot* slot = connections_.find(conn);
+				if (!slot || slot->sendQueue->isReadingPaused()) {
+					return;
+				}
+			}
+			if (static_cast<size_t>(bytesRead) < room) {
+				return; // short read: nothing left in the socket
+			}
 		}
-		// data received
-		std::cout << "[Server] Received " << bytesRead << " bytes from fd=" << fd << std::endl;
+		getPoller()->markReadable(fd);
+	}
 
-		// Get client and buffer
-		Client* client = getClient(fd);
-		MessageBuffer* msgBuffer = getBuffer(fd);
+	// DONE: Append to MessageBuffer (io_uring: bytes are in a provided buffer)
+	// Same buffers as handleClientInput(): scratch unless a line is pending
+	void	Server::handleClientData(int fd, const char* data, size_t length) {
+		// data received
+		IRC_LOG_DEBUG("Server", LogFields(fd), "Received " << length << " bytes");
 
-		if (!client || !msgBuffer) {
-			std::cerr << "[Server] ERROR: client or buffer not found for fd=" << fd << std::endl;
-			return;
+		MessageBuffer* msgBuffer;
+		{
+			ScopedLock lock(stateLock_);
+			if (!getClient(fd)) {
+				IRC_LOG_ERROR("Server", LogFields(fd), "client not found");
+				return;
+			}
+			msgBuffer = getBuffer(fd);
+		}
+		if (!msgBuffer) {
+			msgBuffer = &Reactor::current()->getScratch();
 		}
 
 		// Append to MessageBuffer
-		msgBuffer->append(std::string(buffer, bytesRead));
+		msgBuffer->append(data, length);
+		processMessages(fd, *msgBuffer);
+		Reactor::current()->wakePeers();
+		Reactor::current()->flushIfDue();
+	}
+
+	// DOING: Extract and run complete messages
+	// input is the reactor's scratch buffer or the client's own one
+	// - Afterwards scratch is empty again: a partial line left in it moves
+	//   to a MessageBuffer from the pool, owned by the client until drained
+	// - The client's own buffer goes back to the pool once drained
+	void	Server::processMessages(int fd, MessageBuffer& input) {
+		Reactor* reactor = Reactor::current();
+		ConnectionTable::Handle conn;
+		Client* client;
+		bool scratch;
+		{
+			ScopedLock lock(stateLock_);
+
+			// Get client; input is scratch unless it is the client's buffer
+			conn = connections_.handle(fd);
+			ConnectionTable::Slot* slot = connections_.find(conn);
+			if (!slot) {
+				IRC_LOG_ERROR("Server", LogFields(fd), "client not found");
+				input.clear();
+				return;
+			}
+			client = slot->client;
+			scratch = (&input != slot->buffer);
+
+			// Any input answers a PING (see handleTimer())
+			slot->lastActivity = reactor->now();
+		}
 
-		// Extract complete messages
-		std::vector<std::string> messages = msgBuffer->extractMessages();
+		// Process each complete message in place:
+		// line in MessageBuffer -> CommandView (pointers into the line)
+		// -> the reactor's Command (reused, no allocation once its strings
+		// have grown) -> handler. Nothing is copied out of the buffer per line.
+		// Splitting and parsing need no lock (input, the Command and the
+		// client's lifetime belong to this reactor); the state lock is held
+		// per line, for the handler only, so other reactors run in between.
+		// Reactors the handlers post()ed to are woken by the caller, once
+		// for the whole batch (Reactor::wakePeers())
+		Command& command = reactor->getCommand();
+		char* line;
+		size_t length;
+		LineIndex index;
+		while (input.nextLine(line, length, index)) {
+			CommandView view;
+			if (!parser_.parse(line, length, index, view)) {
+				continue;
+			}
+			Parser::toCommand(view, command);
+			bool gone;
+			{
+				ScopedLock lock(stateLock_);
+				IRC_LOG_DEBUG("Server", LogFields(fd).withNick(client->getNicknameDisplay())
+							.withCommand(command.command), "Complete message: " << command.raw);
+				registry_.execute(*this, *client, command);
 
-		// Process each complete message
-		for (size_t i = 0; i < messages.size(); ++i) {
-			std::cout << "[Server] Complete message: " << messages[i] << std::endl;
-			
-			// TODO (Issue 1.3): Parser integration
-			// IRCMessage msg = parser_.parse(messages[i]);
-			// registry_.execute(this, client, msg);
+				// Handler may have disconnected the client (QUIT, SendQ exceeded):
+				// its own buffer is gone, the rest of scratch was its input
+				gone = !connections_.find(conn);
+			}
+			if (gone) {
+				if (scratch) input.clear();
+				return;
+			}
 		}
+
+		// A whole buffer without CRLF: not IRC, drop it so recv() has room
+		if (input.size() >= input.capacity()) {
+			IRC_LOG_WARN("Server", LogFields(fd), "Input line too long, discarded "
+						<< input.size() << " bytes");
+			input.clear();
+		}
+
+		if (scratch && input.isEmpty()) {
+			return;
+		}
+		ScopedLock lock(stateLock_);
+		ConnectionTable::Slot* slot = connections_.find(conn);
+		if (scratch) {
+			slot->buffer = createBuffer();
+			slot->buffer->append(input.data(), input.size());
+			input.clear();
+		} else if (input.isEmpty()) {
+			destroyBuffer(slot->buffer);
+			slot->buffer = NULL;
+		}
+	}
+
+	// Input buffer of a client (state lock): header from bufferPool_,
+	// storage from bufferBlocks_, neither goes to malloc once warm.
+	// Only SERVER_WARM_BUFFERS free blocks stay resident: idle clients
+	// cost no buffer memory even after a burst of partial lines
+	MessageBuffer*	Server::createBuffer() {
+		char* block = bufferBlocks_.acquire();
+		try {
+			return bufferPool_.create(block, bufferBlocks_.blockSize());
+		} catch (...) {
+			bufferBlocks_.release(block);
+			throw;
+		}
+	}
+
+	void	Server::destroyBuffer(MessageBuffer* buffer) {
+		if (!buffer) return;
+		char* block = buffer->block();
+		bufferPool_.destroy(buffer);
+		bufferBlocks_.release(block);
 	}
 
 	// DONE:Remove client from all channels, close socket, delete Client
 	void	Server::disconnectClient(int fd) {
-		std::cout << "[Server] Disconnecting fd=" << fd << std::endl;
+		ScopedLock lock(stateLock_);
+
+		// 0) socket belongs to another reactor: let its thread do it
+		Reactor* owner = getOwner(fd);
+		if (owner && owner != Reactor::current()) {
+			owner->postDisconnect(connections_.handle(fd));
+			return;
+		}
+
+		IRC_LOG_DEBUG("Server", LogFields(fd), "Disconnecting");
 
 		// 1) find client
 		Client* client = getClient(fd);
 		if (!client) {
-			std::cerr << "[Server] ERROR: client fd=" << fd << " not found!" << std::endl;
+			IRC_LOG_ERROR("Server", LogFields(fd), "client not found!");
 			// clean socket anyway
-			poller_->removeFd(fd);
+			getPoller()->removeFd(fd);
 			close(fd);
 			return;
 		}
 
-		// 2) TODO (when Dev C(Logic layer)): remove from channels
-		// after Dev C will write Channel::removeClient and Client::getChannels(), ADD:
-		// std::vector<std::string> channels = client->getChannels();
-		// for (size_t i = 0; i < channels.size(); ++i) {
-		//     Channel* chan = getChannel(channels[i]);
-		//     if (chan) {
-		//         chan->removeClient(client);
-		//         if (chan->isEmpty()) {
-		//             delete chan;
-		//             channels_.erase(channels[i]);
-		//         }
-		//     }
-		// }
+		// 2) remove from channels (empty ones are reclaimed)
+		// partChannel() unlinks the head membership: one step per channel
+		while (client->getMemberships()) {
+			partChannel(*client, client->getMemberships()->channel);
+		}
 
-		// 3) remove from clients_ map
-		clients_.erase(fd);
+		// 3) remove from the nick directory
+		nicks_.remove(client->getNickId(), client);
 
 		// 3.5) remove MessageBuffer
-		MessageBuffer* buffer = getBuffer(fd);
-		if (buffer) {
-			delete buffer;
-			buffers_.erase(fd);
+		ConnectionTable::Slot* slot = connections_.find(fd);
+		destroyBuffer(slot->buffer);
+
+		// 3.5b) last output (e.g. ERROR) best effort, drop the rest
+		SendQueue* queue = slot->sendQueue;
+		if (!queue->isClosing() && !queue->isEmpty()) {
+			queue->flush(fd);
 		}
+		sendQueuePool_.destroy(queue);
+
+		// 3.6) free the slot (handles to it go stale), drop mail nobody
+		// will deliver
+		connections_.close(fd);
+		owner->discardMail(fd);
 
 		// 4) remove from Poller
-		poller_->removeFd(fd);
+		owner->getPoller()->removeFd(fd);
 
 		// 5) close socket
 		close(fd);
 
-		// 6) clean memory
-		delete client;
+		// 6) clean memory (timer unlinked from the owner's wheel first)
+		owner->getTimers().cancel(&client->getTimer());
+		clientPool_.destroy(client);
+
+		IRC_LOG_INFO("Server", LogFields(fd), "Client disconnected and cleaned up");
+	}
+
+	// DONE: liveness timers, one per client on its reactor's TimerWheel
+	// - Accepted: registration deadline (or straight to keepalive)
+	// - Input only stores the time (processMessages), the timer moves when
+	//   it fires: one wheel relink per interval, not one per message
+	void	Server::startTimer(ConnectionTable::Slot& slot, unsigned long long now) {
+		slot.lastActivity = now;
+		TimerWheel::Timer& timer = slot.client->getTimer();
+		TimerWheel& timers = slot.owner->getTimers();
+
+		if (config_.getRegistrationTimeout() > 0) {
+			timer.kind = TIMER_REGISTRATION;
+			timers.schedule(&timer, now + config_.getRegistrationTimeout() * 1000ULL);
+		} else if (config_.getPingInterval() > 0) {
+			timer.kind = TIMER_KEEPALIVE;
+			timers.schedule(&timer, now + config_.getPingInterval() * 1000ULL);
+		}
+	}
+
+	void	Server::handleTimers(const std::vector<TimerWheel::Timer*>& fired) {
+		ScopedLock lock(stateLock_);
+		Reactor* reactor = Reactor::current();
+
+		for (size_t i = 0; i < fired.size(); ++i) {
+			// Timers are cancelled on disconnect: the client is still here
+			ConnectionTable::Slot* slot = connections_.find(fired[i]->fd);
+			if (slot && &slot->client->getTimer() == fired[i]) {
+				handleTimer(*slot, reactor->getTimers(), reactor->now());
+			}
+		}
+	}
+
+	// - REGISTRATION: not registered -> drop; registered -> keepalive
+	// - KEEPALIVE: quiet for the ping interval -> PING, wait for PONG;
+	//   otherwise rearm for the interval after the last input
+	// - PONG: input since the PING -> keepalive again; none -> drop
+	void	Server::handleTimer(ConnectionTable::Slot& slot, TimerWheel& timers, unsigned long long now) {
+		Client& client = *slot.client;
+		TimerWheel::Timer& timer = client.getTimer();
+		const unsigned long long interval = config_.getPingInterval() * 1000ULL;
+		const unsigned long long pongWait = config_.getPingTimeout() * 1000ULL;
+
+		if (timer.kind == TIMER_REGISTRATION) {
+			if (!client.isRegistered()) {
+				closeLink(client, "Registration timed out");
+				return;
+			}
+			if (interval == 0) return;
+			timer.kind = TIMER_KEEPALIVE;
+		} else if (timer.kind == TIMER_PONG) {
+			// PING went out at deadline - pongWait
+			if (slot.lastActivity + pongWait < timer.deadline) {
+				std::ostringstream reason;
+				reason << "Ping timeout: " << config_.getPingTimeout() << " seconds";
+				closeLink(client, reason.str());
+				return;
+			}
+			timer.kind = TIMER_KEEPALIVE;
+		}
+
+		unsigned long long quietUntil = slot.lastActivity + interval;
+		if (quietUntil > now) {
+			timers.schedule(&timer, quietUntil);
+			return;
+		}
+		sendToClient(client.getFd(), "PING :" + config_.getServerName() + "\r\n");
+		timer.kind = TIMER_PONG;
+		timers.schedule(&timer, now + pongWait);
+	}
+
+	// ERROR line (flushed by disconnectClient) and disconnect
+	void	Server::closeLink(Client& client, const std::string& reason) {
+		int fd = client.getFd();
+		IRC_LOG_INFO("Server", LogFields(fd).withNick(client.getNicknameDisplay()), reason);
+		sendToClient(fd, "ERROR :Closing Link: " + client.getHostname() + " (" + reason + ")\r\n");
+		disconnectClient(fd);
+	}
+
+	// DONE: Send to a client, from whichever reactor runs the handler
+	// - Own client: write now
+	// - Client of another reactor: post to its mailbox, its thread writes
+	void	Server::sendToClient(int fd, const std::string& message, SendQueue::Priority priority) {
+		sendBytes(fd, message.data(), message.size(), priority);
+	}
+
+	// ReplyBuilder variant: no std::string in between
+	void	Server::sendToClient(int fd, const ReplyBuilder& reply, SendQueue::Priority priority) {
+		sendBytes(fd, reply.data(), reply.size(), priority);
+	}
+
+	// Bytes owned by the caller: copied into the SendQueue's staging buffer
+	// (no allocation), or into a block when posted to another reactor
+	void	Server::sendBytes(int fd, const char* data, size_t size, SendQueue::Priority priority) {
+		ScopedLock lock(stateLock_);
+
+		Reactor* owner = getOwner(fd);
+		if (!owner) {
+			IRC_LOG_WARN("Server", LogFields(fd), "sendToClient: unknown fd");
+			return;
+		}
+		if (owner != Reactor::current()) {
+			owner->post(connections_.handle(fd), SharedMessage(data, size), priority);
+			return;
+		}
+		writeToClient(fd, data, size, NULL, priority);
+	}
+
+	// Broadcast variant: the block is queued/posted by reference
+	void	Server::sendToClient(int fd, const SharedMessage& message, SendQueue::Priority priority) {
+		ScopedLock lock(stateLock_);
+
+		Reactor* owner = getOwner(fd);
+		if (!owner) {
+			IRC_LOG_WARN("Server", LogFields(fd), "sendToClient: unknown fd");
+			return;
+		}
+		if (owner != Reactor::current()) {
+			owner->post(connections_.handle(fd), message, priority);
+			return;
+		}
+		writeToClient(fd, message.data(), message.size(), &message, priority);
+	}
+
+	// DONE: one copy per peer, not one per shared channel
+	// - New epoch; the client's own fd is marked first (excluded)
+	// - Every fd of every channel of client: send unless already marked
+	// - Epoch wraps after 2^32 fan-outs: clear the marks, start again
+	void	Server::broadcastToPeers(Client& client, const SharedMessage& message,
+									SendQueue::Priority priority) {
+		ScopedLock lock(stateLock_);
+
+		if (++fanoutEpoch_ == 0) {
+			connections_.clearMarks();
+			fanoutEpoch_ = 1;
+		}
+		const unsigned int epoch = fanoutEpoch_;
+
+		ConnectionTable::Slot* self = connections_.find(client.getFd());
+		if (self) {
+			self->fanoutMark = epoch;
+		}
+		for (Membership* m = client.getMemberships(); m; m = m->nextInClient) {
+			const std::vector<int>& fds = m->channel->getFanout();
+			for (size_t i = 0; i < fds.size(); ++i) {
+				ConnectionTable::Slot* slot = connections_.find(fds[i]);
+				if (slot && slot->fanoutMark != epoch) {
+					slot->fanoutMark = epoch;
+					sendToClient(fds[i], message, priority);
+				}
+			}
+		}
+	}
+
+	void	Server::writeToClient(int fd, const SharedMessage& message, SendQueue::Priority priority) {
+		writeToClient(fd, message.data(), message.size(), &message, priority);
+	}
+
+	// DONE: output for a socket owned by the calling reactor
+	// - Socket keeping up: queued (replies copied into the staging buffer,
+	//   broadcasts by reference) and written by the flush phase at the end
+	//   of the loop iteration: one writev() for the whole burst (a JOIN is
+	//   JOIN + topic + NAMES + end of NAMES)
+	// - SERVER_FLUSH_THRESHOLD bytes queued in one iteration: flush early,
+	//   as soon as the handler is done and the state lock released
+	//   (Reactor::flushIfDue()), never from inside it
+	// - Socket blocked (earlier flush left data, POLLOUT armed): queued
+	//   behind it, and the sendq limits apply (Config::getSendQLimits()):
+	//   - soft: PRIORITY_LOW dropped, reading paused (both optional)
+	//   - hard: disconnect with "SendQ exceeded"
+	void	Server::writeToClient(int fd, const char* data, size_t size,
+								const SharedMessage* shared, SendQueue::Priority priority) {
+		SendQueue* queue = getSendQueue(fd);
+		if (!queue) {
+			IRC_LOG_WARN("Server", LogFields(fd), "writeToClient: no SendQueue");
+			return;
+		}
+		if (queue->isClosing()) return;  // SendQ exceeded, disconnect pending
+
+		if (queue->isBlocked()) {
+			const SendQueue::Limits& limits = config_.getSendQLimits();
+			if (queue->wouldExceedHardLimit(size, limits)) {
+				sendQueueExceeded(fd, queue);
+				return;
+			}
+			if (priority == SendQueue::PRIORITY_LOW && limits.dropLowPriority
+					&& queue->overSoftLimit(limits)) {
+				++sendqStats_.droppedMessages;
+				sendqStats_.droppedBytes += size;
+				return;
+			}
+		}
+
+		if (shared) {
+			queue->push(*shared);
+		} else {
+			queue->append(data, size);
+		}
+
+		if (queue->isBlocked()) {
+			updateClientEvents(fd, queue);
+			return;
+		}
+		Reactor* owner = getOwner(fd);
+		if (!queue->isFlushScheduled()) {
+			queue->setFlushScheduled(true);
+			owner->scheduleFlush(connections_.handle(fd), queue);
+		}
+		if (queue->bytes() >= SERVER_FLUSH_THRESHOLD) {
+			owner->requestFlush();
+		}
+	}
+
+	// DONE: flush phase, once per reactor loop iteration (or early, see
+	// writeToClient()). The caller does not hold the state lock:
+	// - Under it: skip connections gone since (stale handle), blocked ones
+	//   (POLLOUT drains them), closing ones and ones with a send in flight
+	//   (handleSendComplete() schedules them again)
+	// - Without it: the writes. Queue and socket belong to this reactor, no
+	//   other thread writes or frees them. viaRing: a sendmsg per client is
+	//   queued in the ring instead, the whole phase is one io_uring_enter()
+	// - Under it again, only if needed: POLLOUT for what the socket did not
+	//   take, disconnect on a socket error (no handler is running)
+	void	Server::flushOutput(std::vector<Reactor::Flush>& clients, bool viaRing) {
+		size_t count = 0;
+		{
+			ScopedLock lock(stateLock_);
+			for (size_t i = 0; i < clients.size(); ++i) {
+				ConnectionTable::Slot* slot = connections_.find(clients[i].client);
+				if (!slot) continue;
+				SendQueue* queue = slot->sendQueue;
+				queue->setFlushScheduled(false);
+				if (queue->isClosing() || queue->isBlocked() || queue->isSending()) continue;
+				clients[count] = clients[i];
+				clients[count].queue = queue;
+				++count;
+			}
+		}
+
+		viaRing = viaRing && getPoller()->canSubmitSends();
+		bool followUp = false;
+		for (size_t i = 0; i < count; ++i) {
+			Reactor::Flush& entry = clients[i];
+			if (viaRing && submitClient(entry.client.fd, entry.queue)) {
+				entry.written = 0;
+				continue;
+			}
+			entry.written = flushClient(entry.client.fd, entry.queue);
+			entry.error = errno;
+			if (entry.written < 0 || entry.queue->isBlocked()) {
+				followUp = true;
+			}
+		}
+		if (!followUp) return;
+
+		ScopedLock lock(stateLock_);
+		for (size_t i = 0; i < count; ++i) {
+			const Reactor::Flush& entry = clients[i];
+			int fd = entry.client.fd;
+			if (entry.written < 0) {
+				IRC_LOG_ERROR("Server", LogFields(fd), "writev() error: " << strerror(entry.error));
+				disconnectClient(fd);
+			} else if (entry.queue->isBlocked()) {
+				updateClientEvents(fd, entry.queue);
+			}
+		}
+	}
 
-		std::cout << "[Server] Client fd=" << fd << " disconnected and cleaned up" << std::endl;
+	// uring: what is queued for fd as one sendmsg (no TCP_CORK, it is one
+	// call anyway). False if the ring did not take it, write it yourself
+	bool	Server::submitClient(int fd, SendQueue* queue) {
+		struct iovec iov[SERVER_SEND_IOVS];
+		int count = queue->beginSend(iov, SERVER_SEND_IOVS);
+		if (count > 0 && getPoller()->submitSend(fd, iov, count)) {
+			return true;
+		}
+		queue->cancelSend();
+		return false;
+	}
+
+	// DONE: sendmsg of the flush phase done (uring)
+	// - Not all taken (or -EAGAIN): blocked, POLLOUT drains the rest
+	// - All of it: whatever was queued meanwhile goes with the next flush phase
+	// - Socket error: disconnect
+	// Nothing if the connection went away or dropped its queue meanwhile
+	void	Server::handleSendComplete(int fd, int result) {
+		ScopedLock lock(stateLock_);
+		SendQueue* queue = getSendQueue(fd);
+		if (!queue || !queue->completeSend(result)) return;
+
+		if (result < 0 && result != -EAGAIN && result != -EINTR) {
+			IRC_LOG_ERROR("Server", LogFields(fd), "sendmsg() error: " << strerror(-result));
+			disconnectClient(fd);
+			return;
+		}
+		if (queue->isBlocked() || queue->isReadingPaused()) {
+			updateClientEvents(fd, queue);
+		} else if (!queue->isEmpty() && !queue->isFlushScheduled()) {
+			queue->setFlushScheduled(true);
+			getOwner(fd)->scheduleFlush(connections_.handle(fd), queue);
+		}
+	}
+
+	// One writev() of what is queued for fd (owner thread, no lock needed)
+	// --tcp-cork: TCP_CORK held across it when several messages go out, the
+	// kernel sends full segments and the partial last one on uncork
+	// Returns like SendQueue::flush(), the caller arms POLLOUT if blocked
+	ssize_t	Server::flushClient(int fd, SendQueue* queue) {
+		int cork = (config_.getTcpCork() && queue->messages() > 1) ? 1 : 0;
+#ifdef TCP_CORK
+		if (cork) setsockopt(fd, IPPROTO_TCP, TCP_CORK, &cork, sizeof(cork));
+#endif
+		ssize_t n = queue->flush(fd);
+#ifdef TCP_CORK
+		if (cork) {
+			int error = errno;
+			cork = 0;
+			setsockopt(fd, IPPROTO_TCP, TCP_CORK, &cork, sizeof(cork));
+			errno = error;
+		}
+#endif
+		return n;
+	}
+
+	// Pause/resume reading for the soft limit, POLLOUT while data is queued
+	void	Server::updateClientEvents(int fd, SendQueue* queue) {
+		const SendQueue::Limits& limits = config_.getSendQLimits();
+		bool overSoft = queue->overSoftLimit(limits);
+
+		if (limits.pauseReading && overSoft && !queue->isReadingPaused()) {
+			queue->setReadingPaused(true);
+			++sendqStats_.readPauses;
+			IRC_LOG_INFO("Server", LogFields(fd), "sendq over soft limit ("
+						<< queue->bytes() << " bytes), reading paused");
+		} else if (queue->isReadingPaused() && !overSoft) {
+			queue->setReadingPaused(false);
+			++sendqStats_.readResumes;
+			IRC_LOG_INFO("Server", LogFields(fd), "sendq drained, reading resumed");
+		}
+
+		short events = queue->isReadingPaused() ? 0 : POLLIN;
+		if (!queue->isEmpty()) {
+			events |= POLLOUT;
+		}
+		getPoller()->modifyFd(fd, events);
+	}
+
+	// Hard limit: the client stopped reading. Unsent data is dropped and the
+	// disconnect goes through the reactor mailbox, so the handler that is
+	// sending right now (e.g. a channel broadcast loop) finishes first
+	void	Server::sendQueueExceeded(int fd, SendQueue* queue) {
+		IRC_LOG_WARN("Server", LogFields(fd), "SendQ exceeded ("
+					<< queue->bytes() << " bytes, " << queue->messages()
+					<< " messages), disconnecting");
+		++sendqStats_.hardDisconnects;
+		queue->clear();
+		queue->setClosing(true);
+
+		// Best effort, the socket is most likely still full
+		const std::string error = "ERROR :Closing Link: SendQ exceeded\r\n";
+		send(fd, error.data(), error.size(), 0);
+
+		getOwner(fd)->postDisconnect(connections_.handle(fd));
+	}
+
+	SendQueue::Stats	Server::getSendQStats() {
+		ScopedLock lock(stateLock_);
+		return sendqStats_;
+	}
+
+	// DONE: POLLOUT on a client socket: writev() the SendQueue (without
+	// the state lock, like the flush phase)
+	// - Drained: back to POLLIN only
+	// - Still data: keep POLLOUT armed
+	// - Back under the soft limit: resume reading if it was paused
+	// - Socket error: disconnect
+	void	Server::handleClientOutput(int fd) {
+		SendQueue* queue;
+		{
+			ScopedLock lock(stateLock_);
+			queue = getSendQueue(fd);
+			if (!queue || queue->isClosing()) return;
+		}
+
+		ssize_t n = queue->flush(fd);
+		int error = errno;
+
+		ScopedLock lock(stateLock_);
+		if (n < 0) {
+			IRC_LOG_ERROR("Server", LogFields(fd), "writev() error: " << strerror(error));
+			disconnectClient(fd);
+			return;
+		}
+		updateClientEvents(fd, queue);
 	}
@@ -0,0 +1,72 @@
+// SharedMessage implementation
+// Immutable reference counted message block for broadcast fan-out
+
+#include "irc/SharedMessage.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+SharedMessage::SharedMessage() : block_(NULL) {}
+
+SharedMessage::SharedMessage(const std::string& data) : block_(NULL) {
+    if (data.empty()) return;
+    block_ = static_cast<Block*>(std::malloc(offsetof(Block, data) + data.size()));
+    if (!block_) throw std::bad_alloc();
+    block_->refs = 1;
+    block_->size = data.size();
+    std::memcpy(block_->data, data.data(), data.size());
+}
+
+SharedMessage::SharedMessage(const char* data, size_t size) : block_(NULL) {
+    if (size == 0) return;
+    block_ = static_cast<Block*>(std::malloc(offsetof(Block, data) + size));
+    if (!block_) throw std::bad_alloc();
+    block_->refs = 1;
+    block_->size = size;
+    std::memcpy(block_->data, data, size);
+}
+
+SharedMessage::SharedMessage(const SharedMessage& other) : block_(other.block_) {
+    if (block_) {
+        __sync_add_and_fetch(&block_->refs, 1);
+    }
+}
+
+SharedMessage& SharedMessage::operator=(const SharedMessage& other) {
+    if (block_ != other.block_) {
+        if (other.block_) {
+            __sync_add_and_fetch(&other.block_->refs, 1);
+        }
+        release();
+        block_ = other.block_;
+    }
+    return *this;
+}
+
+SharedMessage::~SharedMessage() {
+    release();
+}
+
+const char* SharedMessage::data() const {
+    return block_ ? block_->data : "";
+}
+
+size_t SharedMessage::size() const {
+    return block_ ? block_->size : 0;
+}
+
+bool SharedMessage::empty() const {
+    return block_ == NULL;
+}
+
+int SharedMessage::useCount() const {
+    return block_ ? __sync_add_and_fetch(&block_->refs, 0) : 0;
+}
+
+// Last reference frees the block
+void SharedMessage::release() {
+    if (block_ && __sync_sub_and_fetch(&block_->refs, 1) == 0) {
+        std::free(block_);
+    }
+    block_ = NULL;
+}
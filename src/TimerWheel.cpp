@@ -0,0 +1,111 @@
+// TimerWheel implementation
+// Slots are doubly linked lists of Timer nodes, indexed by tick & (SLOTS - 1)
+
+#include "irc/TimerWheel.hpp"
+#include <ctime>
+
+static const unsigned long long NO_TICK = ~0ULL;
+
+TimerWheel::TimerWheel()
+    : slots_(SLOTS, static_cast<Timer*>(NULL))
+    , current_(now() / TICK_MS), nextTick_(NO_TICK), count_(0) {}
+
+unsigned long long TimerWheel::now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<unsigned long long>(ts.tv_sec) * 1000ULL
+         + static_cast<unsigned long long>(ts.tv_nsec) / 1000000ULL;
+}
+
+// Tick = deadline rounded up: a timer in tick T is due once T * TICK_MS
+// has passed. Overdue deadlines go into the next tick to expire.
+void TimerWheel::schedule(Timer* timer, unsigned long long deadline) {
+    if (timer->scheduled) {
+        unlink(timer);
+    }
+    unsigned long long tick = (deadline + TICK_MS - 1) / TICK_MS;
+    if (tick < current_) {
+        tick = current_;
+    }
+    timer->deadline = deadline;
+    timer->tick = tick;
+    link(timer);
+    if (tick < nextTick_) {
+        nextTick_ = tick;
+    }
+}
+
+void TimerWheel::cancel(Timer* timer) {
+    if (timer->scheduled) {
+        unlink(timer);
+    }
+}
+
+// Slots of the ticks passed since the last call, at most one revolution
+// (after a longer stall every slot is visited once)
+void TimerWheel::expire(unsigned long long now, std::vector<Timer*>& fired) {
+    unsigned long long nowTick = now / TICK_MS;
+    if (nowTick < current_) return;
+
+    unsigned long long steps = nowTick - current_ + 1;
+    if (steps > SLOTS) steps = SLOTS;
+    for (unsigned long long i = 0; i < steps; ++i) {
+        Timer* timer = slots_[(current_ + i) & (SLOTS - 1)];
+        while (timer) {
+            Timer* next = timer->next;
+            if (timer->tick <= nowTick) {       // later rounds stay
+                unlink(timer);
+                fired.push_back(timer);
+            }
+            timer = next;
+        }
+    }
+    current_ = nowTick + 1;
+}
+
+// nextTick_ is only a lower bound: once expired past it, look for the next
+// non-empty slot (runs after timers fired, not on every loop iteration)
+int TimerWheel::timeoutMs(unsigned long long now, int maxMs) {
+    if (count_ == 0) return maxMs;
+    if (nextTick_ < current_) {
+        nextTick_ = NO_TICK;
+        for (unsigned long long k = 0; k < SLOTS; ++k) {
+            if (slots_[(current_ + k) & (SLOTS - 1)]) {
+                nextTick_ = current_ + k;
+                break;
+            }
+        }
+    }
+
+    unsigned long long due = nextTick_ * TICK_MS;
+    if (due <= now) return 0;
+    unsigned long long wait = due - now;
+    return (wait < static_cast<unsigned long long>(maxMs)) ? static_cast<int>(wait) : maxMs;
+}
+
+size_t TimerWheel::size() const {
+    return count_;
+}
+
+void TimerWheel::link(Timer* timer) {
+    Timer*& head = slots_[timer->tick & (SLOTS - 1)];
+    timer->prev = NULL;
+    timer->next = head;
+    if (head) head->prev = timer;
+    head = timer;
+    timer->scheduled = true;
+    ++count_;
+}
+
+void TimerWheel::unlink(Timer* timer) {
+    if (timer->prev) {
+        timer->prev->next = timer->next;
+    } else {
+        slots_[timer->tick & (SLOTS - 1)] = timer->next;
+    }
+    if (timer->next) timer->next->prev = timer->prev;
+    timer->prev = NULL;
+    timer->next = NULL;
+    timer->scheduled = false;
+    --count_;
+}
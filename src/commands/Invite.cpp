@@ -97,7 +97,7 @@ void handleInvite(Server& server, Client& client, const Command& cmd) {
     }
     
     // 8. Add to invite list
-    channel->addToInviteList(target->getNickname());
+    channel->addToInviteList(target->getNickId());
     
     // 9. Send RPL_INVITING (341) to inviter
     server.sendToClient(fd, Replies::numeric(
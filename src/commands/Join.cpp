@@ -20,6 +20,7 @@
 #include "irc/Channel.hpp"
 #include "irc/Command.hpp"
 #include "irc/Replies.hpp"
+#include "irc/ReplyBuilder.hpp"
 #include "irc/Utils.hpp"
 #include "irc/commands/Join.hpp"
 
@@ -90,7 +91,7 @@ void handleJoin(Server& server, Client& client, const Command& cmd) {
     
     // +i: invite only
     if (channel->hasMode('i')) {
-        if (!channel->isInvited(client.getNickname())) {
+        if (!channel->isInvited(client.getNickId())) {
             server.sendToClient(fd, Replies::numeric(
                 Replies::ERR_INVITEONLYCHAN, nick, channel->getNameDisplay(),
                 "Cannot join channel (+i)"));
@@ -108,61 +109,71 @@ void handleJoin(Server& server, Client& client, const Command& cmd) {
         }
     }
     
-    // 7. Add client to channel
-    channel->addClient(&client);
-    client.addChannel(channel->getName());
+    // 7. Add client to channel (one Membership, linked on both sides)
+    Membership* membership = channel->addClient(&client);
     
     // First member becomes operator
     if (isNew || channel->getClientCount() == 1) {
-        channel->addOperator(&client);
+        membership->setFlag(Membership::FLAG_OPERATOR, true);
     }
     
     // Remove from invite list after successful join
-    if (channel->isInvited(client.getNickname())) {
-        channel->removeFromInviteList(client.getNickname());
+    if (channel->isInvited(client.getNickId())) {
+        channel->removeFromInviteList(client.getNickId());
     }
     
     // 8. Send JOIN confirmation to all members (including joiner)
-    std::string joinMsg = ":" + client.getPrefix() + " JOIN :" + 
-                          channel->getNameDisplay() + "\r\n";
+    // Replies below are built in one reused ReplyBuilder: no temporaries
+    const std::string& channelDisplay = channel->getNameDisplay();
+    ReplyBuilder reply;
+    reply.command(client.getPrefix(), "JOIN").trailing(channelDisplay).end();
     
-    server.sendToClient(fd, joinMsg);
-    channel->broadcast(&server, joinMsg, &client);
+    server.sendToClient(fd, reply);
+    channel->broadcast(&server, SharedMessage(reply.data(), reply.size()), &client);
     
     // 9. Send topic (if exists)
+    reply.clear();
     if (channel->hasTopic()) {
         // RPL_TOPIC (332)
-        server.sendToClient(fd, Replies::numeric(
-            Replies::RPL_TOPIC, nick, channel->getNameDisplay(),
-            channel->getTopic()));
+        reply.numeric(Replies::RPL_TOPIC, nick).param(channelDisplay)
+            .trailing(channel->getTopic()).end();
     } else {
         // RPL_NOTOPIC (331)
-        server.sendToClient(fd, Replies::numeric(
-            Replies::RPL_NOTOPIC, nick, channel->getNameDisplay(),
-            "No topic is set"));
+        reply.numeric(Replies::RPL_NOTOPIC, nick).param(channelDisplay)
+            .trailing("No topic is set").end();
     }
+    server.sendToClient(fd, reply);
     
     // 10. Send NAMES list
-    std::vector<Client*> members = channel->getClients();
-    std::string namesList;
-    
-    for (size_t i = 0; i < members.size(); ++i) {
-        if (channel->isOperator(members[i])) {
-            namesList += "@";
+    // RPL_NAMREPLY (353), as many lines as the 512-byte limit needs
+    reply.clear();
+    for (Membership* m = channel->getMembers(); m; m = m->nextInChannel) {
+        const std::string& memberNick = m->client->getNicknameDisplay();
+        bool op = m->hasFlag(Membership::FLAG_OPERATOR);
+        size_t needed = memberNick.size() + (op ? 1 : 0) + 1;
+        
+        if (reply.size() > 0 && reply.remaining() < needed) {
+            server.sendToClient(fd, reply.end());
+            reply.clear();
         }
-        namesList += members[i]->getNicknameDisplay();
-        if (i < members.size() - 1) {
-            namesList += " ";
+        if (reply.size() == 0) {
+            reply.numeric(Replies::RPL_NAMREPLY, nick).param("=").param(channelDisplay)
+                .append(" :", 2);
+        } else {
+            reply.append(' ');
         }
+        if (op) {
+            reply.append('@');
+        }
+        reply.append(memberNick);
+    }
+    if (reply.size() > 0) {
+        server.sendToClient(fd, reply.end());
     }
-    
-    // RPL_NAMREPLY (353)
-    server.sendToClient(fd, Replies::numeric(
-        Replies::RPL_NAMREPLY, nick,
-        "= " + channel->getNameDisplay(), namesList));
     
     // RPL_ENDOFNAMES (366)
-    server.sendToClient(fd, Replies::numeric(
-        Replies::RPL_ENDOFNAMES, nick, channel->getNameDisplay(),
-        "End of /NAMES list"));
+    reply.clear();
+    reply.numeric(Replies::RPL_ENDOFNAMES, nick).param(channelDisplay)
+        .trailing("End of /NAMES list").end();
+    server.sendToClient(fd, reply);
 }
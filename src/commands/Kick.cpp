@@ -20,6 +20,7 @@
 #include "irc/Channel.hpp"
 #include "irc/Command.hpp"
 #include "irc/Replies.hpp"
+#include "irc/ReplyBuilder.hpp"
 #include "irc/commands/Kick.hpp"
 
 // Helper to get param safely
@@ -99,21 +100,15 @@ void handleKick(Server& server, Client& client, const Command& cmd) {
     }
     
     // 8. Build KICK message
-    std::string kickMsg = ":" + client.getPrefix() + " KICK " + 
-                          channel->getNameDisplay() + " " + 
-                          target->getNicknameDisplay() + " :" + 
-                          reason + "\r\n";
+    ReplyBuilder kickMsg;
+    kickMsg.command(client.getPrefix(), "KICK").param(channel->getNameDisplay())
+        .param(target->getNicknameDisplay()).trailing(reason).end();
     
     // 9. Broadcast KICK to all members (including kicked user)
     server.sendToClient(target->getFd(), kickMsg);
-    channel->broadcast(&server, kickMsg, target);
+    channel->broadcast(&server, SharedMessage(kickMsg.data(), kickMsg.size()), target);
     
     // 10. Remove target from channel
-    channel->removeClient(target);
-    target->removeChannel(channel->getName());
-    
-    // 11. If channel is empty, delete it
-    if (channel->isEmpty()) {
-        server.removeChannel(channel->getName());
-    }
+    // 11. If channel is empty, it is deleted (back to the channel pool)
+    server.partChannel(*target, channel);
 }
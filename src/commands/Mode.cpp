@@ -21,6 +21,7 @@
 #include "irc/Channel.hpp"
 #include "irc/Command.hpp"
 #include "irc/Replies.hpp"
+#include "irc/ReplyBuilder.hpp"
 #include "irc/Utils.hpp"
 #include "irc/commands/Mode.hpp"
 
@@ -195,16 +196,17 @@ void handleMode(Server& server, Client& client, const Command& cmd) {
     }
     
     // 7. Broadcast MODE change to all members
-    std::string modeMsg = ":" + client.getPrefix() + " MODE " + 
-                         channel->getNameDisplay() + " " + modeStr;
+    ReplyBuilder modeMsg;
+    modeMsg.command(client.getPrefix(), "MODE")
+        .param(channel->getNameDisplay()).param(modeStr);
     
     // Add parameter for +k, +o, +l
     if ((mode == 'k' || mode == 'o' || mode == 'l') && sign == '+') {
-        modeMsg += " " + getParam(cmd, 2);
+        modeMsg.param(getParam(cmd, 2));
     }
     
-    modeMsg += "\r\n";
+    modeMsg.end();
     
     server.sendToClient(fd, modeMsg);
-    channel->broadcast(&server, modeMsg, &client);
+    channel->broadcast(&server, SharedMessage(modeMsg.data(), modeMsg.size()), &client);
 }
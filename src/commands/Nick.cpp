@@ -73,10 +73,15 @@ void handleNick(Server& server, Client& client, const Command& cmd) {
         return;
     }
     
-    // 4. Check if nickname is already in use (case-insensitive)
-    // getClientByNickname should use Utils::toLower internally
-    Client* existing = server.getClientByNickname(newNick);
-    if (existing && existing != &client) {
+    // 4. Save state for nick change broadcast
+    std::string oldPrefix = client.getPrefix();
+    bool wasRegistered = client.isRegistered();
+    bool hadNick = client.hasNickname();
+    
+    // 5-6. Check if nickname is already in use (case-insensitive) and set it
+    // (stores both casefolded and display version) in one step: the nick
+    // directory cannot change between the check and the rename
+    if (!server.setClientNickname(client, newNick)) {
         server.sendToClient(fd, Replies::numeric(
             Replies::ERR_NICKNAMEINUSE,
             currentNick,
@@ -85,14 +90,6 @@ void handleNick(Server& server, Client& client, const Command& cmd) {
         return;
     }
     
-    // 5. Save state for nick change broadcast
-    std::string oldPrefix = client.getPrefix();
-    bool wasRegistered = client.isRegistered();
-    bool hadNick = client.hasNickname();
-    
-    // 6. Set new nickname (stores both lowercase and display version)
-    client.setNickname(newNick);
-    
     // 7. Advance registration if this is the first NICK and we're at step 1
     if (!wasRegistered && client.getRegistrationStep() == 1) {
         client.completeNickStep();  // step 1 -> 2
@@ -100,19 +97,13 @@ void handleNick(Server& server, Client& client, const Command& cmd) {
     
     // 8. If user already had a nickname, broadcast nick change to all channels
     if (hadNick && wasRegistered) {
-        std::string nickMsg = ":" + oldPrefix + " NICK :" + newNick + "\r\n";
+        SharedMessage nickMsg(":" + oldPrefix + " NICK :" + newNick + "\r\n");
         
         // Also send to the client itself
         server.sendToClient(fd, nickMsg);
         
-        // Broadcast to all channels the user is in
-        const std::vector<std::string>& channels = client.getChannels();
-        for (size_t i = 0; i < channels.size(); ++i) {
-            Channel* chan = server.getChannel(channels[i]);
-            if (chan) {
-                // broadcast() sends to all members except the excluded client
-                chan->broadcast(&server, nickMsg, &client);
-            }
-        }
+        // Everyone sharing a channel with the user, once each however many
+        // channels they share
+        server.broadcastToPeers(client, nickMsg);
     }
 }
@@ -80,11 +80,6 @@ void handlePart(Server& server, Client& client, const Command& cmd) {
     channel->broadcast(&server, partMsg, &client);
     
     // 7. Remove client from channel
-    channel->removeClient(&client);
-    client.removeChannel(channel->getName());
-    
-    // 8. If channel is empty, delete it
-    if (channel->isEmpty()) {
-        server.removeChannel(channel->getName());
-    }
+    // 8. If channel is empty, it is deleted (back to the channel pool)
+    server.partChannel(client, channel);
 }
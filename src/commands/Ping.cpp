@@ -20,6 +20,7 @@
 #include "irc/Client.hpp"
 #include "irc/Command.hpp"
 #include "irc/Replies.hpp"
+#include "irc/ReplyBuilder.hpp"
 #include "irc/commands/Ping.hpp"
 
 // Helper to get param safely
@@ -47,9 +48,9 @@ void handlePing(Server& server, Client& client, const Command& cmd) {
     }
     
     // Send PONG with same token
-    std::string pongMsg = ":" + Replies::formatServerName() + 
-                          " PONG " + Replies::formatServerName() + 
-                          " :" + token + "\r\n";
+    const std::string& serverName = Replies::formatServerName();
+    ReplyBuilder pongMsg;
+    pongMsg.command(serverName, "PONG").param(serverName).trailing(token).end();
     
     server.sendToClient(fd, pongMsg);
 }
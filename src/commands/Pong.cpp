@@ -23,9 +23,9 @@
 
 void handlePong(Server& server, Client& client, const Command& cmd) {
     // Simply acknowledge - client responded to our PING
-    // Update last activity timestamp if implementing timeout
+    // Any input already counts as activity (Server::processMessages() sets
+    // the time the liveness timer looks at), PONG included
     
-    // Suppress unused warnings until timeout tracking is implemented
     (void)server;
     (void)client;
     (void)cmd;
@@ -20,6 +20,7 @@
 #include "irc/Channel.hpp"
 #include "irc/Command.hpp"
 #include "irc/Replies.hpp"
+#include "irc/ReplyBuilder.hpp"
 #include "irc/Utils.hpp"
 #include "irc/commands/Privmsg.hpp"
 
@@ -80,12 +81,15 @@ void handlePrivmsg(Server& server, Client& client, const Command& cmd) {
             return;
         }
         
-        // Format and broadcast message
-        std::string msg = ":" + client.getPrefix() + " PRIVMSG " + 
-                          channel->getNameDisplay() + " :" + message + "\r\n";
+        // Format and broadcast message (cached prefix, no temporaries)
+        ReplyBuilder msg;
+        msg.command(client.getPrefix(), "PRIVMSG")
+            .param(channel->getNameDisplay()).trailing(message).end();
         
         // Broadcast to channel (excluding sender)
-        channel->broadcast(&server, msg, &client);
+        // Low priority: dropped for members over their sendq soft limit
+        channel->broadcast(&server, SharedMessage(msg.data(), msg.size()),
+                           &client, SendQueue::PRIORITY_LOW);
         
     } else {
         // Private message to user
@@ -99,9 +103,9 @@ void handlePrivmsg(Server& server, Client& client, const Command& cmd) {
         }
         
         // Format and send message
-        std::string msg = ":" + client.getPrefix() + " PRIVMSG " + 
-                          targetClient->getNicknameDisplay() + " :" + 
-                          message + "\r\n";
+        ReplyBuilder msg;
+        msg.command(client.getPrefix(), "PRIVMSG")
+            .param(targetClient->getNicknameDisplay()).trailing(message).end();
         
         server.sendToClient(targetClient->getFd(), msg);
     }
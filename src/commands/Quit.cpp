@@ -20,29 +20,24 @@
 #include "irc/Channel.hpp"
 #include "irc/Command.hpp"
 #include "irc/Replies.hpp"
+#include "irc/ReplyBuilder.hpp"
 #include "irc/commands/Quit.hpp"
 
 void handleQuit(Server& server, Client& client, const Command& cmd) {
     // 1. Build QUIT message
     std::string reason = cmd.trailing.empty() ? "Leaving" : cmd.trailing;
-    std::string quitMsg = ":" + client.getPrefix() + " QUIT :" + 
-                          reason + "\r\n";
+    ReplyBuilder reply;
+    reply.command(client.getPrefix(), "QUIT").trailing(reason).end();
+    SharedMessage quitMsg(reply.data(), reply.size());  // one block for all channels
     
-    // 2. Broadcast to all channels the client is in
-    const std::vector<std::string>& channels = client.getChannels();
-    
-    for (size_t i = 0; i < channels.size(); ++i) {
-        Channel* chan = server.getChannel(channels[i]);
-        if (chan) {
-            // Broadcast to all members EXCEPT the quitting client
-            chan->broadcast(&server, quitMsg, &client);
-        }
-    }
+    // 2. Broadcast to everyone sharing a channel with the client
+    // Once per peer (not per shared channel), never to the quitting client
+    server.broadcastToPeers(client, quitMsg);
     
     // 3. Disconnect client (Alex's responsibility)
     // disconnectClient() will:
     // - Remove from all channels
-    // - Remove from clients_ map
+    // - Remove from the connection table
     // - Close socket
     // - Delete Client object
     server.disconnectClient(client.getFd());
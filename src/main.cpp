@@ -3,25 +3,75 @@
 
 #include "irc/Config.hpp"
 #include "irc/Server.hpp"
+#include "irc/Logger.hpp"
 #include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Logger writer thread on stderr or --log-file
+// Returns the fd it writes to, -1 if the log file cannot be opened
+static int startLogging(const Config& config)
+{
+    Logger::Level level = Logger::levelFromName(config.getLogLevel());
+    if (level < IRC_LOG_LEVEL) {
+        std::cerr << "Warning: --log-level " << config.getLogLevel()
+                  << ": built without it (make LOG_LEVEL=" << level << ")" << std::endl;
+    }
+    Logger::setLevel(level);
+    Logger::setRateLimit(static_cast<unsigned long>(config.getLogRate()));
+
+    int fd = 2;
+    if (!config.getLogFile().empty()) {
+        fd = open(config.getLogFile().c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) {
+            std::cerr << "Error: " << config.getLogFile() << ": " << strerror(errno) << std::endl;
+            return -1;
+        }
+    }
+    Logger::instance().start(fd);
+    return fd;
+}
 
 int main(int argc, char** argv)
 {
-    if (argc != 3) {
-        std::cerr << "Usage: ./ircserv <port> <password>" << std::endl;
+    if (argc < 3) {
+        std::cerr << "Usage: ./ircserv <port> <password> [--poller poll|epoll|uring]"
+                  << " [--server-name NAME] [--edge-triggered]"
+                  << " [--threads N] [--cpus 0,1,...]"
+                  << " [--sendq-soft BYTES] [--sendq-hard BYTES]"
+                  << " [--sendq-soft-msgs N] [--sendq-hard-msgs N]"
+                  << " [--sendq-policy drop|pause|both|none]"
+                  << " [--tcp-cork]"
+                  << " [--ping-interval S] [--ping-timeout S]"
+                  << " [--registration-timeout S]"
+                  << " [--log-level debug|info|warn|error|off] [--log-file PATH]"
+                  << " [--log-rate N]" << std::endl;
         return 1;
     }
     
+    Config config = Config::parseArgs(argc, argv);
+    int logFd = startLogging(config);
+    if (logFd < 0) {
+        return 1;
+    }
+
+    int status = 0;
     try {
-        Config config = Config::parseArgs(argc, argv);
         Server server(config);
         server.start();
         server.run();
     } catch (const std::exception& e) {
+        Logger::instance().stop();
         std::cerr << "Error: " << e.what() << std::endl;
-        return 1;
+        status = 1;
     }
-    
-    return 0;
-}
 
+    // Reactors are joined: write out what is still queued
+    Logger::instance().stop();
+    if (logFd > 2) {
+        close(logFd);
+    }
+    return status;
+}
@@ -0,0 +1,117 @@
+// How to run benchmark: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -O2 -pthread -Iinclude src/Channel.cpp src/Client.cpp src/Identifier.cpp src/Membership.cpp src/SharedMessage.cpp src/Utils.cpp tests/bench_Broadcast/bench_Broadcast.cpp -o tests/bench_Broadcast/run_bench_Broadcast
+// ./tests/bench_Broadcast/run_bench_Broadcast
+
+// Channel fan-out cost against member count (10 .. 50k), three ways:
+// 1. std::map:   fd -> Client* tree, compare each member with the sender
+// 2. list:       the channel's Membership list (nextInChannel)
+// 3. broadcast:  Channel::broadcast(), the packed fan-out array
+// Members join in random order, as on a live server. Server::sendToClient
+// is stubbed (not inlined) to a counter: only the walk itself is measured.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <sys/time.h>
+#include "irc/Channel.hpp"
+#include "irc/Client.hpp"
+#include "irc/Membership.hpp"
+#include "irc/Server.hpp"
+#include "irc/SharedMessage.hpp"
+
+// Keeps results alive so the compiler cannot drop the work
+static volatile size_t sink;
+
+// --- Stub: what every recipient costs here is one call ---
+__attribute__((noinline))
+void Server::sendToClient(int fd, const SharedMessage&, SendQueue::Priority) {
+    sink = sink + static_cast<size_t>(fd);
+}
+// ----------------------------------
+
+static double nowUs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1e6 + tv.tv_usec;
+}
+
+static void report(const char* label, double elapsedUs, int broadcasts, int members) {
+    double perBroadcast = elapsedUs / broadcasts;
+    std::cout << std::setw(12) << label << "  " << std::fixed << std::setprecision(2)
+              << std::setw(10) << perBroadcast << " us/msg  "
+              << std::setw(6) << perBroadcast * 1000.0 / members << " ns/member" << std::endl;
+}
+
+static void run(int members) {
+    // ~5M deliveries per method, whatever the channel size
+    int broadcasts = 5000000 / members;
+    if (broadcasts < 20) broadcasts = 20;
+
+    std::vector<Client*> clients;
+    for (int i = 0; i < members; ++i) {
+        clients.push_back(new Client(i + 4));
+    }
+    std::vector<Client*> joinOrder(clients);
+    std::srand(42);
+    std::random_shuffle(joinOrder.begin(), joinOrder.end());
+
+    Channel channel("#bench");
+    std::map<int, Client*> byFd;
+    for (int i = 0; i < members; ++i) {
+        channel.addClient(joinOrder[i]);
+        byFd[joinOrder[i]->getFd()] = joinOrder[i];
+    }
+
+    Server* server = NULL;      // the stub does not touch it
+    SharedMessage message(":nick!user@host PRIVMSG #bench :hello\r\n");
+    Client* sender = clients[members / 2];
+
+    std::cout << members << " members, " << broadcasts << " messages" << std::endl;
+
+    // 1. std::map walk (broadcast before the Membership rework)
+    double start = nowUs();
+    for (int b = 0; b < broadcasts; ++b) {
+        for (std::map<int, Client*>::iterator it = byFd.begin(); it != byFd.end(); ++it) {
+            if (it->second != sender) {
+                server->sendToClient(it->first, message, SendQueue::PRIORITY_LOW);
+            }
+        }
+    }
+    report("std::map", nowUs() - start, broadcasts, members);
+
+    // 2. Membership list walk
+    start = nowUs();
+    for (int b = 0; b < broadcasts; ++b) {
+        for (Membership* m = channel.getMembers(); m; m = m->nextInChannel) {
+            if (m->client != sender) {
+                server->sendToClient(m->client->getFd(), message, SendQueue::PRIORITY_LOW);
+            }
+        }
+    }
+    report("list", nowUs() - start, broadcasts, members);
+
+    // 3. Fan-out array
+    start = nowUs();
+    for (int b = 0; b < broadcasts; ++b) {
+        channel.broadcast(server, message, sender, SendQueue::PRIORITY_LOW);
+    }
+    report("broadcast", nowUs() - start, broadcasts, members);
+    std::cout << std::endl;
+
+    for (int i = 0; i < members; ++i) {
+        channel.removeClient(clients[i]);
+        delete clients[i];
+    }
+}
+
+int main() {
+    const int sizes[] = { 10, 100, 1000, 10000, 50000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        run(sizes[i]);
+    }
+    return 0;
+}
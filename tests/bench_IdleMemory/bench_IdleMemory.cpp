@@ -0,0 +1,157 @@
+// How to run benchmark: from main directory run following 3 lines of code:
+// make
+// c++ -Wall -Wextra -Werror -std=c++98 -O2 tests/bench_IdleMemory/bench_IdleMemory.cpp -o tests/bench_IdleMemory/run_bench_IdleMemory
+// ./tests/bench_IdleMemory/run_bench_IdleMemory [./ircserv] [connections]
+
+// Resident memory of the server per idle connection (Linux, /proc):
+// starts the server, opens N clients and reads the server's VmRSS
+// 1. registered:      PASS/NICK/USER done, nothing pending
+// 2. partial line:    every client then sent half a line ("PING :ha")
+// 3. line completed:  the rest of the line arrived, nothing pending again
+//                     (freed buffers stay in the server's pool for reuse)
+// Bytes per connection = RSS growth over the empty server / N
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <csignal>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+static const int PORT = 16999;
+
+// VmRSS of pid in bytes, 0 if unknown
+static long rssBytes(pid_t pid) {
+    std::ostringstream path;
+    path << "/proc/" << pid << "/status";
+    std::ifstream status(path.str().c_str());
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return std::atol(line.c_str() + 6) * 1024;
+        }
+    }
+    return 0;
+}
+
+static int connectClient() {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void sendAll(int fd, const std::string& data) {
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t n = send(fd, data.data() + off, data.size() - off, 0);
+        if (n <= 0) return;
+        off += static_cast<size_t>(n);
+    }
+}
+
+// Read until the text shows up (welcome / reply), keeps the socket drained
+static void waitFor(int fd, const char* text) {
+    std::string seen;
+    char buf[4096];
+    while (seen.find(text) == std::string::npos) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) return;
+        seen.append(buf, n);
+    }
+}
+
+static void report(const char* label, long rss, long base, int n) {
+    std::cout << std::left << std::setw(18) << label
+              << std::right << std::setw(10) << rss / 1024 << " kB RSS"
+              << std::setw(10) << (rss - base) / n << " bytes/connection" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const char* server = (argc > 1) ? argv[1] : "./ircserv";
+    int n = (argc > 2) ? std::atoi(argv[2]) : 2000;
+
+    struct rlimit lim;
+    getrlimit(RLIMIT_NOFILE, &lim);
+    lim.rlim_cur = lim.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &lim);
+
+    std::ostringstream port;
+    port << PORT;
+    pid_t pid = fork();
+    if (pid == 0) {
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, 1);
+        dup2(devnull, 2);
+        execl(server, server, port.str().c_str(), "pw", "--log-level", "error", (char*)NULL);
+        _exit(127);
+    }
+    usleep(300000);
+
+    // Warm up the server's allocator and pools with one client, then measure
+    int warm = connectClient();
+    if (warm < 0) {
+        std::cerr << "cannot connect to " << server << std::endl;
+        kill(pid, SIGKILL);
+        return 1;
+    }
+    sendAll(warm, "PASS pw\r\nNICK warm\r\nUSER w 0 * :w\r\n");
+    waitFor(warm, " 001 ");
+    usleep(100000);
+    long base = rssBytes(pid);
+
+    std::vector<int> fds;
+    for (int i = 0; i < n; ++i) {
+        int fd = connectClient();
+        if (fd < 0) break;
+        std::ostringstream reg;
+        reg << "PASS pw\r\nNICK idle" << i << "\r\nUSER u 0 * :u\r\n";
+        sendAll(fd, reg.str());
+        waitFor(fd, " 001 ");
+        fds.push_back(fd);
+    }
+    n = static_cast<int>(fds.size());
+    usleep(200000);
+
+    std::cout << n << " connections to " << server << std::endl;
+    report("empty server", base, base, 1);
+    report("registered", rssBytes(pid), base, n);
+
+    for (int i = 0; i < n; ++i) {
+        sendAll(fds[i], "PING :ha");
+    }
+    usleep(300000);
+    report("partial line", rssBytes(pid), base, n);
+
+    for (int i = 0; i < n; ++i) {
+        sendAll(fds[i], "lf\r\n");
+    }
+    usleep(300000);
+    report("line completed", rssBytes(pid), base, n);
+
+    for (int i = 0; i < n; ++i) {
+        close(fds[i]);
+    }
+    close(warm);
+    kill(pid, SIGINT);
+    waitpid(pid, NULL, 0);
+    return 0;
+}
@@ -0,0 +1,130 @@
+// How to run benchmark: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -O2 -Iinclude src/Client.cpp src/Identifier.cpp src/NickDirectory.cpp tests/bench_NickDirectory/bench_NickDirectory.cpp -o tests/bench_NickDirectory/run_bench_NickDirectory
+// ./tests/bench_NickDirectory/run_bench_NickDirectory [users]
+
+// Nick lookup with 100k connected users (default), three ways:
+// 1. scan:      every client in the fd -> Client* map (no nick index)
+// 2. std::map:  folded nick -> Client*, string compares down the tree
+// 3. directory: NickDirectory (what Server::getClientByNickname uses)
+// Lookups are by the name as typed ("User123" style mixed case), half of
+// them for nicks nobody has. Also the cost of a NICK change per directory.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/time.h>
+#include "irc/Client.hpp"
+#include "irc/Identifier.hpp"
+#include "irc/NickDirectory.hpp"
+
+static double nowUs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1e6 + tv.tv_usec;
+}
+
+// Keeps results alive so the compiler cannot drop the work
+static volatile size_t sink;
+
+static std::string nickFor(int i, bool upper) {
+    char buffer[32];
+    std::sprintf(buffer, upper ? "USER%d" : "User%d", i);
+    return buffer;
+}
+
+static void report(const char* label, double elapsedUs, int operations) {
+    std::cout << std::setw(22) << label << "  " << std::fixed << std::setprecision(1)
+              << elapsedUs * 1000.0 / operations << " ns/op" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int users = (argc > 1) ? std::atoi(argv[1]) : 100000;
+    if (users < 1) users = 1;
+
+    std::vector<Client*> clients;
+    std::map<int, Client*> byFd;
+    std::map<std::string, Client*> byName;
+    NickDirectory directory;
+
+    for (int i = 0; i < users; ++i) {
+        Client* client = new Client(i + 4);
+        client->setNickname(nickFor(i, false));
+        clients.push_back(client);
+        byFd[client->getFd()] = client;
+        byName[client->getNickname()] = client;
+        directory.insert(client->getNickId(), client);
+    }
+
+    // Queries as typed: every other one for a nick that is not connected
+    const int queries = 200000;
+    std::vector<std::string> names;
+    std::srand(42);
+    for (int i = 0; i < queries; ++i) {
+        int n = std::rand() % users;
+        names.push_back(nickFor((i % 2) ? n + users : n, (i % 4) == 0));
+    }
+
+    std::cout << users << " users, directory " << directory.size() << " nicks in "
+              << directory.capacity() << " slots" << std::endl;
+
+    // 1. Scan (fewer queries: O(users) each)
+    int scanQueries = queries / 200;
+    double start = nowUs();
+    for (int q = 0; q < scanQueries; ++q) {
+        std::string folded = Identifier::fold(names[q]);
+        Client* found = NULL;
+        for (std::map<int, Client*>::const_iterator it = byFd.begin(); it != byFd.end(); ++it) {
+            if (it->second->getNickname() == folded) {
+                found = it->second;
+                break;
+            }
+        }
+        sink = reinterpret_cast<size_t>(found);
+    }
+    report("scan clients_", nowUs() - start, scanQueries);
+
+    // 2. std::map by folded name
+    start = nowUs();
+    for (int q = 0; q < queries; ++q) {
+        std::map<std::string, Client*>::const_iterator it = byName.find(Identifier::fold(names[q]));
+        sink = reinterpret_cast<size_t>(it != byName.end() ? it->second : NULL);
+    }
+    report("std::map<nick>", nowUs() - start, queries);
+
+    // 3. Directory, by raw name
+    start = nowUs();
+    for (int q = 0; q < queries; ++q) {
+        sink = reinterpret_cast<size_t>(directory.find(names[q]));
+    }
+    report("NickDirectory", nowUs() - start, queries);
+
+    // 3b. Directory, by handle (caller already holds the Identifier)
+    start = nowUs();
+    for (int q = 0; q < queries; ++q) {
+        sink = reinterpret_cast<size_t>(directory.find(clients[q % users]->getNickId()));
+    }
+    report("NickDirectory (id)", nowUs() - start, queries);
+
+    // NICK change: rename in the directory and on the client
+    int renames = (users < queries) ? users : queries;
+    start = nowUs();
+    for (int i = 0; i < renames; ++i) {
+        Client* client = clients[i];
+        Identifier newNick(nickFor(i + 2 * users, false));
+        if (directory.rename(client, client->getNickId(), newNick)) {
+            client->setNickname(newNick.str());
+        }
+    }
+    report("NICK change", nowUs() - start, renames);
+    sink = directory.size();
+
+    for (size_t i = 0; i < clients.size(); ++i) {
+        directory.remove(clients[i]->getNickId(), clients[i]);
+        delete clients[i];
+    }
+    return 0;
+}
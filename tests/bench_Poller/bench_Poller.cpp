@@ -0,0 +1,304 @@
+// How to run benchmark: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -O2 -D__LINUX__ -Itests/bench_Poller/include -Iinclude src/Poller.cpp src/IoUring.cpp src/Logger.cpp tests/bench_Poller/bench_Poller.cpp -o tests/bench_Poller/run_bench_Poller
+// ./tests/bench_Poller/run_bench_Poller
+
+// Compares Poller backends (poll / epoll / uring) on:
+// 1. recv fan-in: N connected sockets, only a few readable per loop iteration
+// 2. accept storm: many clients connecting at once to the listening socket
+// 3. send fan-out: one line to every socket, a writev() each or (uring)
+//    one sendmsg each, all submitted by a single poll()
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "irc/Poller.hpp"
+#include "irc/Server.hpp"
+
+// --- Mock Server Implementation ---
+// Implementation of the mock Server class defined in tests/bench_Poller/include/irc/Server.hpp
+
+Server::Server() : serverFd_(-1), poller_(NULL), bytes_(0), sent_(0), accepted_(0) {}
+
+int Server::getServerFd() const {
+    return serverFd_;
+}
+
+int Server::getWakeFd() const {
+    return -1;
+}
+
+void Server::handleWakeup() {}
+
+void Server::handleNewConnection() {
+    int fd = accept(serverFd_, NULL, NULL);
+    if (fd >= 0) {
+        acceptConnection(fd);
+    }
+}
+
+void Server::acceptConnection(int clientFd) {
+    fcntl(clientFd, F_SETFL, fcntl(clientFd, F_GETFL, 0) | O_NONBLOCK);
+    ++accepted_;
+    poller_->addFd(clientFd, POLLIN);
+}
+
+void Server::handleClientInput(int clientFd) {
+    char buffer[4096];
+    ssize_t n = recv(clientFd, buffer, sizeof(buffer), 0);
+    if (n > 0) {
+        handleClientData(clientFd, buffer, static_cast<size_t>(n));
+    } else if (n == 0) {
+        disconnectClient(clientFd);
+    }
+}
+
+void Server::handleClientData(int clientFd, const char* data, size_t length) {
+    (void)clientFd;
+    (void)data;
+    bytes_ += length;
+}
+
+void Server::handleClientOutput(int clientFd) {
+    (void)clientFd;
+}
+
+void Server::handleSendComplete(int clientFd, int result) {
+    (void)clientFd;
+    if (result > 0) {
+        sent_ += static_cast<size_t>(result);
+    }
+}
+
+void Server::disconnectClient(int clientFd) {
+    poller_->removeFd(clientFd);
+    close(clientFd);
+}
+// ----------------------------------
+
+static double nowUs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1e6 + tv.tv_usec;
+}
+
+// Poller logs every event on std::cout: mute it while measuring
+static void muteCout() {
+    std::cout.setstate(std::ios::badbit);
+}
+
+static void unmuteCout() {
+    std::cout.clear();
+}
+
+static void raiseFdLimit() {
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+}
+
+// N watched sockets, `active` of them written per iteration
+static void benchFanIn(Poller::Backend backend, int connections, int active, int iterations) {
+    Server server;
+    Poller poller(&server, backend);
+    server.poller_ = &poller;
+
+    std::vector<int> readers;
+    std::vector<int> writers;
+    for (int i = 0; i < connections; ++i) {
+        int sv[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+            std::cerr << "socketpair failed at " << i << ": " << strerror(errno) << std::endl;
+            break;
+        }
+        fcntl(sv[0], F_SETFL, O_NONBLOCK);
+        poller.addFd(sv[0], POLLIN);
+        readers.push_back(sv[0]);
+        writers.push_back(sv[1]);
+    }
+    poller.poll(0);  // let io_uring arm its recvs
+
+    const char line[] = "PRIVMSG #bench :hello world\r\n";
+    size_t expected = 0;
+    srand(42);
+    double start = nowUs();
+    for (int it = 0; it < iterations; ++it) {
+        for (int a = 0; a < active; ++a) {
+            if (write(writers[rand() % writers.size()], line, sizeof(line) - 1) > 0)
+                expected += sizeof(line) - 1;
+        }
+        while (server.bytes_ < expected) {
+            if (poller.poll(100) > 0) {
+                poller.processEvents();
+            }
+        }
+    }
+    double elapsed = nowUs() - start;
+
+    for (size_t i = 0; i < writers.size(); ++i) {
+        server.disconnectClient(readers[i]);
+        close(writers[i]);
+    }
+
+    unmuteCout();
+    std::cout << std::setw(6) << Poller::backendName(poller.getBackend())
+              << "  fan-in  conns=" << std::setw(6) << writers.size()
+              << "  active=" << active
+              << "  " << std::fixed << std::setprecision(2)
+              << elapsed / iterations << " us/iteration" << std::endl;
+    muteCout();
+}
+
+// `clients` connect() at once, time until the Poller accepted all of them
+static void benchAcceptStorm(Poller::Backend backend, int clients) {
+    Server server;
+    server.serverFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    bind(server.serverFd_, (struct sockaddr*)&addr, sizeof(addr));
+    listen(server.serverFd_, clients);
+    fcntl(server.serverFd_, F_SETFL, O_NONBLOCK);
+    socklen_t len = sizeof(addr);
+    getsockname(server.serverFd_, (struct sockaddr*)&addr, &len);
+
+    Poller* poller = new Poller(&server, backend);
+    server.poller_ = poller;
+    poller->addFd(server.serverFd_, POLLIN);
+    poller->poll(0);
+
+    std::vector<int> fds;
+    for (int i = 0; i < clients; ++i) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        connect(fd, (struct sockaddr*)&addr, sizeof(addr));
+        fds.push_back(fd);
+    }
+
+    double start = nowUs();
+    int iterations = 0;
+    while (server.accepted_ < fds.size()) {
+        if (poller->poll(100) > 0) {
+            poller->processEvents();
+        }
+        ++iterations;
+    }
+    double elapsed = nowUs() - start;
+
+    Poller::Backend used = poller->getBackend();
+    delete poller;
+    for (size_t i = 0; i < fds.size(); ++i) {
+        close(fds[i]);
+    }
+    close(server.serverFd_);
+
+    unmuteCout();
+    std::cout << std::setw(6) << Poller::backendName(used)
+              << "  accept  clients=" << std::setw(5) << clients
+              << "  " << std::fixed << std::setprecision(1)
+              << elapsed << " us total, " << iterations << " loop iterations" << std::endl;
+    muteCout();
+}
+
+// One line to each of N sockets per iteration (a channel broadcast);
+// only the sends are timed, the peers are drained outside
+static void benchFanOut(Poller::Backend backend, int connections, int iterations) {
+    Server server;
+    Poller poller(&server, backend);
+    server.poller_ = &poller;
+
+    std::vector<int> senders;
+    std::vector<int> peers;
+    for (int i = 0; i < connections; ++i) {
+        int sv[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+            std::cerr << "socketpair failed at " << i << ": " << strerror(errno) << std::endl;
+            break;
+        }
+        fcntl(sv[0], F_SETFL, O_NONBLOCK);
+        fcntl(sv[1], F_SETFL, O_NONBLOCK);
+        poller.addFd(sv[0], POLLIN);
+        senders.push_back(sv[0]);
+        peers.push_back(sv[1]);
+    }
+    poller.poll(0);
+
+    char line[] = ":nick!user@host PRIVMSG #bench :hello world\r\n";
+    struct iovec iov;
+    iov.iov_base = line;
+    iov.iov_len = sizeof(line) - 1;
+    bool ring = poller.canSubmitSends();
+    char drain[4096];
+    double elapsed = 0;
+    for (int it = 0; it < iterations; ++it) {
+        size_t expected = server.sent_ + senders.size() * iov.iov_len;
+        double start = nowUs();
+        for (size_t i = 0; i < senders.size(); ++i) {
+            if (!ring || !poller.submitSend(senders[i], &iov, 1)) {
+                ssize_t n = writev(senders[i], &iov, 1);
+                if (n > 0) server.sent_ += static_cast<size_t>(n);
+            }
+        }
+        while (server.sent_ < expected) {
+            if (poller.poll(100) > 0) {
+                poller.processEvents();
+            }
+        }
+        elapsed += nowUs() - start;
+        for (size_t i = 0; i < peers.size(); ++i) {
+            while (read(peers[i], drain, sizeof(drain)) > 0) {
+            }
+        }
+    }
+
+    for (size_t i = 0; i < senders.size(); ++i) {
+        server.disconnectClient(senders[i]);
+        close(peers[i]);
+    }
+
+    unmuteCout();
+    std::cout << std::setw(6) << Poller::backendName(poller.getBackend())
+              << "  fan-out conns=" << std::setw(6) << senders.size()
+              << "  " << (ring ? "sendmsg" : "writev ")
+              << "  " << std::fixed << std::setprecision(2)
+              << elapsed / iterations << " us/iteration" << std::endl;
+    muteCout();
+}
+
+int main() {
+    raiseFdLimit();
+    Poller::Backend backends[] = {
+        Poller::BACKEND_POLL, Poller::BACKEND_EPOLL, Poller::BACKEND_URING
+    };
+    int sizes[] = { 100, 1000, 8000 };
+
+    muteCout();
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); ++b) {
+            benchFanIn(backends[b], sizes[s], 10, 2000);
+        }
+    }
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); ++b) {
+        benchAcceptStorm(backends[b], 1000);
+    }
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); ++b) {
+            benchFanOut(backends[b], sizes[s], 200);
+        }
+    }
+    unmuteCout();
+    return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include <cstddef>
+
+class Poller;
+
+// Mock Server for bench_Poller: only what Poller calls back
+class Server {
+public:
+    Server();
+
+    int getServerFd() const;
+    int getWakeFd() const;
+    void handleWakeup();
+    void handleNewConnection();
+    void acceptConnection(int clientFd);
+    void handleClientInput(int clientFd);
+    void handleClientData(int clientFd, const char* data, size_t length);
+    void handleClientOutput(int clientFd);
+    void handleSendComplete(int clientFd, int result);
+    void disconnectClient(int clientFd);
+
+    int serverFd_;
+    Poller* poller_;
+    size_t bytes_;
+    size_t sent_;
+    size_t accepted_;
+};
+
+#endif
@@ -0,0 +1,221 @@
+// How to run benchmark: from main directory run following 3 lines of code:
+// make
+// c++ -Wall -Wextra -Werror -std=c++98 -O2 -pthread tests/bench_Reactors/bench_Reactors.cpp -o tests/bench_Reactors/run_bench_Reactors
+// ./tests/bench_Reactors/run_bench_Reactors [./ircserv] [connections] [rounds]
+
+// Command throughput of the server with 1, 2 and 4 reactors (--threads):
+// starts the server for each count, connects N clients spread over 4
+// driver threads and runs rounds of BATCH pipelined lines per client
+// 1. ping:     PING, answered to the sender (work on the owner reactor)
+// 2. privmsg:  PRIVMSG to a partner client, which is often owned by the
+//              other reactor (mailbox + wake socket)
+// Each driver waits for every reply of a round before the next one.
+// Lines/s is every reply received / wall time. It can only grow with the
+// reactor count when the machine has cores to spare for both the server
+// and the drivers (the drivers take one core each).
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+static const int PORT = 17100;
+static const int DRIVERS = 4;
+static const int BATCH = 20;
+
+static double nowUs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1e6 + tv.tv_usec;
+}
+
+static int connectClient(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void sendAll(int fd, const std::string& data) {
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t n = send(fd, data.data() + off, data.size() - off, 0);
+        if (n <= 0) return;
+        off += static_cast<size_t>(n);
+    }
+}
+
+// Read until the text shows up (welcome), keeps the socket drained
+static void waitFor(int fd, const char* text) {
+    std::string seen;
+    char buf[4096];
+    while (seen.find(text) == std::string::npos) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) return;
+        seen.append(buf, n);
+    }
+}
+
+// Read until `lines` lines arrived on fd
+static bool readLines(int fd, int lines) {
+    char buf[4096];
+    while (lines > 0) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) return false;
+        for (ssize_t i = 0; i < n; ++i) {
+            if (buf[i] == '\n') --lines;
+        }
+    }
+    return true;
+}
+
+struct Driver {
+    std::vector<int> fds;
+    std::vector<std::string> batches;   // one round of input per client
+    int rounds;
+    long replies;
+};
+
+// Clients 2k and 2k+1 of a driver talk to each other (privmsg), so every
+// reply of a round comes back to the same driver
+static void* drive(void* arg) {
+    Driver* d = static_cast<Driver*>(arg);
+    for (int r = 0; r < d->rounds; ++r) {
+        for (size_t i = 0; i < d->fds.size(); ++i) {
+            sendAll(d->fds[i], d->batches[i]);
+        }
+        for (size_t i = 0; i < d->fds.size(); ++i) {
+            if (!readLines(d->fds[i], BATCH)) return NULL;
+            d->replies += BATCH;
+        }
+    }
+    return NULL;
+}
+
+static pid_t startServer(const char* server, int port, int threads) {
+    std::ostringstream portArg;
+    std::ostringstream threadsArg;
+    portArg << port;
+    threadsArg << threads;
+    pid_t pid = fork();
+    if (pid == 0) {
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, 1);
+        dup2(devnull, 2);
+        execl(server, server, portArg.str().c_str(), "pw", "--threads", threadsArg.str().c_str(),
+              "--log-level", "error", (char*)NULL);
+        _exit(127);
+    }
+    usleep(300000);
+    return pid;
+}
+
+static void run(const char* server, int threads, bool privmsg, int n, int rounds) {
+    int port = PORT + threads * 2 + (privmsg ? 1 : 0);
+    pid_t pid = startServer(server, port, threads);
+
+    Driver drivers[DRIVERS];
+    int per = n / DRIVERS;
+    bool ok = true;
+    for (int d = 0; d < DRIVERS && ok; ++d) {
+        drivers[d].rounds = rounds;
+        drivers[d].replies = 0;
+        for (int i = 0; i < per; ++i) {
+            int fd = connectClient(port);
+            if (fd < 0) {
+                ok = false;
+                break;
+            }
+            std::ostringstream reg;
+            reg << "PASS pw\r\nNICK c" << d << "x" << i << "\r\nUSER u 0 * :u\r\n";
+            sendAll(fd, reg.str());
+            waitFor(fd, " 001 ");
+            drivers[d].fds.push_back(fd);
+
+            std::ostringstream batch;
+            for (int b = 0; b < BATCH; ++b) {
+                if (privmsg) {
+                    batch << "PRIVMSG c" << d << "x" << (i ^ 1) << " :message " << b << "\r\n";
+                } else {
+                    batch << "PING :" << b << "\r\n";
+                }
+            }
+            drivers[d].batches.push_back(batch.str());
+        }
+    }
+    if (!ok || per % 2) {
+        std::cerr << "cannot connect " << n << " clients (even count per driver) to "
+                  << server << std::endl;
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+        return;
+    }
+
+    pthread_t tids[DRIVERS];
+    double start = nowUs();
+    for (int d = 0; d < DRIVERS; ++d) {
+        pthread_create(&tids[d], NULL, &drive, &drivers[d]);
+    }
+    long replies = 0;
+    for (int d = 0; d < DRIVERS; ++d) {
+        pthread_join(tids[d], NULL);
+        replies += drivers[d].replies;
+    }
+    double elapsed = nowUs() - start;
+
+    for (int d = 0; d < DRIVERS; ++d) {
+        for (size_t i = 0; i < drivers[d].fds.size(); ++i) {
+            close(drivers[d].fds[i]);
+        }
+    }
+    kill(pid, SIGINT);
+    waitpid(pid, NULL, 0);
+
+    std::cout << std::left << std::setw(8) << (privmsg ? "privmsg" : "ping") << std::right
+              << " threads=" << threads
+              << "  clients=" << n
+              << "  " << std::setw(9) << static_cast<long>(replies / (elapsed / 1e6)) << " lines/s"
+              << "  (" << replies << " in " << std::fixed << std::setprecision(0)
+              << elapsed / 1000 << " ms)" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const char* server = (argc > 1) ? argv[1] : "./ircserv";
+    int n = (argc > 2) ? std::atoi(argv[2]) : 64;
+    int rounds = (argc > 3) ? std::atoi(argv[3]) : 200;
+
+    struct rlimit lim;
+    getrlimit(RLIMIT_NOFILE, &lim);
+    lim.rlim_cur = lim.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &lim);
+    signal(SIGPIPE, SIG_IGN);
+
+    std::cout << sysconf(_SC_NPROCESSORS_ONLN) << " CPUs online" << std::endl;
+    int threads[] = { 1, 2, 4 };
+    for (int privmsg = 0; privmsg < 2; ++privmsg) {
+        for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+            run(server, threads[t], privmsg != 0, n, rounds);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+// How to run benchmark: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -O2 -Iinclude src/Replies.cpp src/ReplyBuilder.cpp tests/bench_Replies/bench_Replies.cpp -o tests/bench_Replies/run_bench_Replies
+// ./tests/bench_Replies/run_bench_Replies
+
+// Cost of formatting one numeric reply (RPL_TOPIC) three ways:
+// 1. stringstream: Replies::numeric() before ReplyBuilder
+// 2. Replies::numeric(): same std::string API, built by ReplyBuilder
+// 3. ReplyBuilder: what a handler passes to Server::sendToClient()
+// Reported as ns and heap allocations per reply
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <new>
+#include <sys/time.h>
+#include "irc/Replies.hpp"
+#include "irc/ReplyBuilder.hpp"
+#include "irc/Client.hpp"
+
+// --- Stub: Replies::formatClientPrefix() links against Client (not timed here) ---
+const std::string& Client::getPrefix() const {
+    return prefix_;
+}
+
+// --- Allocation counter: every operator new in this program ---
+static unsigned long allocations = 0;
+
+void* operator new(size_t size) throw(std::bad_alloc) {
+    ++allocations;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) throw() {
+    std::free(p);
+}
+
+static double nowUs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1e6 + tv.tv_usec;
+}
+
+// Keeps results alive so the compiler cannot drop the work
+static volatile size_t sink;
+
+static const std::string nick = "somebody";
+static const std::string channel = "#performance";
+static const std::string topic = "Benchmarks, profiles and other numbers";
+
+// Replies::numeric() as it was before ReplyBuilder
+static std::string stringstreamNumeric(const std::string& numeric, const std::string& nickname,
+                                       const std::string& params, const std::string& trailing) {
+    std::stringstream ss;
+    ss << ":" << Replies::formatServerName() << " " << numeric << " " << nickname;
+    if (!params.empty())
+        ss << " " << params;
+    if (!trailing.empty())
+        ss << " :" << trailing;
+    ss << "\r\n";
+    return ss.str();
+}
+
+static void runStringstream() {
+    std::string reply = stringstreamNumeric(Replies::RPL_TOPIC, nick, channel, topic);
+    sink = reply.size();
+}
+
+static void runReplies() {
+    std::string reply = Replies::numeric(Replies::RPL_TOPIC, nick, channel, topic);
+    sink = reply.size();
+}
+
+static void runBuilder() {
+    ReplyBuilder reply;
+    reply.numeric(Replies::RPL_TOPIC, nick).param(channel).trailing(topic).end();
+    sink = reply.size();
+}
+
+static void bench(const char* label, void (*run)(), int iterations) {
+    run();  // warm up (static init, first-use allocations)
+    unsigned long before = allocations;
+    double start = nowUs();
+    for (int i = 0; i < iterations; ++i) {
+        run();
+    }
+    double elapsed = nowUs() - start;
+    unsigned long allocated = allocations - before;
+
+    std::cout << std::setw(18) << label << "  " << std::fixed << std::setprecision(1)
+              << elapsed * 1000.0 / iterations << " ns/reply  "
+              << std::setprecision(2) << static_cast<double>(allocated) / iterations
+              << " allocations/reply" << std::endl;
+}
+
+int main() {
+    const int iterations = 1000000;
+    bench("stringstream", runStringstream, iterations);
+    bench("Replies::numeric", runReplies, iterations);
+    bench("ReplyBuilder", runBuilder, iterations);
+    return 0;
+}
@@ -0,0 +1,156 @@
+// How to run benchmark: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -O2 -Iinclude src/Scanner.cpp tests/bench_Scanner/bench_Scanner.cpp -o tests/bench_Scanner/run_bench_Scanner
+// ./tests/bench_Scanner/run_bench_Scanner
+
+// Compares line splitting + tokenizing of a pipelined input buffer:
+// 1. memchr: the code before Scanner (MessageBuffer memchr for '\r',
+//    Parser memchr for every ' ' up to the trailing parameter)
+// 2. Scanner scalar / sse2 / avx2 (scanLine: line end + index in one pass,
+//    what MessageBuffer::nextLine() hands to Parser::parse())
+// Reported as bytes per cycle (rdtsc on x86, bytes per ns elsewhere),
+// best of BENCH_REPEAT runs
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <sys/time.h>
+#include "irc/Scanner.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+# define BENCH_UNIT "bytes/cycle"
+static unsigned long long ticks() { return __rdtsc(); }
+#else
+# define BENCH_UNIT "bytes/ns"
+static unsigned long long ticks() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000000ULL + tv.tv_usec * 1000ULL;
+}
+#endif
+
+static const size_t NPOS = static_cast<size_t>(-1);
+static const int BENCH_REPEAT = 5;
+
+// Keeps results alive so the compiler cannot drop the work
+static volatile size_t sink;
+
+// --- Before Scanner ---
+
+static size_t memchrLineEnd(const char* data, size_t length) {
+    size_t start = 0;
+    while (start + 1 < length) {
+        const void* cr = std::memchr(data + start, '\r', length - start - 1);
+        if (!cr) return NPOS;
+        size_t pos = static_cast<const char*>(cr) - data;
+        if (data[pos + 1] == '\n') return pos;
+        start = pos + 1;
+    }
+    return NPOS;
+}
+
+// Same separators Parser::parse() used to find one memchr at a time
+static size_t memchrTokens(const char* line, size_t length) {
+    size_t pos = 0;
+    size_t tokens = 0;
+    while (pos < length && line[pos] == ' ') ++pos;
+    while (pos < length) {
+        if (tokens > 0 && line[pos] == ':') break;
+        const void* space = std::memchr(line + pos, ' ', length - pos);
+        ++tokens;
+        if (!space) break;
+        pos = static_cast<const char*>(space) - line + 1;
+    }
+    return tokens;
+}
+
+static size_t runMemchr(const std::string& input) {
+    const char* data = input.data();
+    size_t length = input.length();
+    size_t total = 0;
+    while (length > 0) {
+        size_t end = memchrLineEnd(data, length);
+        if (end == NPOS) break;
+        total += memchrTokens(data, end);
+        data += end + 2;
+        length -= end + 2;
+    }
+    return total;
+}
+
+static size_t runScanner(const std::string& input) {
+    const char* data = input.data();
+    size_t length = input.length();
+    size_t total = 0;
+    LineIndex index;
+    while (length > 0) {
+        size_t end = Scanner::scanLine(data, length, index);
+        if (end == NPOS) break;
+        total += index.spaceCount + 1;
+        data += end + 2;
+        length -= end + 2;
+    }
+    return total;
+}
+
+// --- Workloads ---
+
+static std::string makeInput(size_t textLength, size_t bytes) {
+    std::string text;
+    while (text.length() < textLength) text += "lorem ipsum dolor ";
+    text.resize(textLength);
+
+    const char* heads[] = {
+        ":nick!user@host.example PRIVMSG #channel :",
+        "PRIVMSG #a,#b,#c :",
+        "MODE #channel +ov alice bob",
+        "JOIN #channel,#other key1,key2",
+        "PING :irc.example.net"
+    };
+    std::string input;
+    for (size_t i = 0; input.length() < bytes; ++i) {
+        size_t h = i % (sizeof(heads) / sizeof(heads[0]));
+        input += heads[h];
+        if (h < 2) input += text;
+        input += "\r\n";
+    }
+    return input;
+}
+
+// Best throughput of BENCH_REPEAT runs of `rounds` passes over input
+static double measure(size_t (*run)(const std::string&), const std::string& input, int rounds) {
+    double best = 0;
+    for (int rep = 0; rep < BENCH_REPEAT; ++rep) {
+        unsigned long long start = ticks();
+        for (int r = 0; r < rounds; ++r) sink = run(input);
+        unsigned long long elapsed = ticks() - start;
+        double rate = static_cast<double>(input.length()) * rounds / elapsed;
+        if (rate > best) best = rate;
+    }
+    return best;
+}
+
+static void report(const char* label, const char* variant, double rate) {
+    std::cout << std::setw(10) << label << "  " << std::setw(7) << variant
+              << "  " << std::fixed << std::setprecision(3)
+              << rate << " " BENCH_UNIT << std::endl;
+}
+
+static void bench(const char* label, const std::string& input, int rounds) {
+    report(label, "memchr", measure(runMemchr, input, rounds));
+
+    Scanner::Impl impls[] = { Scanner::IMPL_SCALAR, Scanner::IMPL_SSE2, Scanner::IMPL_AVX2 };
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); ++i) {
+        if (!Scanner::setImpl(impls[i])) continue;
+        report(label, Scanner::implName(impls[i]), measure(runScanner, input, rounds));
+    }
+}
+
+int main() {
+    const size_t bytes = 1 << 20;
+    bench("text=16", makeInput(16, bytes), 100);
+    bench("text=100", makeInput(100, bytes), 100);
+    bench("text=400", makeInput(400, bytes), 100);
+    return 0;
+}
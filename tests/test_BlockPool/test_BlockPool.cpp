@@ -0,0 +1,131 @@
+// How to run test: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -D__LINUX__ -I include src/BlockPool.cpp src/MessageBuffer.cpp src/Scanner.cpp src/Logger.cpp tests/test_BlockPool/test_BlockPool.cpp -o tests/test_BlockPool/run_test_BlockPool
+// ./tests/test_BlockPool/run_test_BlockPool
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <set>
+#include <vector>
+#include <cstring>
+#include "irc/BlockPool.hpp"
+#include "irc/MessageBuffer.hpp"
+
+void printPass(const std::string& testName)
+{
+    std::cout << "[PASS] " << testName << std::endl;
+}
+
+void test_acquire_release()
+{
+    BlockPool pool(4096, 4);
+    assert(pool.capacity() == 0 && pool.live() == 0);
+
+    // Distinct, writable, blockSize() apart at least
+    std::vector<char*> blocks;
+    std::set<char*> seen;
+    for (int i = 0; i < 10; ++i) {
+        char* block = pool.acquire();
+        std::memset(block, i, pool.blockSize());
+        assert(seen.insert(block).second);
+        blocks.push_back(block);
+    }
+    assert(pool.live() == 10 && pool.peak() == 10);
+    assert(pool.capacity() == 12);     // three slabs of 4
+    for (int i = 0; i < 10; ++i) {
+        assert(blocks[i][0] == i && blocks[i][4095] == i);
+    }
+
+    // Last released, first reused; no new slab
+    pool.release(blocks[3]);
+    pool.release(blocks[7]);
+    assert(pool.live() == 8);
+    assert(pool.acquire() == blocks[7]);
+    assert(pool.acquire() == blocks[3]);
+    assert(pool.capacity() == 12 && pool.peak() == 10);
+    pool.release(NULL);
+    assert(pool.live() == 10);
+
+    for (int i = 0; i < 10; ++i) {
+        pool.release(blocks[i]);
+    }
+    assert(pool.live() == 0 && pool.capacity() == 12);
+
+    printPass("Blocks reused, slabs kept");
+}
+
+void test_warm_and_cold()
+{
+    BlockPool pool(8192, 4, 2);
+    char* blocks[4];
+    for (int i = 0; i < 4; ++i) {
+        blocks[i] = pool.acquire();
+        std::memset(blocks[i], 'a' + i, pool.blockSize());
+    }
+
+    // Two stay resident, the pages of the other two are given back
+    for (int i = 0; i < 4; ++i) {
+        pool.release(blocks[i]);
+    }
+    assert(pool.live() == 0 && pool.warm() == 2);
+    assert(blocks[0][0] == 'a' && blocks[1][8191] == 'b');
+#ifdef __LINUX__
+    assert(blocks[2][0] == 0 && blocks[3][8191] == 0);     // MADV_DONTNEED: fresh zero pages
+#endif
+
+    // Warm ones first (last released first), then the cold ones
+    assert(pool.acquire() == blocks[1]);
+    assert(pool.acquire() == blocks[0]);
+    assert(pool.acquire() == blocks[3]);
+    assert(pool.acquire() == blocks[2]);
+    assert(pool.capacity() == 4 && pool.warm() == 0);
+    blocks[3][0] = 'x';     // usable again
+    for (int i = 0; i < 4; ++i) {
+        pool.release(blocks[i]);
+    }
+
+    printPass("Free blocks beyond the warm ones are discarded");
+}
+
+void test_message_buffer_on_block()
+{
+    BlockPool pool(64, 2);
+    char* block = pool.acquire();
+
+    // Lines in the block handed in
+    MessageBuffer* buf = new MessageBuffer(block, pool.blockSize());
+    assert(buf->block() == block);
+    assert(buf->capacity() == 64 && buf->writableData() == block);
+    buf->append("PING :a\r\nPRIVMSG #c :");
+    const char* line;
+    size_t length;
+    assert(buf->nextLine(line, length) && std::string(line, length) == "PING :a");
+    assert(line == block);
+
+    // Past the block: continues on the heap, the block stays the caller's
+    buf->append(std::string(100, 'x'));
+    assert(buf->size() == 12 + 100);
+    assert(buf->data() < block || buf->data() >= block + 64);
+    buf->append("\r\n");
+    assert(buf->nextLine(line, length) && length == 112);
+    assert(buf->block() == block);
+    delete buf;
+    pool.release(block);
+    assert(pool.live() == 0);
+
+    // Own storage: no block
+    MessageBuffer own(32);
+    assert(own.block() == NULL);
+
+    printPass("MessageBuffer on a pooled block");
+}
+
+int main()
+{
+    test_acquire_release();
+    test_warm_and_cold();
+    test_message_buffer_on_block();
+
+    std::cout << "\nAll BlockPool tests passed!" << std::endl;
+    return 0;
+}
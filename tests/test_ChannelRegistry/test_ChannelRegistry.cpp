@@ -0,0 +1,242 @@
+// How to run test: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -pthread -I include src/Channel.cpp src/ChannelRegistry.cpp src/Client.cpp src/Identifier.cpp src/Membership.cpp src/SharedMessage.cpp src/Utils.cpp tests/test_ChannelRegistry/test_ChannelRegistry.cpp -o tests/test_ChannelRegistry/run_test_ChannelRegistry
+// ./tests/test_ChannelRegistry/run_test_ChannelRegistry
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <cstdio>
+#include "irc/Channel.hpp"
+#include "irc/Client.hpp"
+#include "irc/Membership.hpp"
+#include "irc/ChannelRegistry.hpp"
+#include "irc/SlabPool.hpp"
+#include "irc/Server.hpp"
+
+// --- Stub: Channel::broadcast() links against Server, records recipients ---
+static std::vector<int> sentTo;
+void Server::sendToClient(int fd, const SharedMessage&, SendQueue::Priority) { sentTo.push_back(fd); }
+// ----------------------------------
+
+void printPass(const std::string& testName)
+{
+    std::cout << "[PASS] " << testName << std::endl;
+}
+
+void test_create_and_find()
+{
+    ChannelRegistry registry;
+
+    Channel* chan = registry.create("#Test");
+    assert(chan != NULL);
+    assert(chan->getNameDisplay() == "#Test");
+    assert(chan->getName() == "#test");
+
+    // Case-insensitive, existing channel returned
+    assert(registry.create("#TEST") == chan);
+    assert(registry.find("#tEsT") == chan);
+    assert(registry.find(chan->getId()) == chan);
+    assert(registry.find("#other") == NULL);
+    assert(registry.size() == 1);
+
+    registry.remove(chan);
+    assert(registry.find("#test") == NULL);
+    assert(registry.size() == 0);
+
+    printPass("Create, find and remove");
+}
+
+void test_pool_reuse()
+{
+    ChannelRegistry registry;
+    std::set<Channel*> seen;
+
+    // Join/part churn on short-lived channels: the pool stops growing
+    for (int round = 0; round < 100; ++round) {
+        char name[32];
+        std::sprintf(name, "#tmp%d", round);
+        Channel* chan = registry.create(name);
+        seen.insert(chan);
+        registry.remove(chan);
+    }
+    assert(seen.size() == 1);
+    assert(registry.getPool().live() == 0);
+    assert(registry.getPool().peak() == 1);
+    assert(registry.getPool().slabs() == 1);
+
+    printPass("Removed channels reuse their slot");
+}
+
+void test_many_channels()
+{
+    ChannelRegistry registry;
+    std::vector<Channel*> channels;
+    char name[32];
+
+    for (int i = 0; i < 1000; ++i) {
+        std::sprintf(name, "#chan%d", i);
+        channels.push_back(registry.create(name));
+    }
+    assert(registry.size() == 1000);
+    assert(registry.getPool().live() == 1000);
+
+    for (int i = 0; i < 1000; i += 2) {
+        registry.remove(channels[i]);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        std::sprintf(name, "#CHAN%d", i);
+        assert(registry.find(name) == ((i % 2) ? channels[i] : NULL));
+    }
+
+    // Refilled from the free slots: no new slab
+    size_t slabs = registry.getPool().slabs();
+    for (int i = 0; i < 1000; i += 2) {
+        std::sprintf(name, "#new%d", i);
+        registry.create(name);
+    }
+    assert(registry.getPool().slabs() == slabs);
+    assert(registry.size() == 1000);
+    assert(registry.getPool().peak() == 1000);
+
+    printPass("Many channels (rest destroyed with the registry)");
+}
+
+void test_membership()
+{
+    ChannelRegistry registry;
+    Channel* a = registry.create("#a");
+    Channel* b = registry.create("#b");
+    Client alice(10);
+    Client bob(11);
+
+    // One node per (client, channel), visible from both sides
+    Membership* m = a->addClient(&alice);
+    assert(m->client == &alice && m->channel == a);
+    assert(a->addClient(&alice) == m);
+    a->addClient(&bob);
+    b->addClient(&alice);
+    assert(a->getClientCount() == 2 && alice.getChannelCount() == 2);
+    assert(alice.getMemberships() == m);
+    assert(m->nextInClient->channel == b);
+    assert(a->getMembers() == m && m->nextInChannel->client == &bob);
+    assert(a->getMembership(&bob) != NULL && b->getMembership(&bob) == NULL);
+
+    // Operator status is per membership
+    a->addOperator(&alice);
+    assert(a->isOperator(&alice) && !b->isOperator(&alice));
+    a->addOperator(&bob);
+    a->removeOperator(&alice);
+    assert(!a->isOperator(&alice) && a->getOperators().size() == 1);
+
+    // Broadcast reaches everyone but the sender
+    Client carol(12);
+    a->addClient(&carol);
+    sentTo.clear();
+    a->broadcast(NULL, SharedMessage("x\r\n"), &bob);
+    std::sort(sentTo.begin(), sentTo.end());
+    assert(sentTo.size() == 2 && sentTo[0] == 10 && sentTo[1] == 12);
+    a->removeClient(&carol);
+
+    // Leaving unlinks both sides
+    a->removeClient(&alice);
+    assert(!a->hasClient(&alice) && a->getClientCount() == 1);
+    assert(alice.getChannelCount() == 1 && alice.getMemberships()->channel == b);
+    assert(a->getMembers()->client == &bob);
+
+    // Destroying a channel drops its remaining memberships
+    registry.remove(a);
+    assert(bob.getMemberships() == NULL && bob.getChannelCount() == 0);
+    b->removeClient(&alice);
+    assert(alice.getMemberships() == NULL && b->isEmpty());
+
+    // Many members: index lookups stay correct across growth and removal
+    std::vector<Client*> clients;
+    for (int i = 0; i < 500; ++i) {
+        clients.push_back(new Client(100 + i));
+        b->addClient(clients[i]);
+    }
+    for (int i = 0; i < 500; i += 2) {
+        b->removeClient(clients[i]);
+    }
+    sentTo.clear();
+    b->broadcast(NULL, SharedMessage("x\r\n"), clients[1]);
+    assert(sentTo.size() == 249);
+    std::sort(sentTo.begin(), sentTo.end());
+    for (size_t i = 0; i < sentTo.size(); ++i) {
+        assert(sentTo[i] == 100 + 3 + static_cast<int>(i) * 2);
+    }
+    for (int i = 0; i < 500; ++i) {
+        assert(b->hasClient(clients[i]) == (i % 2 == 1));
+        assert(clients[i]->getChannelCount() == static_cast<size_t>(i % 2));
+    }
+    for (int i = 0; i < 500; ++i) {
+        b->removeClient(clients[i]);
+        delete clients[i];
+    }
+    assert(b->isEmpty());
+
+    // clear() unlinks every member before the clients go away
+    registry.create("#c")->addClient(&alice);
+    b->addClient(&alice);
+    b->addClient(&bob);
+    registry.clear();
+    assert(registry.size() == 0 && registry.getPool().live() == 0);
+    assert(alice.getMemberships() == NULL && alice.getChannelCount() == 0);
+    assert(bob.getMemberships() == NULL && bob.getChannelCount() == 0);
+
+    printPass("Membership linked on both sides");
+}
+
+struct Counted {
+    static int alive;
+    int value;
+
+    Counted() : value(0) { ++alive; }
+    Counted(int v) : value(v) { ++alive; }
+    ~Counted() { --alive; }
+};
+
+int Counted::alive = 0;
+
+void test_slab_pool()
+{
+    SlabPool<Counted, 4> pool;
+
+    Counted* a = pool.create();
+    Counted* b = pool.create(7);
+    assert(a->value == 0 && b->value == 7);
+    assert(Counted::alive == 2);
+    assert(pool.live() == 2 && pool.capacity() == 4);
+
+    pool.destroy(a);
+    assert(Counted::alive == 1);
+    Counted* c = pool.create(9);
+    assert(c == a);     // last freed slot first
+
+    std::vector<Counted*> more;
+    for (int i = 0; i < 6; ++i) more.push_back(pool.create(i));
+    assert(pool.slabs() == 2 && pool.live() == 8);
+
+    for (size_t i = 0; i < more.size(); ++i) pool.destroy(more[i]);
+    pool.destroy(b);
+    pool.destroy(c);
+    pool.destroy(NULL);
+    assert(Counted::alive == 0 && pool.live() == 0);
+
+    printPass("SlabPool create/destroy");
+}
+
+int main()
+{
+    test_create_and_find();
+    test_pool_reuse();
+    test_many_channels();
+    test_membership();
+    test_slab_pool();
+
+    std::cout << "\nAll ChannelRegistry tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,134 @@
+// How to run test: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -I include src/ConnectionTable.cpp tests/test_ConnectionTable/test_ConnectionTable.cpp -o tests/test_ConnectionTable/run_test_ConnectionTable
+// ./tests/test_ConnectionTable/run_test_ConnectionTable
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "irc/ConnectionTable.hpp"
+
+void printPass(const std::string& testName)
+{
+    std::cout << "[PASS] " << testName << std::endl;
+}
+
+// The table only stores the pointers: any distinct address marks a slot open
+static Client* fakeClient(int n)
+{
+    return reinterpret_cast<Client*>(static_cast<size_t>(n) * 16 + 16);
+}
+
+void test_open_find_close()
+{
+    ConnectionTable table;
+
+    assert(table.find(4) == NULL);
+    assert(table.find(-1) == NULL);
+    assert(table.size() == 0);
+
+    ConnectionTable::Slot* slot = table.open(4);
+    assert(slot != NULL);
+    assert(slot->buffer == NULL && slot->sendQueue == NULL && slot->owner == NULL);
+    assert(slot->fanoutMark == 0 && slot->lastActivity == 0);
+    assert(table.find(4) == NULL);     // not open until a client is set
+    slot->client = fakeClient(4);
+
+    assert(table.find(4) == slot);
+    assert(table.find(4)->client == fakeClient(4));
+    assert(table.find(5) == NULL);
+    assert(table.size() == 1);
+
+    table.close(4);
+    assert(table.find(4) == NULL);
+    assert(table.size() == 0);
+    table.close(4);                     // already closed: no-op
+    assert(table.size() == 0);
+
+    printPass("open/find/close");
+}
+
+void test_stale_handle()
+{
+    ConnectionTable table;
+
+    table.open(7)->client = fakeClient(1);
+    ConnectionTable::Handle first = table.handle(7);
+    assert(first.fd == 7 && first.generation != 0);
+    assert(table.find(first) == table.find(7));
+
+    // Same fd, next connection: the old handle finds nothing
+    table.close(7);
+    assert(table.find(first) == NULL);
+    table.open(7)->client = fakeClient(2);
+    ConnectionTable::Handle second = table.handle(7);
+    assert(second.generation != first.generation);
+    assert(table.find(first) == NULL);
+    assert(table.find(second) != NULL);
+    assert(table.find(second)->client == fakeClient(2));
+
+    // No connection on the fd: generation 0, never found
+    ConnectionTable::Handle none = table.handle(9);
+    assert(none.generation == 0);
+    assert(table.find(none) == NULL);
+    assert(table.find(ConnectionTable::Handle()) == NULL);
+
+    printPass("Handles of closed connections go stale");
+}
+
+void test_growth()
+{
+    ConnectionTable table;
+
+    // Rising fds: the table grows, earlier slots keep their contents
+    for (int fd = 3; fd < 5000; ++fd) {
+        table.open(fd)->client = fakeClient(fd);
+    }
+    assert(table.size() == 4997);
+    assert(table.end() >= 5000);
+    for (int fd = 3; fd < 5000; ++fd) {
+        assert(table.find(fd) != NULL);
+        assert(table.find(fd)->client == fakeClient(fd));
+    }
+    assert(table.find(0) == NULL);
+    assert(table.find(table.end()) == NULL);
+
+    // Handles taken before growth still match
+    ConnectionTable::Handle h = table.handle(3);
+    table.open(20000)->client = fakeClient(20000);
+    assert(table.find(h) != NULL && table.find(h)->client == fakeClient(3));
+
+    printPass("Table grows with the highest fd");
+}
+
+void test_clear_marks()
+{
+    ConnectionTable table;
+
+    table.open(3)->client = fakeClient(3);
+    table.open(4)->client = fakeClient(4);
+    table.find(3)->fanoutMark = 41;
+    table.find(4)->fanoutMark = 42;
+
+    table.clearMarks();
+    assert(table.find(3)->fanoutMark == 0);
+    assert(table.find(4)->fanoutMark == 0);
+    assert(table.find(3)->client == fakeClient(3));
+
+    // A reopened slot starts unmarked too
+    table.find(4)->fanoutMark = 7;
+    table.close(4);
+    assert(table.open(4)->fanoutMark == 0);
+
+    printPass("clearMarks and reopen reset fan-out marks");
+}
+
+int main()
+{
+    test_open_find_close();
+    test_stale_handle();
+    test_growth();
+    test_clear_marks();
+
+    std::cout << "\nAll ConnectionTable tests passed!" << std::endl;
+    return 0;
+}
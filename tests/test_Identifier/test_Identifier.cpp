@@ -0,0 +1,163 @@
+// How to run test: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -I include src/Identifier.cpp tests/test_Identifier/test_Identifier.cpp -o tests/test_Identifier/run_test_Identifier
+// ./tests/test_Identifier/run_test_Identifier
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "irc/Identifier.hpp"
+
+void printPass(const std::string& testName)
+{
+    std::cout << "[PASS] " << testName << std::endl;
+}
+
+void test_fold()
+{
+    // RFC 1459: [ \ ] ^ are the uppercase forms of { | } ~
+    assert(Identifier::fold("NiCk[]\\^") == "nick{}|~");
+    assert(Identifier::fold("#Chan-_09{}|~") == "#chan-_09{}|~");
+
+    // Longer than one SIMD block, bytes >= 0x80 untouched
+    std::string name = "#ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^\xC3\x89t\xE9";
+    assert(Identifier::fold(name) == "#abcdefghijklmnopqrstuvwxyz{|}~\xC3\x89t\xE9");
+
+    // Every byte, SIMD path against the table
+    char in[256];
+    char out[256];
+    for (int c = 0; c < 256; ++c) in[c] = static_cast<char>(c);
+    Identifier::fold(in, sizeof(in), out);
+    for (int c = 0; c < 256; ++c) {
+        assert(out[c] == Identifier::foldChar(in[c]));
+    }
+
+    printPass("RFC 1459 casefold");
+}
+
+void test_interning()
+{
+    size_t before = Identifier::internedCount();
+    {
+        Identifier a("#Test");
+        Identifier b("#TEST");
+        Identifier c("#other");
+
+        assert(a == b);
+        assert(a != c);
+        assert(a.str() == "#test");
+        assert(a.hash() == Identifier::hashFolded("#tEsT", 5));
+        assert(Identifier::internedCount() == before + 2);
+    }
+    // Last handle gone: names removed
+    assert(Identifier::internedCount() == before);
+
+    printPass("One entry per folded name");
+}
+
+void test_find()
+{
+    Identifier nick("Bob[1]");
+
+    assert(Identifier::find("BOB{1}") == nick);
+    assert(Identifier::find("bob[1]") == nick);
+    assert(Identifier::find("alice").empty());
+    assert(Identifier::find("alice") != nick);
+
+    // find() never inserts
+    size_t count = Identifier::internedCount();
+    Identifier::find("somebody else");
+    assert(Identifier::internedCount() == count);
+
+    // Names around the 16-byte blocks: case differences in a full block
+    // and in the tail are found, other names are not
+    for (size_t length = 1; length <= 40; ++length) {
+        std::string lower(length, 'a');
+        for (size_t i = 0; i < length; ++i) lower[i] = static_cast<char>('a' + i % 26);
+        std::string upper = lower;
+        upper[length - 1] = static_cast<char>(upper[length - 1] - 0x20);
+        if (length > 1) upper[0] = static_cast<char>(upper[0] - 0x20);
+        Identifier id(lower);
+        assert(Identifier::hashFolded(upper.data(), length) == id.hash());
+        assert(Identifier::find(upper) == id);
+        std::string other = lower;
+        other[length / 2] = '_';
+        assert(Identifier::find(other).empty());
+        assert(Identifier::find(lower.substr(0, length - 1)) != id);
+    }
+
+    printPass("Lookup without interning");
+}
+
+void test_copy_and_assign()
+{
+    size_t before = Identifier::internedCount();
+    Identifier empty;
+    assert(empty.empty());
+    assert(empty.str() == "");
+
+    Identifier a("#a");
+    {
+        Identifier copy(a);
+        Identifier assigned;
+        Identifier& alias = assigned;
+        assigned = copy;
+        assigned = alias;   // self-assignment
+        assert(assigned == a);
+    }
+    assert(Identifier::find("#A") == a);
+
+    a = empty;
+    assert(Identifier::find("#a").empty());
+    assert(Identifier::internedCount() == before);
+
+    printPass("Copy, assign and release");
+}
+
+void test_many_names()
+{
+    size_t before = Identifier::internedCount();
+    std::vector<Identifier> names;
+    char buffer[32];
+
+    // Enough to grow the table several times, then release every other
+    for (int i = 0; i < 5000; ++i) {
+        std::sprintf(buffer, "User%d", i);
+        names.push_back(Identifier(buffer));
+    }
+    assert(Identifier::internedCount() == before + 5000);
+
+    for (int i = 0; i < 5000; i += 2) {
+        names[i] = Identifier();
+    }
+    assert(Identifier::internedCount() == before + 2500);
+
+    // Survivors still found after backward-shift deletions
+    for (int i = 0; i < 5000; ++i) {
+        std::sprintf(buffer, "USER%d", i);
+        Identifier found = Identifier::find(buffer);
+        if (i % 2) {
+            assert(found == names[i]);
+        } else {
+            assert(found.empty());
+        }
+    }
+
+    names.clear();
+    assert(Identifier::internedCount() == before);
+
+    printPass("Table growth and deletion");
+}
+
+int main()
+{
+    test_fold();
+    test_interning();
+    test_find();
+    test_copy_and_assign();
+    test_many_names();
+
+    std::cout << "\nAll Identifier tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,263 @@
+// How to run test: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -pthread -I include src/Logger.cpp tests/test_Logger/test_Logger.cpp -o tests/test_Logger/run_test_Logger
+// ./tests/test_Logger/run_test_Logger
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include "irc/Logger.hpp"
+
+void printPass(const std::string& testName)
+{
+    std::cout << "[PASS] " << testName << std::endl;
+}
+
+// Logger output goes into a pipe the test reads back (non-blocking read
+// end: everything written is there once stop() returned)
+struct Capture {
+    int fds[2];
+
+    Capture() {
+        assert(pipe(fds) == 0);
+        fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL, 0) | O_NONBLOCK);
+#ifdef F_SETPIPE_SZ
+        fcntl(fds[1], F_SETPIPE_SZ, 1024 * 1024);
+#endif
+    }
+    ~Capture() {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    std::vector<std::string> lines() {
+        std::string all;
+        char buf[4096];
+        ssize_t n;
+        while ((n = read(fds[0], buf, sizeof(buf))) > 0) {
+            all.append(buf, n);
+        }
+        std::vector<std::string> out;
+        size_t start = 0;
+        size_t end;
+        while ((end = all.find('\n', start)) != std::string::npos) {
+            out.push_back(all.substr(start, end - start));
+            start = end + 1;
+        }
+        return out;
+    }
+};
+
+static bool endsWith(const std::string& s, const std::string& tail)
+{
+    return s.size() >= tail.size() && s.compare(s.size() - tail.size(), tail.size(), tail) == 0;
+}
+
+void test_format_and_fields()
+{
+    Capture out;
+    Logger::setLevel(Logger::LEVEL_INFO);
+    Logger::instance().start(out.fds[1]);
+
+    std::string nick = "Alice";
+    std::string command = "JOIN";
+    IRC_LOG_INFO("Server", LogFields(), "Listening on port " << 6667);
+    IRC_LOG_WARN("Server", LogFields(7).withNick(nick).withCommand(command), "SendQ exceeded");
+    IRC_LOG_ERROR("Poller", LogFields(3), "epoll_wait() error: " << "EBADF");
+    Logger::instance().stop();
+
+    std::vector<std::string> lines = out.lines();
+    assert(lines.size() == 3);
+    // "YYYY-MM-DD HH:MM:SS.mmm LEVEL [Component] text fields"
+    assert(lines[0].size() > 24 && lines[0][4] == '-' && lines[0][19] == '.');
+    assert(endsWith(lines[0], "INFO  [Server] Listening on port 6667"));
+    assert(endsWith(lines[1], "WARN  [Server] SendQ exceeded fd=7 nick=Alice cmd=JOIN"));
+    assert(endsWith(lines[2], "ERROR [Poller] epoll_wait() error: EBADF fd=3"));
+
+    printPass("Line format and structured fields");
+}
+
+void test_levels()
+{
+    Capture out;
+    int evaluated = 0;
+    Logger::instance().start(out.fds[1]);
+
+    // Below the runtime level: message not even formatted
+    Logger::setLevel(Logger::LEVEL_WARN);
+    IRC_LOG_INFO("Server", LogFields(), "hidden " << ++evaluated);
+    IRC_LOG_WARN("Server", LogFields(), "shown " << ++evaluated);
+
+    // Below the compile-time level (default info): compiled out
+    Logger::setLevel(Logger::LEVEL_DEBUG);
+    IRC_LOG_DEBUG("Server", LogFields(), "debug " << ++evaluated);
+    Logger::instance().stop();
+    Logger::setLevel(Logger::LEVEL_INFO);
+
+    std::vector<std::string> lines = out.lines();
+    assert(lines.size() == (IRC_LOG_LEVEL == 0 ? 2u : 1u));
+    assert(endsWith(lines[0], "[Server] shown 1"));
+    assert(evaluated == (IRC_LOG_LEVEL == 0 ? 2 : 1));
+    assert(Logger::levelFromName("debug") == Logger::LEVEL_DEBUG);
+    assert(Logger::levelFromName("error") == Logger::LEVEL_ERROR);
+    assert(Logger::levelFromName("bogus") == Logger::LEVEL_INFO);
+
+    printPass("Runtime and compile-time levels");
+}
+
+void test_repeats()
+{
+    Capture out;
+    Logger::instance().start(out.fds[1]);
+
+    for (int i = 0; i < 50; ++i) {
+        IRC_LOG_WARN("Poller", LogFields(9), "POLLERR");
+    }
+    IRC_LOG_WARN("Poller", LogFields(10), "POLLERR");     // other fd: new line
+    Logger::instance().stop();
+
+    std::vector<std::string> lines = out.lines();
+    assert(lines.size() == 3);
+    assert(endsWith(lines[0], "[Poller] POLLERR fd=9"));
+    assert(endsWith(lines[1], "[Poller] last message repeated 49 times"));
+    assert(endsWith(lines[2], "[Poller] POLLERR fd=10"));
+
+    printPass("Repeated lines are summarised");
+}
+
+void test_truncation()
+{
+    Capture out;
+    Logger::instance().start(out.fds[1]);
+
+    std::string longText(2000, 'x');
+    IRC_LOG_INFO("Server", LogFields(), longText << "tail");
+    IRC_LOG_INFO("Server", LogFields(), "after");
+    Logger::instance().stop();
+
+    std::vector<std::string> lines = out.lines();
+    assert(lines.size() == 2);
+    assert(endsWith(lines[0], std::string(Logger::TEXT_SIZE, 'x')));
+    assert(endsWith(lines[1], "[Server] after"));
+
+    printPass("Long lines are cut at TEXT_SIZE");
+}
+
+static int evaluated = 0;
+
+static void floodLine()
+{
+    IRC_LOG_INFO("Flood", LogFields(), "noisy " << ++evaluated);
+}
+
+void test_rate_limit()
+{
+    Capture out;
+    Logger::instance().start(out.fds[1]);
+    unsigned long limitedBefore = Logger::rateLimited();
+
+    // 10/s: a burst of 10 per statement, the rest not even formatted
+    Logger::setRateLimit(10);
+    for (int i = 0; i < 100; ++i) {
+        floodLine();
+    }
+    IRC_LOG_INFO("Quiet", LogFields(), "other statement");     // own bucket
+    usleep(250 * 1000);     // two tokens back
+    floodLine();
+    floodLine();
+    Logger::setRateLimit(0);
+    Logger::instance().stop();
+
+    assert(evaluated == 12);
+    assert(Logger::rateLimited() - limitedBefore == 90);
+    std::vector<std::string> lines = out.lines();
+    std::vector<std::string> logged;
+    unsigned long reported = 0;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        unsigned long n = 0;
+        size_t at = lines[i].find("[Logger] ");
+        if (at != std::string::npos) {
+            assert(std::sscanf(lines[i].c_str() + at, "[Logger] %lu lines suppressed", &n) == 1);
+            reported += n;
+        } else {
+            logged.push_back(lines[i]);
+        }
+    }
+    assert(reported == 90);
+    assert(logged.size() == 13);
+    assert(endsWith(logged[0], "[Flood] noisy 1"));
+    assert(endsWith(logged[9], "[Flood] noisy 10"));
+    assert(endsWith(logged[10], "[Quiet] other statement"));
+    assert(endsWith(logged[11], "[Flood] noisy 11 (90 suppressed)"));
+    assert(endsWith(logged[12], "[Flood] noisy 12"));
+
+    printPass("Rate limit per log statement");
+}
+
+// Producers on several threads: every line arrives once, none torn
+static const int PRODUCERS = 4;
+static const int LINES_EACH = 2000;
+
+static void* produce(void* arg)
+{
+    long id = reinterpret_cast<long>(arg);
+    for (int i = 0; i < LINES_EACH; ++i) {
+        IRC_LOG_INFO("Test", LogFields(static_cast<int>(id)), "line " << i);
+        if (i % 256 == 0) usleep(1000);     // let the writer keep up
+    }
+    return NULL;
+}
+
+void test_concurrent_producers()
+{
+    Capture out;
+    Logger::instance().start(out.fds[1]);
+    unsigned long droppedBefore = Logger::instance().dropped();
+
+    pthread_t threads[PRODUCERS];
+    for (long t = 0; t < PRODUCERS; ++t) {
+        pthread_create(&threads[t], NULL, produce, reinterpret_cast<void*>(t));
+    }
+    for (int t = 0; t < PRODUCERS; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+    Logger::instance().stop();
+
+    std::vector<std::string> lines = out.lines();
+    unsigned long dropped = Logger::instance().dropped() - droppedBefore;
+    std::vector<int> next(PRODUCERS, 0);
+    size_t received = 0;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        size_t at = lines[i].find("[Test] line ");
+        if (at == std::string::npos) continue;      // drop report
+        int n = 0;
+        int fd = -1;
+        int fields = std::sscanf(lines[i].c_str() + at, "[Test] line %d fd=%d", &n, &fd);
+        assert(fields == 2);
+        assert(fd >= 0 && fd < PRODUCERS);
+        assert(n >= next[fd]);          // per producer in order
+        next[fd] = n + 1;
+        ++received;
+    }
+    assert(received + dropped == static_cast<size_t>(PRODUCERS * LINES_EACH));
+
+    printPass("Concurrent producers (" + std::string(dropped ? "some" : "none") + " dropped)");
+}
+
+int main()
+{
+    test_format_and_fields();
+    test_levels();
+    test_repeats();
+    test_truncation();
+    test_rate_limit();
+    test_concurrent_producers();
+
+    std::cout << "\nAll Logger tests passed!" << std::endl;
+    return 0;
+}
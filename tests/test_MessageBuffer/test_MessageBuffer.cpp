@@ -1,10 +1,11 @@
 // How to run test: from main directory run following 2 lines of code:
-// c++ -Wall -Wextra -Werror -std=c++98 -I include src/MessageBuffer.cpp tests/test_MessageBuffer/test_MessageBuffer.cpp -o tests/test_MessageBuffer/run_test_MessageBuffer
+// c++ -Wall -Wextra -Werror -std=c++98 -I include src/MessageBuffer.cpp src/Scanner.cpp src/Logger.cpp tests/test_MessageBuffer/test_MessageBuffer.cpp -o tests/test_MessageBuffer/run_test_MessageBuffer
 // ./tests/test_MessageBuffer/run_test_MessageBuffer
 
 #include <iostream>
 #include <cassert>
 #include <vector>
+#include <cstring>
 #include "irc/MessageBuffer.hpp"
 
 // Helper to print success
@@ -23,7 +24,7 @@ void test_simple_message()
     
     // Assert
     assert(msgs.size() == 1);
-    assert(msgs[0] == "NICK user\r\n");
+    assert(msgs[0] == "NICK user");
     assert(buf.isEmpty());
     
     printPass("Simple complete message");
@@ -47,7 +48,7 @@ void test_partial_message()
     
     // Assert 2: Should have full message now
     assert(msgs.size() == 1);
-    assert(msgs[0] == "NICK user\r\n");
+    assert(msgs[0] == "NICK user");
     assert(buf.isEmpty());
     
     printPass("Partial message assembly");
@@ -63,8 +64,8 @@ void test_multiple_messages()
     
     // Assert
     assert(msgs.size() == 2);
-    assert(msgs[0] == "NICK user\r\n");
-    assert(msgs[1] == "USER name * * :Real Name\r\n");
+    assert(msgs[0] == "NICK user");
+    assert(msgs[1] == "USER name * * :Real Name");
     
     printPass("Multiple messages in one chunk");
 }
@@ -81,17 +82,101 @@ void test_split_delimiter()
     std::vector<std::string> msgs = buf.extractMessages();
     
     assert(msgs.size() == 1);
-    assert(msgs[0] == "COMMAND\r\n");
+    assert(msgs[0] == "COMMAND");
     
     printPass("Split CRLF delimiter");
 }
 
+void test_direct_write_tail()
+{
+    MessageBuffer buf(64);
+    const char data[] = "PING :a\r\nPING :b\r\nPIN";
+
+    // Act: recv()-style write into the tail
+    assert(buf.writableSize() == 64);
+    std::memcpy(buf.writableData(), data, sizeof(data) - 1);
+    buf.commitWrite(sizeof(data) - 1);
+
+    // Assert: lines consumed in place, partial kept
+    const char* line;
+    size_t length;
+    assert(buf.nextLine(line, length));
+    assert(std::string(line, length) == "PING :a");
+    assert(buf.nextLine(line, length));
+    assert(std::string(line, length) == "PING :b");
+    assert(!buf.nextLine(line, length));
+    assert(buf.getBuffer() == "PIN");
+
+    printPass("Direct write into tail, zero-copy lines");
+}
+
+void test_compaction()
+{
+    MessageBuffer buf(16);
+
+    // Act: consume a line, then need the space it occupied
+    buf.append("ABCDEFGHIJ\r\nxy");
+    std::vector<std::string> msgs = buf.extractMessages();
+    assert(msgs.size() == 1);
+    assert(buf.size() == 2);
+    buf.writableData();
+
+    // Assert: unread bytes moved to the front, capacity unchanged
+    assert(buf.writableSize() == 14);
+    assert(buf.capacity() == 16);
+    assert(buf.getBuffer() == "xy");
+
+    printPass("Compaction reuses consumed space");
+}
+
+void test_full_unterminated_line()
+{
+    MessageBuffer buf(8);
+
+    std::memset(buf.writableData(), 'x', 8);
+    buf.commitWrite(8);
+
+    // Assert: no room left and no line, caller has to drop it
+    assert(buf.writableSize() == 0);
+    assert(buf.extractMessages().empty());
+    buf.clear();
+    assert(buf.writableSize() == 8);
+
+    printPass("Full buffer without CRLF is detectable");
+}
+
+void test_many_pipelined_lines()
+{
+    MessageBuffer buf;
+    std::string burst;
+    for (int i = 0; i < 10000; ++i)
+        burst += "PRIVMSG #c :x\r\n";
+
+    // Act: one append, 10000 lines (used to be one erase() per line)
+    buf.append(burst);
+    const char* line;
+    size_t length;
+    int count = 0;
+    while (buf.nextLine(line, length))
+        ++count;
+
+    // Assert
+    assert(count == 10000);
+    assert(buf.isEmpty());
+
+    printPass("Pipelined lines consumed by offset");
+}
+
 int main()
 {
     test_simple_message();
     test_partial_message();
     test_multiple_messages();
     test_split_delimiter();
+    test_direct_write_tail();
+    test_compaction();
+    test_full_unterminated_line();
+    test_many_pipelined_lines();
     std::cout << "\nAll MessageBuffer tests passed!" << std::endl;
     return 0;
 }
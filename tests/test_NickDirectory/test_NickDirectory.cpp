@@ -0,0 +1,141 @@
+// How to run test: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -I include src/Client.cpp src/Identifier.cpp src/NickDirectory.cpp tests/test_NickDirectory/test_NickDirectory.cpp -o tests/test_NickDirectory/run_test_NickDirectory
+// ./tests/test_NickDirectory/run_test_NickDirectory
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "irc/Client.hpp"
+#include "irc/Identifier.hpp"
+#include "irc/NickDirectory.hpp"
+
+void printPass(const std::string& testName)
+{
+    std::cout << "[PASS] " << testName << std::endl;
+}
+
+void test_insert_and_find()
+{
+    NickDirectory directory;
+    Client alice(4);
+    Client bob(5);
+    alice.setNickname("Alice");
+    bob.setNickname("Bob[away]");
+
+    assert(directory.insert(alice.getNickId(), &alice));
+    assert(directory.insert(bob.getNickId(), &bob));
+    assert(directory.size() == 2);
+
+    // Case-insensitive, RFC 1459 ({ } are lowercase [ ])
+    assert(directory.find("alice") == &alice);
+    assert(directory.find("ALICE") == &alice);
+    assert(directory.find("bob{AWAY}") == &bob);
+    assert(directory.find(bob.getNickId()) == &bob);
+    assert(directory.find("carol") == NULL);
+    assert(directory.find(Identifier()) == NULL);
+
+    printPass("Insert and case-insensitive find");
+}
+
+void test_uniqueness()
+{
+    NickDirectory directory;
+    Client first(4);
+    Client second(5);
+    first.setNickname("nick");
+
+    assert(directory.insert(first.getNickId(), &first));
+    // Same nick, other case, other client: refused
+    assert(!directory.insert(Identifier("NICK"), &second));
+    // Same client again: already there
+    assert(directory.insert(Identifier("Nick"), &first));
+    assert(directory.size() == 1);
+    assert(directory.find("nick") == &first);
+
+    printPass("Nicks are unique");
+}
+
+void test_rename()
+{
+    NickDirectory directory;
+    Client a(4);
+    Client b(5);
+    a.setNickname("anna");
+    b.setNickname("bert");
+    directory.insert(a.getNickId(), &a);
+    directory.insert(b.getNickId(), &b);
+
+    // First nick (nothing to release)
+    Client c(6);
+    assert(directory.rename(&c, c.getNickId(), Identifier("carl")));
+    assert(directory.find("carl") == &c);
+
+    // Taken by another client: nothing changes
+    assert(!directory.rename(&a, a.getNickId(), Identifier("BERT")));
+    assert(directory.find("anna") == &a);
+    assert(directory.find("bert") == &b);
+
+    // Case change of the own nick
+    assert(directory.rename(&a, a.getNickId(), Identifier("ANNA")));
+    assert(directory.find("anna") == &a);
+
+    // New nick: old one released
+    assert(directory.rename(&a, a.getNickId(), Identifier("anne")));
+    assert(directory.find("anna") == NULL);
+    assert(directory.find("anne") == &a);
+    assert(directory.size() == 3);
+
+    printPass("Rename in one step");
+}
+
+void test_remove_and_growth()
+{
+    NickDirectory directory;
+    std::vector<Client*> clients;
+    char buffer[32];
+
+    for (int i = 0; i < 3000; ++i) {
+        std::sprintf(buffer, "user%d", i);
+        Client* client = new Client(i + 4);
+        client->setNickname(buffer);
+        clients.push_back(client);
+        assert(directory.insert(client->getNickId(), client));
+    }
+    assert(directory.size() == 3000);
+    assert(directory.capacity() >= 6000);
+
+    // Remove needs the right client
+    directory.remove(clients[0]->getNickId(), clients[1]);
+    assert(directory.find("user0") == clients[0]);
+
+    for (int i = 0; i < 3000; i += 3) {
+        directory.remove(clients[i]->getNickId(), clients[i]);
+    }
+    assert(directory.size() == 2000);
+
+    for (int i = 0; i < 3000; ++i) {
+        std::sprintf(buffer, "USER%d", i);
+        assert(directory.find(buffer) == ((i % 3) ? clients[i] : NULL));
+    }
+
+    for (size_t i = 0; i < clients.size(); ++i) {
+        directory.remove(clients[i]->getNickId(), clients[i]);
+        delete clients[i];
+    }
+    assert(directory.size() == 0);
+
+    printPass("Remove and table growth");
+}
+
+int main()
+{
+    test_insert_and_find();
+    test_uniqueness();
+    test_rename();
+    test_remove_and_growth();
+
+    std::cout << "\nAll NickDirectory tests passed!" << std::endl;
+    return 0;
+}
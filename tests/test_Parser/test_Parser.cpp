@@ -1,10 +1,11 @@
 // How to run test: from main directory run following 2 lines of code:
-// c++ -Wall -Wextra -Werror -std=c++98 -I include src/Parser.cpp tests/test_Parser/test_Parser.cpp -o tests/test_Parser/run_test_Parser
+// c++ -Wall -Wextra -Werror -std=c++98 -I include src/Parser.cpp src/Scanner.cpp src/Command.cpp tests/test_Parser/test_Parser.cpp -o tests/test_Parser/run_test_Parser
 // ./tests/test_Parser/run_test_Parser
 
 #include <iostream>
 #include <cassert>
 #include <vector>
+#include <cstring>
 #include "irc/Parser.hpp"
 #include "irc/Command.hpp"
 
@@ -141,6 +142,124 @@ void test_empty_params_halloy()
     printPass("Empty parameters (Halloy compatibility)");
 }
 
+void test_view_points_into_line()
+{
+    Parser parser;
+    CommandView view;
+    char line[] = ":nick!u@h privmsg #chan :Hello World!";
+    size_t length = sizeof(line) - 1;
+
+    // Act
+    bool result = parser.parse(line, length, view);
+
+    // Assert: every field is a slice of line, command uppercased in place
+    assert(result == true);
+    assert(view.prefix == "nick!u@h");
+    assert(view.command == "PRIVMSG");
+    assert(view.paramCount == 1);
+    assert(view.params[0] == "#chan");
+    assert(view.trailing == "Hello World!");
+    assert(view.params[0].data == line + 18);
+    assert(view.trailing.data == line + 25);
+    assert(std::string(line, 17) == ":nick!u@h PRIVMSG");
+
+    printPass("CommandView slices the line (zero-copy)");
+}
+
+void test_view_matches_owning_parse()
+{
+    Parser parser;
+    CommandView view;
+    Command owned;
+    Command copied;
+    char line[] = "USER   0  * :Real Name\r\n";
+
+    // Act
+    assert(parser.parse("USER   0  * :Real Name\r\n", owned));
+    assert(parser.parse(line, sizeof(line) - 1, view));
+    Parser::toCommand(view, copied);
+
+    // Assert: same fields as the owning parser (raw without CRLF)
+    assert(copied.command == owned.command);
+    assert(copied.params == owned.params);
+    assert(copied.trailing == owned.trailing);
+    assert(copied.raw == "USER   0  * :Real Name");
+
+    printPass("toCommand() matches owning parse");
+}
+
+void test_reused_command_keeps_params()
+{
+    Parser parser;
+    CommandView view;
+    Command cmd;
+    char three[] = "MODE #a-long-channel-name +ov first-long-nickname second-long-nickname";
+    char one[] = "NICK x";
+
+    // Act 1: three params, then one (the other two are parked)
+    assert(parser.parse(three, sizeof(three) - 1, view));
+    Parser::toCommand(view, cmd);
+    const char* second = cmd.params[2].data();
+    const char* third = cmd.params[3].data();
+
+    assert(parser.parse(one, sizeof(one) - 1, view));
+    Parser::toCommand(view, cmd);
+    assert(cmd.params.size() == 1 && cmd.params[0] == "x");
+    assert(cmd.spareParams.size() == 3);
+
+    // Act 2: back to three, same string buffers come back
+    assert(parser.parse(three, sizeof(three) - 1, view));
+    Parser::toCommand(view, cmd);
+    assert(cmd.params.size() == 4);
+    assert(cmd.params[0] == "#a-long-channel-name" && cmd.params[1] == "+ov");
+    assert(cmd.params[2] == "first-long-nickname" && cmd.params[3] == "second-long-nickname");
+    assert(cmd.spareParams.empty());
+    assert(cmd.params[2].data() == second && cmd.params[3].data() == third);
+
+    printPass("Reused Command keeps its param strings");
+}
+
+void test_view_rejects_empty()
+{
+    Parser parser;
+    CommandView view;
+    char spaces[] = "   ";
+    char prefixOnly[] = ":origin";
+
+    assert(parser.parse(spaces, 3, view) == false);
+    assert(parser.parse(prefixOnly, 7, view) == false);
+    assert(parser.parse(spaces, 0, view) == false);
+
+    printPass("CommandView rejects empty/prefix-only lines");
+}
+
+void test_command_ids()
+{
+    Parser parser;
+    Command cmd;
+    const char* verbs[] = { "PASS", "NICK", "USER", "JOIN", "PART", "PRIVMSG", "INVITE",
+                            "KICK", "TOPIC", "MODE", "QUIT", "PING", "PONG" };
+    const char* unknown[] = { "PAS", "PASSX", "PIGN", "PORT", "TOPICS", "PRIVMSX", "CAP", "WHO" };
+
+    // Every handled verb maps to its own id, and back
+    for (size_t i = 0; i < sizeof(verbs) / sizeof(verbs[0]); ++i)
+    {
+        CommandId id = commandIdFromName(verbs[i], std::strlen(verbs[i]));
+        assert(id == static_cast<CommandId>(CMD_PASS + i));
+        assert(std::string(commandName(id)) == verbs[i]);
+    }
+    for (size_t i = 0; i < sizeof(unknown) / sizeof(unknown[0]); ++i)
+        assert(commandIdFromName(unknown[i], std::strlen(unknown[i])) == CMD_UNKNOWN);
+
+    // Parser resolves the id after uppercasing
+    assert(parser.parse("privmsg #chan :hi\r\n", cmd));
+    assert(cmd.id == CMD_PRIVMSG);
+    assert(parser.parse("cap LS\r\n", cmd));
+    assert(cmd.id == CMD_UNKNOWN);
+
+    printPass("Command ids (13 verbs, near misses, lowercase)");
+}
+
 int main()
 {
     test_simple_command();
@@ -151,6 +270,11 @@ int main()
     test_whitespace_only();
     test_newline_only();
     test_empty_params_halloy();
+    test_view_points_into_line();
+    test_view_matches_owning_parse();
+    test_reused_command_keeps_params();
+    test_view_rejects_empty();
+    test_command_ids();
     std::cout << "\nAll Parser tests passed!" << std::endl;
     return 0;
 }
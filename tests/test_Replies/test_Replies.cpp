@@ -1,5 +1,5 @@
 // How to run test: from main directory run following 2 lines of code:
-// c++ -Wall -Wextra -Werror -std=c++98 -Itests/test_Replies/include -Iinclude src/Replies.cpp tests/test_Replies/test_Replies.cpp -o tests/test_Replies/run_test_Replies
+// c++ -Wall -Wextra -Werror -std=c++98 -Itests/test_Replies/include -Iinclude src/Replies.cpp src/ReplyBuilder.cpp tests/test_Replies/test_Replies.cpp -o tests/test_Replies/run_test_Replies
 // ./tests/test_Replies/run_test_Replies
 
 
@@ -33,6 +33,11 @@ const std::string& Client::getHostname() const {
     static std::string val = "TestHost";
     return val;
 }
+
+const std::string& Client::getPrefix() const {
+    static std::string val = "TestNick!TestUser@TestHost";
+    return val;
+}
 // ----------------------------------
 
 void test_numeric_reply() {
@@ -0,0 +1,83 @@
+// How to run test: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -I include src/ReplyBuilder.cpp tests/test_ReplyBuilder/test_ReplyBuilder.cpp -o tests/test_ReplyBuilder/run_test_ReplyBuilder
+// ./tests/test_ReplyBuilder/run_test_ReplyBuilder
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "irc/ReplyBuilder.hpp"
+
+void printPass(const std::string& testName)
+{
+    std::cout << "[PASS] " << testName << std::endl;
+}
+
+void test_numeric()
+{
+    ReplyBuilder reply;
+
+    reply.numeric("332", "nick").param("#chan").trailing("the topic").end();
+    assert(reply.str() == ":ft_irc 332 nick #chan :the topic\r\n");
+    assert(!reply.truncated());
+
+    printPass("Numeric reply");
+}
+
+void test_command()
+{
+    ReplyBuilder reply;
+
+    reply.command("nick!user@host", "JOIN").trailing("#chan").end();
+    assert(reply.str() == ":nick!user@host JOIN :#chan\r\n");
+
+    reply.clear();
+    reply.command("", "PING").trailing("ft_irc").end();
+    assert(reply.str() == "PING :ft_irc\r\n");
+
+    printPass("Command with and without prefix");
+}
+
+void test_server_name()
+{
+    ReplyBuilder reply;
+
+    ReplyBuilder::setServerName("irc.example.net");
+    reply.numeric("001", "nick").trailing("Welcome").end();
+    assert(reply.str() == ":irc.example.net 001 nick :Welcome\r\n");
+    assert(ReplyBuilder::getServerName() == "irc.example.net");
+    ReplyBuilder::setServerName("ft_irc");
+
+    printPass("Server name prefix");
+}
+
+void test_truncated_at_line_limit()
+{
+    ReplyBuilder reply;
+    std::string text(1000, 'x');
+
+    reply.numeric("372", "nick").trailing(text).end();
+    assert(reply.truncated());
+    assert(reply.size() == ReplyBuilder::MAX_LINE);
+    assert(reply.data()[reply.size() - 2] == '\r');
+    assert(reply.data()[reply.size() - 1] == '\n');
+
+    // end() twice does not write past the buffer
+    reply.end();
+    assert(reply.size() == ReplyBuilder::MAX_LINE);
+
+    reply.clear();
+    assert(reply.size() == 0 && !reply.truncated());
+    assert(reply.remaining() == ReplyBuilder::MAX_LINE - 2);
+
+    printPass("Line capped at 512 bytes, CRLF kept");
+}
+
+int main()
+{
+    test_numeric();
+    test_command();
+    test_server_name();
+    test_truncated_at_line_limit();
+    std::cout << "\nAll ReplyBuilder tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,200 @@
+// How to run test: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -I include src/Scanner.cpp tests/test_Scanner/test_Scanner.cpp -o tests/test_Scanner/run_test_Scanner
+// ./tests/test_Scanner/run_test_Scanner
+
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include "irc/Scanner.hpp"
+
+static const size_t NPOS = static_cast<size_t>(-1);
+
+// Helper to print success
+void printPass(const std::string& testName)
+{
+    std::cout << "[PASS] " << testName << std::endl;
+}
+
+// Byte-at-a-time references the vectorized versions must agree with
+static size_t refLineEnd(const std::string& s)
+{
+    size_t pos = s.find("\r\n");
+    return pos == std::string::npos ? NPOS : pos;
+}
+
+static void refIndex(const std::string& s, LineIndex& index)
+{
+    size_t first = s.find_first_not_of(' ');
+    index.spaceCount = 0;
+    index.trailing = NPOS;
+    index.indexedEnd = s.length();
+    for (size_t i = 0; i < s.length(); ++i)
+    {
+        if (s[i] == ':' && i > 0 && s[i - 1] == ' ' && first != std::string::npos && i > first)
+        {
+            index.trailing = i;
+            index.indexedEnd = i;
+            return;
+        }
+        if (s[i] == ' ')
+        {
+            if (index.spaceCount == LineIndex::MAX_SPACES)
+            {
+                index.indexedEnd = i;
+                return;
+            }
+            index.spaces[index.spaceCount++] = i;
+        }
+    }
+}
+
+static void assertSameIndex(const std::string& s)
+{
+    LineIndex expected;
+    LineIndex actual;
+    refIndex(s, expected);
+    Scanner::indexLine(s.data(), s.length(), actual);
+    assert(actual.trailing == expected.trailing);
+    assert(actual.indexedEnd == expected.indexedEnd);
+    assert(actual.spaceCount == expected.spaceCount);
+    for (size_t i = 0; i < expected.spaceCount; ++i)
+        assert(actual.spaces[i] == expected.spaces[i]);
+}
+
+static std::string randomLine(size_t length)
+{
+    static const char alphabet[] = "  ::\r\nab";
+    std::string s(length, 'x');
+    for (size_t i = 0; i < length; ++i)
+        s[i] = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+    return s;
+}
+
+void test_line_end(Scanner::Impl impl)
+{
+    assert(Scanner::findLineEnd("", 0) == NPOS);
+    assert(Scanner::findLineEnd("\r", 1) == NPOS);
+    assert(Scanner::findLineEnd("\r\n", 2) == 0);
+    assert(Scanner::findLineEnd("\n\r", 2) == NPOS);
+    assert(Scanner::findLineEnd("a\r\rb\r\n", 6) == 4);
+
+    // CR/LF pair across every block boundary (16 / 32 bytes)
+    for (size_t len = 2; len < 100; ++len)
+    {
+        for (size_t at = 0; at + 1 < len; ++at)
+        {
+            std::string s(len, 'a');
+            s[at] = '\r';
+            s[at + 1] = '\n';
+            assert(Scanner::findLineEnd(s.data(), s.length()) == at);
+        }
+        // Lone CR as the last byte of the data is not a line end
+        std::string s(len, 'a');
+        s[len - 1] = '\r';
+        assert(Scanner::findLineEnd(s.data(), s.length()) == NPOS);
+    }
+    printPass(std::string("findLineEnd edges (") + Scanner::implName(impl) + ")");
+}
+
+void test_index_lines(Scanner::Impl impl)
+{
+    LineIndex index;
+    const char line[] = "PRIVMSG #chan :hello there world";
+    Scanner::indexLine(line, sizeof(line) - 1, index);
+    assert(index.spaceCount == 2);
+    assert(index.spaces[0] == 7 && index.spaces[1] == 13);
+    assert(index.trailing == 14);
+
+    // Prefix ':' and a leading-space prefix are not the trailing marker
+    assertSameIndex(":nick!u@h PRIVMSG #c :hi");
+    assertSameIndex("   :nick CMD a b");
+    assertSameIndex("CMD :");
+    assertSameIndex("CMD a  b   c");
+    assertSameIndex(std::string(200, ' ') + "X :y");
+
+    // More spaces than the index holds
+    std::string many = "MODE";
+    for (int i = 0; i < 100; ++i)
+        many += " x";
+    assertSameIndex(many);
+    assertSameIndex(many + " :tail");
+
+    printPass(std::string("indexLine fixed lines (") + Scanner::implName(impl) + ")");
+}
+
+// scanLine() = findLineEnd() + indexLine() of the bytes before the line end
+static void assertSameScan(const std::string& s)
+{
+    LineIndex expected;
+    LineIndex actual;
+    size_t end = refLineEnd(s);
+    assert(Scanner::scanLine(s.data(), s.length(), actual) == end);
+    if (end == NPOS)
+        return;
+    refIndex(s.substr(0, end), expected);
+    assert(actual.trailing == expected.trailing);
+    assert(actual.indexedEnd == expected.indexedEnd);
+    assert(actual.spaceCount == expected.spaceCount);
+    for (size_t i = 0; i < expected.spaceCount; ++i)
+        assert(actual.spaces[i] == expected.spaces[i]);
+}
+
+void test_scan_pipelined(Scanner::Impl impl)
+{
+    std::string input = "NICK a\r\nUSER a 0 * :Real Name\r\nPRIVMSG #c :x y z\r\nJOIN #c";
+    const char* data = input.data();
+    size_t length = input.length();
+    LineIndex index;
+
+    size_t end = Scanner::scanLine(data, length, index);
+    assert(end == 6 && index.spaceCount == 1 && index.trailing == NPOS && index.indexedEnd == 6);
+    data += end + 2;
+    length -= end + 2;
+    end = Scanner::scanLine(data, length, index);
+    assert(end == 21 && index.spaceCount == 4 && index.trailing == 11);
+    data += end + 2;
+    length -= end + 2;
+    end = Scanner::scanLine(data, length, index);
+    assert(end == 17 && index.spaceCount == 2 && index.trailing == 11);
+    data += end + 2;
+    length -= end + 2;
+    assert(Scanner::scanLine(data, length, index) == NPOS);
+
+    printPass(std::string("scanLine pipelined lines (") + Scanner::implName(impl) + ")");
+}
+
+void test_random(Scanner::Impl impl)
+{
+    std::srand(42);
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string s = randomLine(std::rand() % 300);
+        assert(Scanner::findLineEnd(s.data(), s.length()) == refLineEnd(s));
+        assertSameIndex(s.substr(0, s.find("\r\n")));
+        assertSameScan(s);
+    }
+    printPass(std::string("Random lines match reference (") + Scanner::implName(impl) + ")");
+}
+
+int main()
+{
+    Scanner::Impl impls[] = { Scanner::IMPL_SCALAR, Scanner::IMPL_SSE2, Scanner::IMPL_AVX2 };
+
+    std::cout << "=== STARTING SCANNER TESTS ===" << std::endl;
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); ++i)
+    {
+        if (!Scanner::setImpl(impls[i]))
+        {
+            std::cout << "[SKIP] " << Scanner::implName(impls[i]) << " not supported" << std::endl;
+            continue;
+        }
+        assert(Scanner::getImpl() == impls[i]);
+        test_line_end(impls[i]);
+        test_index_lines(impls[i]);
+        test_scan_pipelined(impls[i]);
+        test_random(impls[i]);
+    }
+    std::cout << "=== ALL TESTS PASSED ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,452 @@
+// How to run test: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -I include src/SendQueue.cpp src/SharedMessage.cpp tests/test_SendQueue/test_SendQueue.cpp -o tests/test_SendQueue/run_test_SendQueue
+// ./tests/test_SendQueue/run_test_SendQueue
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <csignal>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "irc/SendQueue.hpp"
+
+// Helper to print success
+void printPass(const std::string& testName)
+{
+    std::cout << "[PASS] " << testName << std::endl;
+}
+
+// Non-blocking socketpair with small buffers so the writer fills up fast
+static void makePair(int sv[2])
+{
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    int size = 4096;
+    setsockopt(sv[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+    setsockopt(sv[1], SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    fcntl(sv[0], F_SETFL, O_NONBLOCK);
+    fcntl(sv[1], F_SETFL, O_NONBLOCK);
+}
+
+// Message holding its own copy of data
+static SharedMessage copyOf(const std::string& data)
+{
+    return SharedMessage(data);
+}
+
+static std::string readAll(int fd)
+{
+    std::string out;
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0)
+        out.append(buf, n);
+    return out;
+}
+
+void test_empty_queue()
+{
+    SendQueue q;
+
+    assert(q.isEmpty());
+    assert(q.bytes() == 0);
+    assert(q.messages() == 0);
+    q.push(copyOf(""));
+    assert(q.isEmpty());
+
+    printPass("Empty queue / empty push ignored");
+}
+
+void test_flush_everything()
+{
+    int sv[2];
+    makePair(sv);
+    SendQueue q;
+
+    q.push(copyOf(":srv 001 nick :Welcome\r\n"));
+    q.push(copyOf(":srv 002 nick :Your host\r\n"));
+    assert(q.messages() == 2);
+    assert(q.bytes() == 50);
+
+    // Act: one writev() takes both chunks
+    ssize_t n = q.flush(sv[0]);
+
+    // Assert
+    assert(n == 50);
+    assert(q.isEmpty());
+    assert(q.bytes() == 0);
+    assert(readAll(sv[1]) == ":srv 001 nick :Welcome\r\n:srv 002 nick :Your host\r\n");
+
+    close(sv[0]);
+    close(sv[1]);
+    printPass("Flush of several chunks in one call");
+}
+
+void test_partial_flush_keeps_order()
+{
+    int sv[2];
+    makePair(sv);
+    SendQueue q;
+
+    // Act 1: queue far more than the socket buffers hold
+    std::string expected;
+    for (int i = 0; i < 2000; ++i) {
+        std::string line = ":nick!user@host PRIVMSG #chan :line " + std::string(1, 'a' + i % 26) + "\r\n";
+        q.push(copyOf(line));
+        expected += line;
+    }
+    ssize_t n = q.flush(sv[0]);
+
+    // Assert 1: socket full, rest still queued, head partially written
+    assert(n > 0);
+    assert(!q.isEmpty());
+    assert(q.bytes() == expected.size() - static_cast<size_t>(n));
+
+    // Act 2: reader drains, writer flushes again until done
+    std::string received;
+    while (!q.isEmpty()) {
+        received += readAll(sv[1]);
+        assert(q.flush(sv[0]) >= 0);
+    }
+    received += readAll(sv[1]);
+
+    // Assert 2: byte stream identical, nothing lost or reordered
+    assert(received == expected);
+    assert(q.bytes() == 0);
+
+    close(sv[0]);
+    close(sv[1]);
+    printPass("Partial flushes keep byte order");
+}
+
+void test_flush_full_socket_returns_zero()
+{
+    int sv[2];
+    makePair(sv);
+    SendQueue q;
+
+    // Fill the socket completely
+    std::string big(1 << 20, 'x');
+    q.push(copyOf(big));
+    q.flush(sv[0]);
+    assert(!q.isEmpty());
+    size_t left = q.bytes();
+
+    // Act: nothing fits, no error
+    ssize_t n = q.flush(sv[0]);
+
+    // Assert
+    assert(n == 0);
+    assert(q.bytes() == left);
+
+    close(sv[0]);
+    close(sv[1]);
+    printPass("Flush on a full socket is not an error");
+}
+
+void test_flush_error_and_clear()
+{
+    int sv[2];
+    makePair(sv);
+    SendQueue q;
+
+    // Act: peer is gone
+    close(sv[1]);
+    q.push(copyOf("PING :srv\r\n"));
+    ssize_t n = q.flush(sv[0]);
+
+    // Assert: error reported, data kept until clear()
+    assert(n == -1);
+    assert(q.messages() == 1);
+    q.clear();
+    assert(q.isEmpty());
+    assert(q.bytes() == 0);
+
+    close(sv[0]);
+    printPass("Socket error reported, clear() drops data");
+}
+
+void test_soft_limit()
+{
+    SendQueue q;
+    SendQueue::Limits limits;
+    limits.softBytes = 100;
+    limits.softMessages = 0;
+
+    // Act 1: under the limit
+    q.push(copyOf(std::string(99, 'x')));
+    assert(!q.overSoftLimit(limits));
+
+    // Act 2: reaching it counts
+    q.push(copyOf("y"));
+    assert(q.overSoftLimit(limits));
+
+    // Message count limit alone
+    SendQueue m;
+    limits.softBytes = 0;
+    limits.softMessages = 3;
+    m.push(copyOf("a"));
+    m.push(copyOf("b"));
+    assert(!m.overSoftLimit(limits));
+    m.push(copyOf("c"));
+    assert(m.overSoftLimit(limits));
+
+    printPass("Soft limit in bytes and messages");
+}
+
+void test_hard_limit()
+{
+    SendQueue q;
+    SendQueue::Limits limits;
+    limits.hardBytes = 100;
+    limits.hardMessages = 0;
+
+    q.push(copyOf(std::string(60, 'x')));
+    assert(!q.wouldExceedHardLimit(40, limits));  // exactly at the limit is fine
+    assert(q.wouldExceedHardLimit(41, limits));
+
+    limits.hardBytes = 0;
+    limits.hardMessages = 2;
+    assert(!q.wouldExceedHardLimit(1000, limits));
+    q.push(copyOf("y"));
+    assert(q.wouldExceedHardLimit(1, limits));
+
+    // 0 = unlimited
+    limits.hardMessages = 0;
+    assert(!q.wouldExceedHardLimit(1 << 30, limits));
+
+    printPass("Hard limit in bytes and messages");
+}
+
+void test_backpressure_state()
+{
+    SendQueue q;
+
+    assert(!q.isReadingPaused());
+    assert(!q.isClosing());
+    q.setReadingPaused(true);
+    q.setClosing(true);
+    assert(q.isReadingPaused());
+    assert(q.isClosing());
+
+    printPass("Backpressure state flags");
+}
+
+void test_shared_message_refcount()
+{
+    SharedMessage empty;
+    assert(empty.empty());
+    assert(empty.size() == 0);
+    assert(empty.useCount() == 0);
+
+    SharedMessage a(std::string(":nick!u@h PRIVMSG #c :hi\r\n"));
+    assert(a.useCount() == 1);
+    {
+        SharedMessage b(a);
+        SharedMessage c;
+        c = b;
+        assert(a.useCount() == 3);
+        assert(b.data() == a.data());   // same bytes, not a copy
+    }
+    assert(a.useCount() == 1);
+    assert(std::string(a.data(), a.size()) == ":nick!u@h PRIVMSG #c :hi\r\n");
+
+    printPass("SharedMessage reference counting");
+}
+
+void test_broadcast_shares_block()
+{
+    int sv[3][2];
+    SendQueue queues[3];
+    SharedMessage msg(std::string(":nick!u@h PRIVMSG #chan :hello\r\n"));
+
+    // Act 1: same block queued for 3 recipients
+    for (int i = 0; i < 3; ++i) {
+        makePair(sv[i]);
+        queues[i].push(msg);
+    }
+
+    // Assert 1: one block, 4 references, bytes accounted per queue
+    assert(msg.useCount() == 4);
+    assert(queues[1].bytes() == msg.size());
+
+    // Act 2: each flush releases one reference
+    assert(queues[0].flush(sv[0][0]) == static_cast<ssize_t>(msg.size()));
+    assert(msg.useCount() == 3);
+    queues[1].flush(sv[1][0]);
+    queues[2].clear();
+    assert(msg.useCount() == 1);
+    assert(readAll(sv[1][1]) == ":nick!u@h PRIVMSG #chan :hello\r\n");
+
+    for (int i = 0; i < 3; ++i) {
+        close(sv[i][0]);
+        close(sv[i][1]);
+    }
+    printPass("Broadcast block shared until flushed");
+}
+
+void test_append_coalesces()
+{
+    int sv[2];
+    makePair(sv);
+    SendQueue q;
+    SharedMessage shared(std::string("S\r\n"));
+
+    // Act: replies of one iteration, a broadcast in between
+    q.append("A\r\n", 3);
+    q.append("B\r\n", 3);
+    q.push(shared);
+    q.append("C\r\n", 3);
+
+    // Assert: appends next to each other are one chunk
+    assert(q.messages() == 3);
+    assert(q.bytes() == 12);
+    assert(q.flush(sv[0]) == 12);
+    assert(q.isEmpty() && !q.isBlocked());
+    assert(readAll(sv[1]) == "A\r\nB\r\nS\r\nC\r\n");
+
+    close(sv[0]);
+    close(sv[1]);
+    printPass("Appended bytes coalesce, order kept");
+}
+
+void test_append_left_after_partial_flush()
+{
+    int sv[2];
+    makePair(sv);
+    SendQueue q;
+
+    // Arrange: more than the socket takes
+    std::string expected;
+    for (int i = 0; i < 2000; ++i) {
+        std::string line = ":srv NOTICE nick :staged line number " + std::string(1, 'a' + i % 26) + "\r\n";
+        q.append(line.data(), line.size());
+        expected += line;
+    }
+
+    // Act 1: partial flush, the rest moves out of the staging buffer
+    ssize_t n = q.flush(sv[0]);
+    assert(n > 0);
+    assert(q.isBlocked());
+    assert(q.bytes() == expected.size() - static_cast<size_t>(n));
+
+    // Act 2: appends after the flush go behind the leftover
+    q.append("END\r\n", 5);
+    expected += "END\r\n";
+    std::string received = readAll(sv[1]);
+    while (!q.isEmpty()) {
+        assert(q.flush(sv[0]) >= 0);
+        received += readAll(sv[1]);
+    }
+
+    // Assert
+    assert(!q.isBlocked());
+    assert(received == expected);
+
+    close(sv[0]);
+    close(sv[1]);
+    printPass("Staged bytes survive a partial flush");
+}
+
+void test_flush_scheduled_flag()
+{
+    SendQueue q;
+    assert(!q.isFlushScheduled());
+    q.setFlushScheduled(true);
+    assert(q.isFlushScheduled());
+    q.setFlushScheduled(false);
+    assert(!q.isFlushScheduled());
+    printPass("Flush scheduled flag");
+}
+
+// What the ring does with a beginSend(): one sendmsg, result or -errno
+static ssize_t sendIov(int fd, struct iovec* iov, int count)
+{
+    struct msghdr msg = msghdr();
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+    ssize_t n = sendmsg(fd, &msg, MSG_DONTWAIT);
+    return n < 0 ? -errno : n;
+}
+
+void test_async_send()
+{
+    int sv[2];
+    makePair(sv);
+    SendQueue q;
+
+    // Arrange: shared and staged chunks, more than the socket takes
+    std::string expected;
+    for (int i = 0; i < 500; ++i) {
+        std::string line = ":srv NOTICE nick :async line " + std::string(1, 'a' + i % 26) + "\r\n";
+        if (i % 2) q.push(copyOf(line));
+        else q.append(line.data(), line.size());
+        expected += line;
+    }
+
+    // Act 1: in flight, nothing consumed, flush() stays out of the way
+    struct iovec iov[4];
+    int count = q.beginSend(iov, 4);
+    assert(count == 4 && q.isSending());
+    assert(q.beginSend(iov, 4) == 0);
+    size_t before = q.bytes();
+    assert(q.flush(sv[0]) == 0 && q.bytes() == before);
+    ssize_t n = sendIov(sv[0], iov, count);
+    q.append("END\r\n", 5);              // queued while in flight: behind it
+    expected += "END\r\n";
+    assert(q.completeSend(n));
+    assert(!q.isSending() && !q.isBlocked());
+    assert(q.bytes() == before + 5 - static_cast<size_t>(n));
+
+    // Act 2: until the socket is full (short send or -EAGAIN), then drain
+    std::string received = readAll(sv[1]);
+    while (!q.isEmpty()) {
+        count = q.beginSend(iov, 4);
+        assert(q.completeSend(sendIov(sv[0], iov, count)));
+        if (q.isBlocked()) received += readAll(sv[1]);
+    }
+    received += readAll(sv[1]);
+    assert(received == expected);
+
+    // Act 3: dropped while in flight, the late result is ignored
+    q.append("x\r\n", 3);
+    assert(q.beginSend(iov, 4) == 1);
+    q.clear();
+    assert(!q.isSending() && !q.completeSend(3) && q.bytes() == 0);
+
+    // Act 4: not submitted after all
+    q.append("y\r\n", 3);
+    assert(q.beginSend(iov, 4) == 1);
+    q.cancelSend();
+    assert(!q.isSending() && q.bytes() == 3);
+    assert(q.flush(sv[0]) == 3 && readAll(sv[1]) == "y\r\n");
+
+    close(sv[0]);
+    close(sv[1]);
+    printPass("Asynchronous send: begin/complete keeps order");
+}
+
+int main()
+{
+    // Peer closed: EPIPE instead of SIGPIPE
+    signal(SIGPIPE, SIG_IGN);
+
+    test_empty_queue();
+    test_flush_everything();
+    test_partial_flush_keeps_order();
+    test_flush_full_socket_returns_zero();
+    test_flush_error_and_clear();
+    test_soft_limit();
+    test_hard_limit();
+    test_backpressure_state();
+    test_shared_message_refcount();
+    test_broadcast_shares_block();
+    test_append_coalesces();
+    test_append_left_after_partial_flush();
+    test_flush_scheduled_flag();
+    test_async_send();
+    std::cout << "\nAll SendQueue tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,189 @@
+// How to run test: from main directory run following 2 lines of code:
+// c++ -Wall -Wextra -Werror -std=c++98 -I include src/TimerWheel.cpp tests/test_TimerWheel/test_TimerWheel.cpp -o tests/test_TimerWheel/run_test_TimerWheel
+// ./tests/test_TimerWheel/run_test_TimerWheel
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include "irc/TimerWheel.hpp"
+
+void printPass(const std::string& testName)
+{
+    std::cout << "[PASS] " << testName << std::endl;
+}
+
+// The wheel starts at the current time: tests run on a clock of their own
+// that starts there too
+static unsigned long long start()
+{
+    return TimerWheel::now();
+}
+
+void test_expire_at_deadline()
+{
+    TimerWheel wheel;
+    unsigned long long t0 = start();
+    TimerWheel::Timer a;
+    TimerWheel::Timer b;
+    std::vector<TimerWheel::Timer*> fired;
+
+    wheel.schedule(&a, t0 + 1000);
+    wheel.schedule(&b, t0 + 5000);
+    assert(wheel.size() == 2);
+
+    // Act 1: before the deadline nothing fires
+    wheel.expire(t0 + 999, fired);
+    assert(fired.empty());
+
+    // Act 2: at the deadline only a
+    wheel.expire(t0 + 1000 + TimerWheel::TICK_MS, fired);
+    assert(fired.size() == 1 && fired[0] == &a);
+    assert(!a.scheduled && b.scheduled);
+    assert(wheel.size() == 1);
+
+    // Act 3: a long jump fires the rest
+    fired.clear();
+    wheel.expire(t0 + 60000, fired);
+    assert(fired.size() == 1 && fired[0] == &b);
+    assert(wheel.size() == 0);
+
+    printPass("Timers fire at their deadline, not before");
+}
+
+void test_reschedule_and_cancel()
+{
+    TimerWheel wheel;
+    unsigned long long t0 = start();
+    TimerWheel::Timer a;
+    TimerWheel::Timer b;
+    std::vector<TimerWheel::Timer*> fired;
+
+    // Rearming moves the timer, it is never in two slots
+    wheel.schedule(&a, t0 + 1000);
+    wheel.schedule(&a, t0 + 3000);
+    wheel.schedule(&b, t0 + 1000);
+    wheel.cancel(&b);
+    wheel.cancel(&b);   // not armed: no-op
+    assert(wheel.size() == 1);
+
+    wheel.expire(t0 + 2000, fired);
+    assert(fired.empty());
+    wheel.expire(t0 + 3000 + TimerWheel::TICK_MS, fired);
+    assert(fired.size() == 1 && fired[0] == &a);
+
+    printPass("Rearm moves, cancel unlinks");
+}
+
+void test_later_rounds()
+{
+    TimerWheel wheel;
+    unsigned long long t0 = start();
+    unsigned long long revolution =
+        static_cast<unsigned long long>(TimerWheel::SLOTS) * TimerWheel::TICK_MS;
+    TimerWheel::Timer near;
+    TimerWheel::Timer far;
+    std::vector<TimerWheel::Timer*> fired;
+
+    // Same slot, one revolution apart
+    wheel.schedule(&near, t0 + 1000);
+    wheel.schedule(&far, t0 + 1000 + revolution);
+
+    wheel.expire(t0 + 1000 + TimerWheel::TICK_MS, fired);
+    assert(fired.size() == 1 && fired[0] == &near);
+
+    fired.clear();
+    wheel.expire(t0 + revolution, fired);
+    assert(fired.empty());
+    wheel.expire(t0 + 1000 + revolution + TimerWheel::TICK_MS, fired);
+    assert(fired.size() == 1 && fired[0] == &far);
+
+    printPass("Timers of later rounds wait for their round");
+}
+
+void test_overdue_fires_next()
+{
+    TimerWheel wheel;
+    unsigned long long t0 = start();
+    TimerWheel::Timer a;
+    std::vector<TimerWheel::Timer*> fired;
+
+    wheel.expire(t0 + 10000, fired);
+    wheel.schedule(&a, t0);     // already in the past
+    assert(wheel.timeoutMs(t0 + 10000, 1000) <= TimerWheel::TICK_MS);
+    wheel.expire(t0 + 10000 + TimerWheel::TICK_MS, fired);
+    assert(fired.size() == 1 && fired[0] == &a);
+
+    printPass("Overdue timer fires on the next tick");
+}
+
+void test_poll_timeout()
+{
+    TimerWheel wheel;
+    unsigned long long t0 = start();
+    TimerWheel::Timer a;
+    std::vector<TimerWheel::Timer*> fired;
+
+    assert(wheel.timeoutMs(t0, 1000) == 1000);     // nothing armed
+
+    wheel.schedule(&a, t0 + 600);
+    int timeout = wheel.timeoutMs(t0, 1000);
+    assert(timeout >= 600 && timeout < 600 + TimerWheel::TICK_MS);
+    assert(wheel.timeoutMs(t0 + 5000, 1000) == 0);  // due
+
+    // Far away: capped
+    wheel.schedule(&a, t0 + 100000);
+    assert(wheel.timeoutMs(t0 + 1000, 1000) <= 1000);
+
+    // After expiring past the cached tick it finds the next slot again
+    wheel.expire(t0 + 2000, fired);
+    assert(fired.empty());
+    timeout = wheel.timeoutMs(t0 + 99000, 5000);
+    assert(timeout >= 1000 && timeout < 1000 + TimerWheel::TICK_MS);
+
+    printPass("Poll timeout follows the next deadline");
+}
+
+void test_many_timers()
+{
+    TimerWheel wheel;
+    unsigned long long t0 = start();
+    std::vector<TimerWheel::Timer> timers(10000);
+    std::vector<TimerWheel::Timer*> fired;
+
+    // Spread over 10 minutes (several revolutions), rearmed a few times
+    for (size_t i = 0; i < timers.size(); ++i) {
+        wheel.schedule(&timers[i], t0 + (i * 7919) % 600000);
+        wheel.schedule(&timers[i], t0 + (i * 104729) % 600000);
+    }
+    assert(wheel.size() == timers.size());
+
+    // Walk the clock in uneven steps: everything fires once, on time
+    unsigned long long now = t0;
+    while (now < t0 + 601000) {
+        now += 137;
+        size_t before = fired.size();
+        wheel.expire(now, fired);
+        for (size_t i = before; i < fired.size(); ++i) {
+            assert(fired[i]->deadline <= now);
+            assert(fired[i]->deadline + 137 + TimerWheel::TICK_MS > now);
+        }
+    }
+    assert(fired.size() == timers.size());
+    assert(wheel.size() == 0);
+
+    printPass("10000 timers over several revolutions");
+}
+
+int main()
+{
+    test_expire_at_deadline();
+    test_reschedule_and_cancel();
+    test_later_rounds();
+    test_overdue_fires_next();
+    test_poll_timeout();
+    test_many_timers();
+
+    std::cout << "\nAll TimerWheel tests passed!" << std::endl;
+    return 0;
+}